@@ -27,6 +27,13 @@ bool TWAnyAddressEqual(struct TWAnyAddress* _Nonnull lhs, struct TWAnyAddress* _
 TW_EXPORT_STATIC_METHOD
 bool TWAnyAddressIsValid(TWString* _Nonnull string, enum TWCoinType coin);
 
+/// Validates a batch of addresses.
+///
+/// \param input serialized `TW.Common.Proto.AddressValidationInput` with (coin, address) items.
+/// \returns a bitmap with one bit per item, in input order (bit `i % 8` of byte `i / 8`), set if the address is valid.
+TW_EXPORT_STATIC_METHOD
+TWData* _Nonnull TWAnyAddressValidateBatch(TWData* _Nonnull input);
+
 /// Creates an address from a string representaion.
 TW_EXPORT_STATIC_METHOD
 struct TWAnyAddress* _Nullable TWAnyAddressCreateWithString(TWString* _Nonnull string, enum TWCoinType coin);
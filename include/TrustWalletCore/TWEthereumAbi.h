@@ -31,4 +31,17 @@ bool TWEthereumAbiDecodeOutput(struct TWEthereumAbiFunction* _Nonnull fn, TWData
 TW_EXPORT_STATIC_METHOD
 TWString* _Nullable TWEthereumAbiDecodeCall(TWData* _Nonnull data, TWString* _Nonnull abi);
 
+/// Compute the hash to sign of EIP712 typed structured data, keccak256(0x19 0x01 || domainSeparator || hashStruct(message))
+/// \param messageJson typed data JSON with `types`, `primaryType`, `domain` and `message`
+/// \returns the 32-byte hash, or empty data if the input is invalid
+TW_EXPORT_STATIC_METHOD
+TWData* _Nonnull TWEthereumAbiEncodeTyped(TWString* _Nonnull messageJson);
+
+/// Compute the EIP712 hashes to sign of many messages sharing one schema and domain; the schema is parsed once
+/// \param schemaJson JSON with `types`, `primaryType` and `domain`
+/// \param messagesJson JSON array of messages of the primary type
+/// \returns the 32-byte hashes concatenated in input order, or empty data if the schema or any message is invalid
+TW_EXPORT_STATIC_METHOD
+TWData* _Nonnull TWEthereumAbiEncodeTypedMany(TWString* _Nonnull schemaJson, TWString* _Nonnull messagesJson);
+
 TW_EXTERN_C_END
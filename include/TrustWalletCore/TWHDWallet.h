@@ -61,6 +61,13 @@ struct TWPrivateKey *_Nonnull TWHDWalletGetKeyForCoin(struct TWHDWallet *_Nonnul
 TW_EXPORT_METHOD
 TWString *_Nonnull TWHDWalletGetAddressForCoin(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin);
 
+/// Generates the default addresses of many coins in one pass, sharing master keys and common derivation path levels.
+///
+/// \param input serialized `TW.Common.Proto.AddressDerivationInput` with the coins.
+/// \returns serialized `TW.Common.Proto.AddressDerivationOutput`, with the addresses in input order.
+TW_EXPORT_METHOD
+TWData *_Nonnull TWHDWalletGetAddressesForCoins(struct TWHDWallet *_Nonnull wallet, TWData *_Nonnull input);
+
 /// Generates the private key for the specified derivation path.  Returned object needs to be deleted.
 TW_EXPORT_METHOD
 struct TWPrivateKey *_Nonnull TWHDWalletGetKey(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin, TWString *_Nonnull derivationPath);
@@ -55,4 +55,11 @@ TWString *_Nonnull TWPublicKeyDescription(struct TWPublicKey *_Nonnull publicKey
 TW_EXPORT_STATIC_METHOD
 struct TWPublicKey *_Nullable TWPublicKeyRecover(TWData *_Nonnull signature, TWData *_Nonnull message);
 
+/// Recovers the Ethereum addresses of the signers of many secp256k1 signatures, sharing work across the batch.
+///
+/// \param input serialized `TW.Common.Proto.RecoveryInput` with the signatures and digests.
+/// \returns serialized `TW.Common.Proto.RecoveryOutput`, with one address per item in input order.
+TW_EXPORT_STATIC_METHOD
+TWData *_Nonnull TWPublicKeyRecoverAddresses(TWData *_Nonnull input);
+
 TW_EXTERN_C_END
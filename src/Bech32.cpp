@@ -8,6 +8,7 @@
 #include "Bech32.h"
 #include "Data.h"
 
+#include <algorithm>
 #include <array>
 
 using namespace TW;
@@ -26,82 +27,120 @@ constexpr std::array<int8_t, 128> charset_rev = {
     6,  4,  2,  -1, -1, -1, -1, -1, -1, 29, -1, 24, 13, 25, 9,  8,  23, -1, 18, 22, 31, 27,
     19, -1, 1,  0,  3,  16, 11, 28, 12, 14, 6,  4,  2,  -1, -1, -1, -1, -1};
 
-/** Concatenate two byte arrays. */
-Data cat(Data x, const Data& y) {
-    x.insert(x.end(), y.begin(), y.end());
-    return x;
-}
-
-/** Find the polynomial with value coefficients mod the generator as 30-bit. */
-uint32_t polymod(const Data& values) {
-    uint32_t chk = 1;
-    for (const auto& value : values) {
-        uint8_t top = chk >> 25;
-        chk = (chk & 0x1ffffff) << 5 ^ value ^ (-((top >> 0) & 1) & 0x3b6a57b2UL) ^
-              (-((top >> 1) & 1) & 0x26508e6dUL) ^ (-((top >> 2) & 1) & 0x1ea119faUL) ^
-              (-((top >> 3) & 1) & 0x3d4233ddUL) ^ (-((top >> 4) & 1) & 0x2a1462b3UL);
+/** Generator combinations for each value of the top 5 bits of the checksum. */
+constexpr std::array<uint32_t, 32> polymod_table = [] {
+    constexpr uint32_t generator[5] = {0x3b6a57b2UL, 0x26508e6dUL, 0x1ea119faUL, 0x3d4233ddUL, 0x2a1462b3UL};
+    std::array<uint32_t, 32> table{};
+    for (uint32_t top = 0; top < 32; ++top) {
+        for (int i = 0; i < 5; ++i) {
+            if ((top >> i) & 1) {
+                table[top] ^= generator[i];
+            }
+        }
     }
-    return chk;
+    return table;
+}();
+
+/** Advance the checksum by one 5-bit value. */
+inline uint32_t polymod_step(uint32_t chk, uint8_t value) {
+    return ((chk & 0x1ffffff) << 5) ^ value ^ polymod_table[chk >> 25];
 }
 
 /** Convert to lower case. */
-unsigned char lc(unsigned char c) {
+inline unsigned char lc(unsigned char c) {
     return (c >= 'A' && c <= 'Z') ? (c - 'A') + 'a' : c;
 }
 
-/** Expand a HRP for use in checksum computation. */
-Data expand_hrp(const std::string& hrp) {
-    Data ret;
-    ret.resize(hrp.size() * 2 + 1);
-    for (size_t i = 0; i < hrp.size(); ++i) {
-        unsigned char c = hrp[i];
-        ret[i] = c >> 5;
-        ret[i + hrp.size() + 1] = c & 0x1f;
+/** Checksum of an expanded HRP, as the first step of the polymod. */
+uint32_t polymod_hrp(const char* hrp, size_t hrpLength) {
+    uint32_t chk = 1;
+    for (size_t i = 0; i < hrpLength; ++i) {
+        chk = polymod_step(chk, lc(hrp[i]) >> 5);
     }
-    ret[hrp.size()] = 0;
-    return ret;
+    chk = polymod_step(chk, 0);
+    for (size_t i = 0; i < hrpLength; ++i) {
+        chk = polymod_step(chk, lc(hrp[i]) & 0x1f);
+    }
+    return chk;
 }
 
-/** Verify a checksum. */
-bool verify_checksum(const std::string& hrp, const Data& values) {
-    return polymod(cat(expand_hrp(hrp), values)) == 1;
+} // namespace
+
+bool Bech32::View::hrpHasPrefix(const std::string& prefix) const {
+    if (prefix.size() > hrpLength) {
+        return false;
+    }
+    for (size_t i = 0; i < prefix.size(); ++i) {
+        if (lc(hrp[i]) != static_cast<unsigned char>(prefix[i])) {
+            return false;
+        }
+    }
+    return true;
 }
 
-/** Create a checksum. */
-Data create_checksum(const std::string& hrp, const Data& values) {
-    Data enc = cat(expand_hrp(hrp), values);
-    enc.resize(enc.size() + 6);
-    uint32_t mod = polymod(enc) ^ 1;
-    Data ret;
-    ret.resize(6);
-    for (size_t i = 0; i < 6; ++i) {
-        ret[i] = (mod >> (5 * (5 - i))) & 31;
+std::string Bech32::View::hrpString() const {
+    std::string ret(hrpLength, '\0');
+    for (size_t i = 0; i < hrpLength; ++i) {
+        ret[i] = lc(hrp[i]);
     }
     return ret;
 }
 
-} // namespace
+void Bech32::View::copyValues(uint8_t* out) const {
+    for (size_t i = 0; i < valuesLength; ++i) {
+        out[i] = charset_rev[static_cast<unsigned char>(values[i])];
+    }
+}
 
 /** Encode a Bech32 string. */
 std::string Bech32::encode(const std::string& hrp, const Data& values) {
-    Data checksum = create_checksum(hrp, values);
-    Data combined = cat(values, checksum);
-    std::string ret = hrp + '1';
-    ret.reserve(ret.size() + combined.size());
-    for (const auto& value : combined) {
-        ret += charset[value];
-    }
+    std::string ret(encodedLength(hrp.size(), values.size()), '\0');
+    encode(&ret[0], hrp.data(), hrp.size(), values.data(), values.size(), ChecksumVariant::Bech32);
     return ret;
 }
 
+/** Encode a Bech32 or Bech32m string into a fixed buffer. */
+size_t Bech32::encode(char* out, const char* hrp, size_t hrpLength, const uint8_t* values,
+                      size_t valuesLength, ChecksumVariant variant) {
+    uint32_t chk = polymod_hrp(hrp, hrpLength);
+    char* p = std::copy(hrp, hrp + hrpLength, out);
+    *p++ = '1';
+    for (size_t i = 0; i < valuesLength; ++i) {
+        chk = polymod_step(chk, values[i]);
+        *p++ = charset[values[i]];
+    }
+    for (size_t i = 0; i < checksumLength; ++i) {
+        chk = polymod_step(chk, 0);
+    }
+    chk ^= static_cast<uint32_t>(variant);
+    for (size_t i = 0; i < checksumLength; ++i) {
+        *p++ = charset[(chk >> (5 * (5 - i))) & 31];
+    }
+    return p - out;
+}
+
 /** Decode a Bech32 string. */
 std::pair<std::string, Data> Bech32::decode(const std::string& str) {
+    View view;
+    if (!decode(str.data(), str.size(), view) || view.variant != ChecksumVariant::Bech32) {
+        return std::make_pair(std::string(), Data());
+    }
+    Data values(view.valuesLength);
+    view.copyValues(values.data());
+    return std::make_pair(view.hrpString(), values);
+}
+
+/** Decode and verify a Bech32 or Bech32m string in place. */
+bool Bech32::decode(const char* str, size_t length, View& view) {
+    if (length > maxLength) {
+        return false;
+    }
     bool lower = false, upper = false;
-    bool ok = true;
-    for (size_t i = 0; ok && i < str.size(); ++i) {
+    size_t pos = length;
+    for (size_t i = 0; i < length; ++i) {
         unsigned char c = str[i];
         if (c < 33 || c > 126) {
-            ok = false;
+            return false;
         }
         if (c >= 'a' && c <= 'z') {
             lower = true;
@@ -109,30 +148,34 @@ std::pair<std::string, Data> Bech32::decode(const std::string& str) {
         if (c >= 'A' && c <= 'Z') {
             upper = true;
         }
-    }
-    if (lower && upper) {
-        ok = false;
-    }
-    size_t pos = str.rfind('1');
-    if (ok && str.size() <= 120 && pos != str.npos && pos >= 1 && pos + 7 <= str.size()) {
-        Data values;
-        values.resize(str.size() - 1 - pos);
-        for (size_t i = 0; i < str.size() - 1 - pos; ++i) {
-            unsigned char c = str[i + pos + 1];
-            if (charset_rev[c] == -1) {
-                ok = false;
-            }
-            values[i] = charset_rev[c];
+        if (c == '1') {
+            pos = i;
         }
-        if (ok) {
-            std::string hrp;
-            for (size_t i = 0; i < pos; ++i) {
-                hrp += lc(str[i]);
-            }
-            if (verify_checksum(hrp, values)) {
-                return std::make_pair(hrp, Data(values.begin(), values.end() - 6));
-            }
+    }
+    if ((lower && upper) || pos == length || pos < 1 || pos + 7 > length) {
+        return false;
+    }
+    uint32_t chk = polymod_hrp(str, pos);
+    for (size_t i = pos + 1; i < length; ++i) {
+        int8_t value = charset_rev[static_cast<unsigned char>(str[i])];
+        if (value == -1) {
+            return false;
         }
+        chk = polymod_step(chk, static_cast<uint8_t>(value));
+    }
+    switch (chk) {
+    case static_cast<uint32_t>(ChecksumVariant::Bech32):
+        view.variant = ChecksumVariant::Bech32;
+        break;
+    case static_cast<uint32_t>(ChecksumVariant::Bech32M):
+        view.variant = ChecksumVariant::Bech32M;
+        break;
+    default:
+        return false;
     }
-    return std::make_pair(std::string(), Data());
+    view.hrp = str;
+    view.hrpLength = pos;
+    view.values = str + pos + 1;
+    view.valuesLength = length - pos - 1 - checksumLength;
+    return true;
 }
@@ -5,45 +5,118 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#pragma once
+
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <string>
 #include <vector>
 
 namespace TW::Bech32 {
 
+/// Checksum constants, Bech32 (BIP173) and Bech32m (BIP350).
+enum class ChecksumVariant : uint32_t {
+    None = 0,
+    Bech32 = 1,
+    Bech32M = 0x2bc830a3,
+};
+
+/// Maximum length of a string accepted by the decoder.
+constexpr std::size_t maxLength = 120;
+
+/// Number of 5-bit checksum values appended to the data.
+constexpr std::size_t checksumLength = 6;
+
+/// Length of an encoded string for the given human-readable part and number of 5-bit values.
+constexpr std::size_t encodedLength(std::size_t hrpLength, std::size_t valuesLength) {
+    return hrpLength + 1 + valuesLength + checksumLength;
+}
+
+/// Number of output groups `convertBits` produces from `inLength` input groups
+/// (an upper bound when not padding).
+template <int frombits, int tobits, bool pad>
+constexpr std::size_t convertedLength(std::size_t inLength) {
+    return pad ? (inLength * frombits + tobits - 1) / tobits : inLength * frombits / tobits;
+}
+
+/// Non-owning view of a string with a valid Bech32 or Bech32m checksum.
+/// Points into the decoded string, which must outlive the view.
+struct View {
+    /// Human-readable part, as it appears in the input (may be upper case).
+    const char* hrp = nullptr;
+    std::size_t hrpLength = 0;
+
+    /// Data characters, excluding the separator and the checksum.
+    const char* values = nullptr;
+    std::size_t valuesLength = 0;
+
+    ChecksumVariant variant = ChecksumVariant::None;
+
+    /// Determines if the (lower-cased) human-readable part starts with `prefix`.
+    bool hrpHasPrefix(const std::string& prefix) const;
+
+    /// Returns the lower-cased human-readable part.
+    std::string hrpString() const;
+
+    /// Writes the 5-bit data values to `out`, which must have room for `valuesLength` bytes.
+    void copyValues(uint8_t* out) const;
+};
+
 /// Encodes a Bech32 string.
 ///
 /// \returns the encoded string, or an empty string in case of failure.
 std::string encode(const std::string& hrp, const std::vector<uint8_t>& values);
 
+/// Encodes a Bech32 or Bech32m string into a caller-provided buffer without allocating.
+/// `out` must have room for `encodedLength(hrpLength, valuesLength)` characters; no terminator is written.
+///
+/// \returns the number of characters written.
+std::size_t encode(char* out, const char* hrp, std::size_t hrpLength, const uint8_t* values,
+                   std::size_t valuesLength, ChecksumVariant variant = ChecksumVariant::Bech32);
+
 /// Decodes a Bech32 string.
 ///
 /// \returns a pair with the human-readable part and the data, or a pair or
 /// empty collections on failure.
 std::pair<std::string, std::vector<uint8_t>> decode(const std::string& str);
 
-/// Converts from one power-of-2 number base to another.
-template <int frombits, int tobits, bool pad>
-inline bool convertBits(std::vector<uint8_t>& out, const std::vector<uint8_t>& in) {
+/// Decodes a Bech32 or Bech32m string in place, without allocating.
+///
+/// \returns true and fills `view` if the string is well-formed and its checksum matches either variant.
+bool decode(const char* str, std::size_t length, View& view);
+
+/// Converts from one power-of-2 number base to another, writing through `out`
+/// (advanced past the last written value).
+template <int frombits, int tobits, bool pad, typename InputIt, typename OutputIt>
+inline bool convertBits(OutputIt& out, InputIt first, InputIt last) {
     int acc = 0;
     int bits = 0;
     const int maxv = (1 << tobits) - 1;
     const int max_acc = (1 << (frombits + tobits - 1)) - 1;
-    for (const auto& value : in) {
-        acc = ((acc << frombits) | value) & max_acc;
+    for (; first != last; ++first) {
+        acc = ((acc << frombits) | *first) & max_acc;
         bits += frombits;
         while (bits >= tobits) {
             bits -= tobits;
-            out.push_back((acc >> bits) & maxv);
+            *out++ = static_cast<uint8_t>((acc >> bits) & maxv);
         }
     }
     if (pad) {
         if (bits)
-            out.push_back((acc << (tobits - bits)) & maxv);
+            *out++ = static_cast<uint8_t>((acc << (tobits - bits)) & maxv);
     } else if (bits >= frombits || ((acc << (tobits - bits)) & maxv)) {
         return false;
     }
     return true;
 }
 
+/// Converts from one power-of-2 number base to another.
+template <int frombits, int tobits, bool pad>
+inline bool convertBits(std::vector<uint8_t>& out, const std::vector<uint8_t>& in) {
+    out.reserve(out.size() + convertedLength<frombits, tobits, pad>(in.size()));
+    auto it = std::back_inserter(out);
+    return convertBits<frombits, tobits, pad>(it, in.begin(), in.end());
+}
+
 } // namespace TW::Bech32
@@ -9,49 +9,73 @@
 #include "Data.h"
 #include <TrezorCrypto/ecdsa.h>
 
+#include <array>
+
 using namespace TW;
 
 bool Bech32Address::isValid(const std::string& addr) {
     return isValid(addr, "");
 }
 
-bool Bech32Address::isValid(const std::string& addr, const std::string& hrp) {
-    auto dec = Bech32::decode(addr);
+namespace {
+
+/// Maximum number of bytes a valid address payload can decode to.
+constexpr size_t maxKeyHashLength = 40;
+
+/// Decodes an address and its key hash into fixed buffers, without allocating.
+/// \returns the length of the key hash, or 0 on failure.
+size_t decodeKeyHash(const std::string& addr, const std::string& hrp, Bech32::View& view,
+                     std::array<uint8_t, Bech32::convertedLength<5, 8, false>(Bech32::maxLength)>& keyHash) {
+    if (!Bech32::decode(addr.data(), addr.size(), view) || view.variant != Bech32::ChecksumVariant::Bech32) {
+        return 0;
+    }
     // check hrp prefix (if given)
-    if (hrp.length() > 0 && dec.first.compare(0, hrp.length(), hrp) != 0) {
-        return false;
+    if (hrp.length() > 0 && !view.hrpHasPrefix(hrp)) {
+        return 0;
     }
-    if (dec.second.empty()) {
-        return false;
+    if (view.valuesLength == 0) {
+        return 0;
     }
 
-    Data conv;
-    auto success = Bech32::convertBits<5, 8, false>(conv, dec.second);
-    if (!success || conv.size() < 2 || conv.size() > 40) {
-        return false;
+    std::array<uint8_t, Bech32::maxLength> values;
+    view.copyValues(values.data());
+    auto out = keyHash.begin();
+    auto success = Bech32::convertBits<5, 8, false>(out, values.begin(), values.begin() + view.valuesLength);
+    const auto size = static_cast<size_t>(out - keyHash.begin());
+    if (!success || size < 2 || size > maxKeyHashLength) {
+        return 0;
     }
+    return size;
+}
 
-    return true;
+} // namespace
+
+bool Bech32Address::isValid(const std::string& addr, const std::string& hrp) {
+    Bech32::View view;
+    std::array<uint8_t, Bech32::convertedLength<5, 8, false>(Bech32::maxLength)> keyHash;
+    return decodeKeyHash(addr, hrp, view, keyHash) != 0;
 }
 
-bool Bech32Address::decode(const std::string& addr, Bech32Address& obj_out, const std::string& hrp) {
-    auto dec = Bech32::decode(addr);
-    // check hrp prefix (if given)
-    if (hrp.length() > 0 && dec.first.compare(0, hrp.length(), hrp) != 0) {
-        return false;
-    }
-    if (dec.second.empty()) {
-        return false;
+std::vector<bool> Bech32Address::isValidBatch(const std::vector<std::string>& addrs, const std::string& hrp) {
+    std::vector<bool> result(addrs.size());
+    Bech32::View view;
+    std::array<uint8_t, Bech32::convertedLength<5, 8, false>(Bech32::maxLength)> keyHash;
+    for (size_t i = 0; i < addrs.size(); ++i) {
+        result[i] = decodeKeyHash(addrs[i], hrp, view, keyHash) != 0;
     }
+    return result;
+}
 
-    Data conv;
-    auto success = Bech32::convertBits<5, 8, false>(conv, dec.second);
-    if (!success || conv.size() < 2 || conv.size() > 40) {
+bool Bech32Address::decode(const std::string& addr, Bech32Address& obj_out, const std::string& hrp) {
+    Bech32::View view;
+    std::array<uint8_t, Bech32::convertedLength<5, 8, false>(Bech32::maxLength)> keyHash;
+    const auto size = decodeKeyHash(addr, hrp, view, keyHash);
+    if (size == 0) {
         return false;
     }
 
-    obj_out.setHrp(dec.first);
-    obj_out.setKey(conv);
+    obj_out.setHrp(view.hrpString());
+    obj_out.setKey(Data(keyHash.begin(), keyHash.begin() + size));
     return true;
 }
 
@@ -90,11 +114,17 @@ Bech32Address::Bech32Address(const std::string& hrp, HasherType hasher, const Pu
 }
 
 std::string Bech32Address::string() const {
-    Data enc;
-    if (!Bech32::convertBits<8, 5, true>(enc, keyHash)) {
+    if (keyHash.size() > maxKeyHashLength) {
+        return "";
+    }
+    std::array<uint8_t, Bech32::convertedLength<8, 5, true>(maxKeyHashLength)> enc;
+    auto out = enc.begin();
+    if (!Bech32::convertBits<8, 5, true>(out, keyHash.begin(), keyHash.end())) {
         return "";
     }
-    std::string result = Bech32::encode(hrp, enc);
+    const auto encLength = static_cast<size_t>(out - enc.begin());
+    std::string result(Bech32::encodedLength(hrp.size(), encLength), '\0');
+    Bech32::encode(&result[0], hrp.data(), hrp.size(), enc.data(), encLength);
     // check back
     Bech32Address obj;
     if (!decode(result, obj, hrp)) {
@@ -12,6 +12,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace TW {
 
@@ -32,6 +33,10 @@ public:
     /// Determines whether a string makes a valid Bech32 address, and the HRP matches.
     static bool isValid(const std::string& addr, const std::string& hrp);
 
+    /// Validates many addresses against the same HRP, reusing decode buffers.
+    /// \returns one flag per input address.
+    static std::vector<bool> isValidBatch(const std::vector<std::string>& addrs, const std::string& hrp);
+
     /// Decodes an address and create an address object out of it.  
     /// obj_out:  Pass-by-ref, result is initialized here if possible, it can be a derived address type.
     /// hrp: the expected hrp prefix (if missing ("") no prefix check is done).
@@ -15,7 +15,7 @@ using namespace TW;
 using namespace TW::Binance;
 using namespace google::protobuf;
 
-using json = nlohmann::json;
+using Writer = JSONWriter;
 
 static inline std::string addressString(const std::string& bytes) {
     auto data = Data(bytes.begin(), bytes.end());
@@ -27,157 +27,233 @@ static inline std::string validatorAddress(const std::string& bytes) {
     return Bech32Address(Address::hrpValidator, data).string();
 }
 
-json Binance::signatureJSON(const Proto::SigningInput& input) {
-    json j;
-    j["account_number"] = std::to_string(input.account_number());
-    j["chain_id"] = input.chain_id();
-    j["data"] = nullptr;
-    j["memo"] = input.memo();
-    j["msgs"] = json::array({orderJSON(input)});
-    j["sequence"] = std::to_string(input.sequence());
-    j["source"] = std::to_string(input.source());
-    return j;
+// Object keys are written in sorted order, see JSONWriter.
+
+void Binance::signatureJSON(Writer& w, const Proto::SigningInput& input) {
+    w.beginObject();
+    w.field("account_number", std::to_string(input.account_number()));
+    w.field("chain_id", input.chain_id());
+    w.key("data");
+    w.null();
+    w.field("memo", input.memo());
+    w.key("msgs");
+    w.beginArray();
+    orderJSON(w, input);
+    w.endArray();
+    w.field("sequence", std::to_string(input.sequence()));
+    w.field("source", std::to_string(input.source()));
+    w.endObject();
+}
+
+std::string Binance::signatureJSON(const Proto::SigningInput& input) {
+    std::string buffer;
+    Writer w(buffer);
+    signatureJSON(w, input);
+    return buffer;
 }
 
-json Binance::orderJSON(const Proto::SigningInput& input) {
-    json j;
+void Binance::orderJSON(Writer& w, const Proto::SigningInput& input) {
     if (input.has_trade_order()) {
-        j["id"] = input.trade_order().id();
-        j["ordertype"] = 2;
-        j["price"] = input.trade_order().price();
-        j["quantity"] = input.trade_order().quantity();
-        j["sender"] = addressString(input.trade_order().sender());
-        j["side"] = input.trade_order().side();
-        j["symbol"] = input.trade_order().symbol();
-        j["timeinforce"] = input.trade_order().timeinforce();
+        const auto& order = input.trade_order();
+        w.beginObject();
+        w.field("id", order.id());
+        w.field("ordertype", 2);
+        w.field("price", order.price());
+        w.field("quantity", order.quantity());
+        w.field("sender", addressString(order.sender()));
+        w.field("side", order.side());
+        w.field("symbol", order.symbol());
+        w.field("timeinforce", order.timeinforce());
+        w.endObject();
     } else if (input.has_cancel_trade_order()) {
-        j["refid"] = input.cancel_trade_order().refid();
-        j["sender"] = addressString(input.cancel_trade_order().sender());
-        j["symbol"] = input.cancel_trade_order().symbol();
+        const auto& order = input.cancel_trade_order();
+        w.beginObject();
+        w.field("refid", order.refid());
+        w.field("sender", addressString(order.sender()));
+        w.field("symbol", order.symbol());
+        w.endObject();
     } else if (input.has_send_order()) {
-        j["inputs"] = inputsJSON(input.send_order());
-        j["outputs"] = outputsJSON(input.send_order());
+        w.beginObject();
+        w.key("inputs");
+        inputsJSON(w, input.send_order());
+        w.key("outputs");
+        outputsJSON(w, input.send_order());
+        w.endObject();
     } else if (input.has_freeze_order()) {
-        j["from"] = addressString(input.freeze_order().from());
-        j["symbol"] = input.freeze_order().symbol();
-        j["amount"] = input.freeze_order().amount();
+        const auto& order = input.freeze_order();
+        w.beginObject();
+        w.field("amount", order.amount());
+        w.field("from", addressString(order.from()));
+        w.field("symbol", order.symbol());
+        w.endObject();
     } else if (input.has_unfreeze_order()) {
-        j["from"] = addressString(input.unfreeze_order().from());
-        j["symbol"] = input.unfreeze_order().symbol();
-        j["amount"] = input.unfreeze_order().amount();
+        const auto& order = input.unfreeze_order();
+        w.beginObject();
+        w.field("amount", order.amount());
+        w.field("from", addressString(order.from()));
+        w.field("symbol", order.symbol());
+        w.endObject();
     } else if (input.has_htlt_order()) {
-        j["from"] = addressString(input.htlt_order().from());
-        j["to"] = addressString(input.htlt_order().to());
-        j["recipient_other_chain"] = input.htlt_order().recipient_other_chain();
-        j["sender_other_chain"] = input.htlt_order().sender_other_chain();
-        j["random_number_hash"] = hex(input.htlt_order().random_number_hash());
-        j["timestamp"] = input.htlt_order().timestamp();
-        j["amount"] = tokensJSON(input.htlt_order().amount());
-        j["expected_income"] = input.htlt_order().expected_income();
-        j["height_span"] = input.htlt_order().height_span();
-        j["cross_chain"] = input.htlt_order().cross_chain();
+        const auto& order = input.htlt_order();
+        w.beginObject();
+        w.key("amount");
+        tokensJSON(w, order.amount());
+        w.field("cross_chain", order.cross_chain());
+        w.field("expected_income", order.expected_income());
+        w.field("from", addressString(order.from()));
+        w.field("height_span", order.height_span());
+        w.field("random_number_hash", hex(order.random_number_hash()));
+        w.field("recipient_other_chain", order.recipient_other_chain());
+        w.field("sender_other_chain", order.sender_other_chain());
+        w.field("timestamp", order.timestamp());
+        w.field("to", addressString(order.to()));
+        w.endObject();
     } else if (input.has_deposithtlt_order()) {
-        j["from"] = addressString(input.deposithtlt_order().from());
-        j["swap_id"] = hex(input.deposithtlt_order().swap_id());
-        j["amount"] = tokensJSON(input.deposithtlt_order().amount());
+        const auto& order = input.deposithtlt_order();
+        w.beginObject();
+        w.key("amount");
+        tokensJSON(w, order.amount());
+        w.field("from", addressString(order.from()));
+        w.field("swap_id", hex(order.swap_id()));
+        w.endObject();
     } else if (input.has_claimhtlt_order()) {
-        j["from"] = addressString(input.claimhtlt_order().from());
-        j["swap_id"] = hex(input.claimhtlt_order().swap_id());
-        j["random_number"] = hex(input.claimhtlt_order().random_number());
+        const auto& order = input.claimhtlt_order();
+        w.beginObject();
+        w.field("from", addressString(order.from()));
+        w.field("random_number", hex(order.random_number()));
+        w.field("swap_id", hex(order.swap_id()));
+        w.endObject();
     } else if (input.has_refundhtlt_order()) {
-        j["from"] = addressString(input.refundhtlt_order().from());
-        j["swap_id"] = hex(input.refundhtlt_order().swap_id());
+        const auto& order = input.refundhtlt_order();
+        w.beginObject();
+        w.field("from", addressString(order.from()));
+        w.field("swap_id", hex(order.swap_id()));
+        w.endObject();
     } else if (input.has_transfer_out_order()) {
-        auto to = input.transfer_out_order().to();
+        const auto& order = input.transfer_out_order();
+        const auto& to = order.to();
         auto addr = Ethereum::Address(Data(to.begin(), to.end()));
-        j["from"] = addressString(input.transfer_out_order().from());
-        j["to"] = addr.string();
-        j["amount"] = tokenJSON(input.transfer_out_order().amount());
-        j["expire_time"] = input.transfer_out_order().expire_time();
+        w.beginObject();
+        w.key("amount");
+        tokenJSON(w, order.amount());
+        w.field("expire_time", order.expire_time());
+        w.field("from", addressString(order.from()));
+        w.field("to", addr.string());
+        w.endObject();
     } else if (input.has_side_delegate_order()) {
-        j["type"] = "cosmos-sdk/MsgSideChainDelegate";
-        j["value"] = {
-            {"delegator_addr", addressString(input.side_delegate_order().delegator_addr())},
-            {"validator_addr",validatorAddress(input.side_delegate_order().validator_addr())},
-            {"delegation", tokenJSON(input.side_delegate_order().delegation(), true)},
-            {"side_chain_id", input.side_delegate_order().chain_id()},
-        };
+        const auto& order = input.side_delegate_order();
+        w.beginObject();
+        w.field("type", "cosmos-sdk/MsgSideChainDelegate");
+        w.key("value");
+        w.beginObject();
+        w.key("delegation");
+        tokenJSON(w, order.delegation(), true);
+        w.field("delegator_addr", addressString(order.delegator_addr()));
+        w.field("side_chain_id", order.chain_id());
+        w.field("validator_addr", validatorAddress(order.validator_addr()));
+        w.endObject();
+        w.endObject();
     } else if (input.has_side_redelegate_order()) {
-        j["type"] = "cosmos-sdk/MsgSideChainRedelegate";
-        j["value"] = {
-            {"delegator_addr", addressString(input.side_redelegate_order().delegator_addr())},
-            {"validator_src_addr", validatorAddress(input.side_redelegate_order().validator_src_addr())},
-            {"validator_dst_addr", validatorAddress(input.side_redelegate_order().validator_dst_addr())},
-            {"amount", tokenJSON(input.side_redelegate_order().amount(), true)},
-            {"side_chain_id", input.side_redelegate_order().chain_id()},
-        };
+        const auto& order = input.side_redelegate_order();
+        w.beginObject();
+        w.field("type", "cosmos-sdk/MsgSideChainRedelegate");
+        w.key("value");
+        w.beginObject();
+        w.key("amount");
+        tokenJSON(w, order.amount(), true);
+        w.field("delegator_addr", addressString(order.delegator_addr()));
+        w.field("side_chain_id", order.chain_id());
+        w.field("validator_dst_addr", validatorAddress(order.validator_dst_addr()));
+        w.field("validator_src_addr", validatorAddress(order.validator_src_addr()));
+        w.endObject();
+        w.endObject();
     } else if (input.has_side_undelegate_order()) {
-        j["type"] = "cosmos-sdk/MsgSideChainUndelegate";
-        j["value"] = {
-            {"delegator_addr", addressString(input.side_undelegate_order().delegator_addr())},
-            {"validator_addr", validatorAddress(input.side_undelegate_order().validator_addr())},
-            {"amount", tokenJSON(input.side_undelegate_order().amount(), true)},
-            {"side_chain_id", input.side_undelegate_order().chain_id()},
-        };
+        const auto& order = input.side_undelegate_order();
+        w.beginObject();
+        w.field("type", "cosmos-sdk/MsgSideChainUndelegate");
+        w.key("value");
+        w.beginObject();
+        w.key("amount");
+        tokenJSON(w, order.amount(), true);
+        w.field("delegator_addr", addressString(order.delegator_addr()));
+        w.field("side_chain_id", order.chain_id());
+        w.field("validator_addr", validatorAddress(order.validator_addr()));
+        w.endObject();
+        w.endObject();
     } else if (input.has_time_lock_order()) {
-        j["from"] = addressString(input.time_lock_order().from_address());
-        j["description"] = input.time_lock_order().description();
-        j["amount"] = tokensJSON(input.time_lock_order().amount());
-        j["lock_time"] = input.time_lock_order().lock_time();
+        const auto& order = input.time_lock_order();
+        w.beginObject();
+        w.key("amount");
+        tokensJSON(w, order.amount());
+        w.field("description", order.description());
+        w.field("from", addressString(order.from_address()));
+        w.field("lock_time", order.lock_time());
+        w.endObject();
     } else if (input.has_time_relock_order()) {
-        const auto amount = input.time_relock_order().amount();
-        j["from"] = addressString(input.time_relock_order().from_address());
-        j["time_lock_id"] = input.time_relock_order().id();
-        j["description"] = input.time_relock_order().description();
+        const auto& order = input.time_relock_order();
+        w.beginObject();
         // if amount is empty or omitted, set null to avoid signature verification error
-        j["amount"] = nullptr;
-        if (amount.size() > 0) {
-            j["amount"] = tokensJSON(amount);
+        w.key("amount");
+        if (order.amount().size() > 0) {
+            tokensJSON(w, order.amount());
+        } else {
+            w.null();
         }
-        j["lock_time"] = input.time_relock_order().lock_time();
+        w.field("description", order.description());
+        w.field("from", addressString(order.from_address()));
+        w.field("lock_time", order.lock_time());
+        w.field("time_lock_id", order.id());
+        w.endObject();
     } else if (input.has_time_unlock_order()) {
-        j["from"] = addressString(input.time_unlock_order().from_address());
-        j["time_lock_id"] = input.time_unlock_order().id();
+        const auto& order = input.time_unlock_order();
+        w.beginObject();
+        w.field("from", addressString(order.from_address()));
+        w.field("time_lock_id", order.id());
+        w.endObject();
+    } else {
+        w.null();
     }
-    return j;
 }
 
-json Binance::inputsJSON(const Proto::SendOrder& order) {
-    json j = json::array();
+void Binance::inputsJSON(Writer& w, const Proto::SendOrder& order) {
+    w.beginArray();
     for (auto& input : order.inputs()) {
-        j.push_back({
-            {"address", addressString(input.address())},
-            {"coins", tokensJSON(input.coins())}
-        });
+        w.beginObject();
+        w.field("address", addressString(input.address()));
+        w.key("coins");
+        tokensJSON(w, input.coins());
+        w.endObject();
     }
-    return j;
+    w.endArray();
 }
 
-json Binance::outputsJSON(const Proto::SendOrder& order) {
-    json j = json::array();
+void Binance::outputsJSON(Writer& w, const Proto::SendOrder& order) {
+    w.beginArray();
     for (auto& output : order.outputs()) {
-        j.push_back({
-            {"address", addressString(output.address())},
-            {"coins", tokensJSON(output.coins())}
-        });
+        w.beginObject();
+        w.field("address", addressString(output.address()));
+        w.key("coins");
+        tokensJSON(w, output.coins());
+        w.endObject();
     }
-    return j;
+    w.endArray();
 }
 
-json Binance::tokenJSON(const Proto::SendOrder_Token& token, bool stringAmount) {
-    json j = { {"denom", token.denom()} };
+void Binance::tokenJSON(Writer& w, const Proto::SendOrder_Token& token, bool stringAmount) {
+    w.beginObject();
     if (stringAmount) {
-        j["amount"] = std::to_string(token.amount());
+        w.field("amount", std::to_string(token.amount()));
     } else {
-        j["amount"] = token.amount();
+        w.field("amount", token.amount());
     }
-    return j;
+    w.field("denom", token.denom());
+    w.endObject();
 }
 
-json Binance::tokensJSON(const RepeatedPtrField<Proto::SendOrder_Token>& tokens) {
-    json j = json::array();
+void Binance::tokensJSON(Writer& w, const RepeatedPtrField<Proto::SendOrder_Token>& tokens) {
+    w.beginArray();
     for (auto& token : tokens) {
-        j.push_back(tokenJSON(token));
+        tokenJSON(w, token);
     }
-    return j;
+    w.endArray();
 }
@@ -6,16 +6,21 @@
 
 #pragma once
 
+#include "../JSONWriter.h"
 #include "../proto/Binance.pb.h"
-#include <nlohmann/json.hpp>
+
+#include <string>
 
 namespace TW::Binance {
 
-nlohmann::json signatureJSON(const Proto::SigningInput& input);
-nlohmann::json orderJSON(const Proto::SigningInput& input);
-nlohmann::json inputsJSON(const Proto::SendOrder& order);
-nlohmann::json outputsJSON(const Proto::SendOrder& order);
-nlohmann::json tokenJSON(const Proto::SendOrder_Token& token, bool stringAmount = false);
-nlohmann::json tokensJSON(const ::google::protobuf::RepeatedPtrField<Proto::SendOrder_Token>& tokens);
+/// Canonical (sorted, compact) JSON document to sign.
+std::string signatureJSON(const Proto::SigningInput& input);
+
+void signatureJSON(JSONWriter& writer, const Proto::SigningInput& input);
+void orderJSON(JSONWriter& writer, const Proto::SigningInput& input);
+void inputsJSON(JSONWriter& writer, const Proto::SendOrder& order);
+void outputsJSON(JSONWriter& writer, const Proto::SendOrder& order);
+void tokenJSON(JSONWriter& writer, const Proto::SendOrder_Token& token, bool stringAmount = false);
+void tokensJSON(JSONWriter& writer, const ::google::protobuf::RepeatedPtrField<Proto::SendOrder_Token>& tokens);
 
 } // namespace TW::Binance
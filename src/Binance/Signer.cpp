@@ -72,8 +72,7 @@ Data Signer::sign() const {
 }
 
 std::string Signer::signaturePreimage() const {
-    auto json = signatureJSON(input);
-    return json.dump();
+    return signatureJSON(input);
 }
 
 Data Signer::encodeTransaction(const Data& signature) const {
@@ -5,13 +5,17 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "TransactionBuilder.h"
+#include "SigHashType.h"
 #include "TransactionSigner.h"
 
+#include "../BinaryCoding.h"
 #include "../Coin.h"
+#include "../HexCoding.h"
 #include "../proto/Bitcoin.pb.h"
 
 #include <algorithm>
 #include <cassert>
+#include <stdexcept>
 
 namespace TW::Bitcoin {
 
@@ -20,23 +24,173 @@ int64_t estimateSimpleFee(const FeeCalculator& feeCalculator, const TransactionP
     return feeCalculator.calculate(plan.utxos.size(), outputSize, byteFee);
 }
 
-/// Estimate encoded size by invoking sign(sizeOnly), get actual size
-int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionPlan& plan, int outputSize, const Bitcoin::Proto::SigningInput& input) {
-    TWPurpose coinPurpose = TW::purpose(static_cast<TWCoinType>(input.coin_type()));
-    if (coinPurpose != TWPurposeBIP84) {
-        // not segwit, return default simple estimate
-        return estimateSimpleFee(feeCalculator, plan, outputSize, input.byte_fee());
+namespace {
+
+// sizes of the placeholders used when signing in estimation mode
+constexpr size_t signatureSize = 72;
+constexpr size_t publicKeySize = 33;
+
+/// Size of a data push, as written by `TransactionSigner::pushAll` (for items other than small numbers)
+size_t pushSize(size_t size) {
+    if (size == 0 || size < OP_PUSHDATA1) {
+        return 1 + size;
+    } else if (size <= 0xff) {
+        return 2 + size;
+    } else if (size <= 0xffff) {
+        return 3 + size;
+    }
+    return 5 + size;
+}
+
+/// Size of a witness stack item
+size_t witnessItemSize(size_t size) {
+    return varIntSize(size) + size;
+}
+
+/// Sizes of the signature script and the witness of a signed input
+struct SignedInputSize {
+    size_t scriptSig = 0;
+    /// serialized witness stack, including the item count
+    size_t witness = 1;
+    bool hasWitness = false;
+};
+
+std::optional<Script> scriptForScriptHash(const Bitcoin::Proto::SigningInput& input, const Data& hash) {
+    const auto found = input.scripts().find(hex(hash));
+    if (found == input.scripts().end()) {
+        return {};
+    }
+    return Script(found->second.begin(), found->second.end());
+}
+
+SignedInputSize witnessPublicKeyHashSize() {
+    SignedInputSize size;
+    size.witness = varIntSize(2) + witnessItemSize(signatureSize) + witnessItemSize(publicKeySize);
+    size.hasWitness = true;
+    return size;
+}
+
+/// Witness spending a P2WSH output: the stack satisfying the witness script (multisig, P2PK or P2PKH), then the script
+std::optional<SignedInputSize> witnessScriptHashSize(const Script& witnessScript) {
+    Data data;
+    std::vector<Data> keys;
+    int required;
+    SignedInputSize size;
+    size.hasWitness = true;
+    const auto scriptItem = witnessItemSize(witnessScript.bytes.size());
+    if (witnessScript.matchMultisig(keys, required)) {
+        // an empty item (CHECKMULTISIG bug), the signatures, empty items for missing keys
+        const auto signatures = std::min(static_cast<size_t>(required), keys.size());
+        const auto empties = 1 + static_cast<size_t>(required) - signatures;
+        size.witness = varIntSize(required + 2) + empties + signatures * witnessItemSize(signatureSize) + scriptItem;
+    } else if (witnessScript.matchPayToPublicKey(data)) {
+        size.witness = varIntSize(2) + witnessItemSize(signatureSize) + scriptItem;
+    } else if (witnessScript.matchPayToPublicKeyHash(data)) {
+        size.witness = varIntSize(3) + witnessItemSize(signatureSize) + witnessItemSize(publicKeySize) + scriptItem;
+    } else {
+        return {};
+    }
+    return size;
+}
+
+/// Sizes of an input spending `script` once signed; mirrors the paths taken by `TransactionSigner::sign`
+std::optional<SignedInputSize> signedInputSize(const Script& script, const Bitcoin::Proto::SigningInput& input) {
+    Data data;
+    if (script.matchPayToPublicKeyHash(data)) {
+        SignedInputSize size;
+        size.scriptSig = pushSize(signatureSize) + pushSize(publicKeySize);
+        return size;
+    }
+    if (script.matchPayToWitnessPublicKeyHash(data)) {
+        return witnessPublicKeyHashSize();
+    }
+    if (script.matchPayToWitnessScriptHash(data)) {
+        const auto witnessScript = scriptForScriptHash(input, Hash::ripemd(data));
+        if (!witnessScript) {
+            return {};
+        }
+        return witnessScriptHashSize(*witnessScript);
+    }
+    if (script.matchPayToScriptHash(data)) {
+        const auto redeemScript = scriptForScriptHash(input, data);
+        if (!redeemScript) {
+            return {};
+        }
+        std::optional<SignedInputSize> size;
+        if (redeemScript->matchPayToWitnessPublicKeyHash(data)) {
+            size = witnessPublicKeyHashSize();
+        } else if (redeemScript->matchPayToWitnessScriptHash(data)) {
+            const auto witnessScript = scriptForScriptHash(input, Hash::ripemd(data));
+            if (!witnessScript) {
+                return {};
+            }
+            size = witnessScriptHashSize(*witnessScript);
+        }
+        if (size) {
+            size->scriptSig = pushSize(redeemScript->bytes.size());
+        }
+        return size;
+    }
+    return {};
+}
+
+size_t outputSize(const Script& lockingScript) {
+    return 8 + varIntSize(lockingScript.bytes.size()) + lockingScript.bytes.size();
+}
+
+} // namespace
+
+std::optional<uint64_t> TransactionBuilder::estimateVirtualSize(const TransactionPlan& plan, const Bitcoin::Proto::SigningInput& input) {
+    // same outputs as `build`
+    const auto coin = static_cast<TWCoinType>(input.coin_type());
+    const auto lockingScriptTo = Script::lockScriptForAddress(input.to_address(), coin);
+    if (lockingScriptTo.empty() || plan.utxos.empty()) {
+        return {};
     }
+    size_t outputs = 1;
+    size_t outputsSize = outputSize(lockingScriptTo);
+    if (plan.change > 0) {
+        ++outputs;
+        outputsSize += outputSize(Script::lockScriptForAddress(input.change_address(), coin));
+    }
+
+    // version, counts, outputs, lock time
+    uint64_t baseSize = 4 + varIntSize(plan.utxos.size()) + varIntSize(outputs) + outputsSize + 4;
+    // marker and flag, then the witnesses
+    uint64_t witnessSize = 2;
+    bool hasWitness = false;
+    const auto hashSingle = hashTypeIsSingle(static_cast<enum TWBitcoinSigHashType>(input.hash_type()));
+    for (size_t i = 0; i < plan.utxos.size(); ++i) {
+        auto size = SignedInputSize();
+        // inputs without a corresponding output are not signed with SIGHASH_SINGLE
+        if (!hashSingle || i < outputs) {
+            const auto& utxoScript = plan.utxos[i].script();
+            const auto signedSize = signedInputSize(Script(utxoScript.begin(), utxoScript.end()), input);
+            if (!signedSize) {
+                return {};
+            }
+            size = *signedSize;
+        }
+        // outpoint, signature script, sequence
+        baseSize += 36 + varIntSize(size.scriptSig) + size.scriptSig + 4;
+        witnessSize += size.witness;
+        hasWitness = hasWitness || size.hasWitness;
+    }
+    if (!hasWitness) {
+        return baseSize;
+    }
+    return baseSize + (witnessSize + 3) / 4;
+}
 
+std::optional<uint64_t> TransactionBuilder::signedVirtualSize(const TransactionPlan& plan, const Bitcoin::Proto::SigningInput& input) {
     // duplicate input, with the current plan
-    auto inputWithPlan = std::move(input);
+    auto inputWithPlan = input;
     *inputWithPlan.mutable_plan() = plan.proto();
 
     auto signer = TransactionSigner<Transaction, TransactionBuilder>(std::move(inputWithPlan), true);
     auto result = signer.sign();
     if (!result) {
-        // signing failed; return default simple estimate
-        return estimateSimpleFee(feeCalculator, plan, outputSize, input.byte_fee());
+        return {};
     }
 
     // Obtain the encoded size
@@ -57,12 +211,34 @@ int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionP
         // (in other way: 3/4 of (smaller) non-segwit + 1/4 of segwit size)
         vSize = sizeNonSegwit + witnessSize/4 + (witnessSize % 4 != 0);
     }
-    uint64_t fee = input.byte_fee() * vSize;
+    return vSize;
+}
+
+/// Estimate encoded size from the script types, falling back to signing in estimation mode
+int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionPlan& plan, int outputSize, const Bitcoin::Proto::SigningInput& input, bool validateEstimate) {
+    TWPurpose coinPurpose = TW::purpose(static_cast<TWCoinType>(input.coin_type()));
+    if (coinPurpose != TWPurposeBIP84) {
+        // not segwit, return default simple estimate
+        return estimateSimpleFee(feeCalculator, plan, outputSize, input.byte_fee());
+    }
 
-    return fee;
+    auto vSize = TransactionBuilder::estimateVirtualSize(plan, input);
+    if (!vSize || validateEstimate) {
+        const auto signedSize = TransactionBuilder::signedVirtualSize(plan, input);
+        if (vSize && signedSize != vSize) {
+            throw std::logic_error("Virtual size estimate " + std::to_string(*vSize) + " differs from signed size " +
+                                   (signedSize ? std::to_string(*signedSize) : "(signing failed)"));
+        }
+        vSize = signedSize;
+    }
+    if (!vSize) {
+        // signing failed; return default simple estimate
+        return estimateSimpleFee(feeCalculator, plan, outputSize, input.byte_fee());
+    }
+    return input.byte_fee() * static_cast<int64_t>(*vSize);
 }
 
-TransactionPlan TransactionBuilder::plan(const Bitcoin::Proto::SigningInput& input) {
+TransactionPlan TransactionBuilder::plan(const Bitcoin::Proto::SigningInput& input, bool validateVirtualSizeEstimates) {
     auto plan = TransactionPlan();
 
     const auto& feeCalculator = getFeeCalculator(static_cast<TWCoinType>(input.coin_type()));
@@ -110,7 +286,7 @@ TransactionPlan TransactionBuilder::plan(const Bitcoin::Proto::SigningInput& inp
                 plan.fee = 0;
                 plan.change = 0;
             }
-            plan.fee = estimateSegwitFee(feeCalculator, plan, output_size, input);
+            plan.fee = estimateSegwitFee(feeCalculator, plan, output_size, input, validateVirtualSizeEstimates);
             // If fee is larger then availableAmount (can happen in special maxAmount case), we reduce it (and hope it will go through)
             plan.fee = std::min(plan.availableAmount, plan.fee);
             assert(plan.fee >= 0 && plan.fee <= plan.availableAmount);
@@ -13,13 +13,26 @@
 #include <TrustWalletCore/TWCoinType.h>
 
 #include <algorithm>
+#include <optional>
 
 namespace TW::Bitcoin {
 
 class TransactionBuilder {
 public:
     /// Plans a transaction by selecting UTXOs and calculating fees.
-    static TransactionPlan plan(const Bitcoin::Proto::SigningInput& input);
+    /// If `validateVirtualSizeEstimates` is set, segwit fees are also computed by signing in estimation mode, and
+    /// `std::logic_error` is thrown if the result differs from `estimateVirtualSize`.  Slow, meant for tests.
+    static TransactionPlan plan(const Bitcoin::Proto::SigningInput& input, bool validateVirtualSizeEstimates = false);
+
+    /// Computes the virtual size the transaction of a plan will have once signed, from the script types of the
+    /// selected UTXOs (P2PKH, P2WPKH, P2SH-P2WPKH, and P2WSH or P2SH-P2WSH with a multisig, P2PK or P2PKH
+    /// witness script), without signing.
+    /// Returns nothing if a UTXO has another script type.
+    static std::optional<uint64_t> estimateVirtualSize(const TransactionPlan& plan, const Bitcoin::Proto::SigningInput& input);
+
+    /// Computes the virtual size of the transaction of a plan by signing it in estimation mode.
+    /// Returns nothing if signing fails.
+    static std::optional<uint64_t> signedVirtualSize(const TransactionPlan& plan, const Bitcoin::Proto::SigningInput& input);
 
     /// Builds a transaction by selecting UTXOs and calculating fees.
     template <typename Transaction>
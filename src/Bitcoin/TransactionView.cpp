@@ -0,0 +1,337 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TransactionView.h"
+
+#include "../BinaryCoding.h"
+
+#include <TrezorCrypto/blake256.h>
+#include <TrezorCrypto/sha2.h>
+
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+constexpr size_t hashSize = 32;
+
+/// Bounds-checked sequential reader over a byte range
+class Reader {
+  public:
+    Reader(const byte* data, size_t size) : data(data), size(size) {}
+
+    size_t position() const { return offset; }
+    size_t remaining() const { return size - offset; }
+
+    ByteRange bytes(size_t count) {
+        if (count > remaining()) {
+            throw std::invalid_argument("Transaction truncated");
+        }
+        const auto range = ByteRange{data + offset, count};
+        offset += count;
+        return range;
+    }
+
+    uint8_t u8() { return *bytes(1).data; }
+    uint16_t u16() { return decode16LE(bytes(2).data); }
+    uint32_t u32() { return decode32LE(bytes(4).data); }
+    uint64_t u64() { return decode64LE(bytes(8).data); }
+
+    uint64_t varInt() {
+        const auto first = u8();
+        switch (first) {
+        case 0xfd: return u16();
+        case 0xfe: return u32();
+        case 0xff: return u64();
+        default: return first;
+        }
+    }
+
+    /// Reads a count of items taking at least `minItemSize` bytes each, rejecting counts the data can't hold
+    size_t count(size_t minItemSize) {
+        const auto value = varInt();
+        if (value > remaining() / minItemSize) {
+            throw std::invalid_argument("Invalid item count");
+        }
+        return static_cast<size_t>(value);
+    }
+
+    ByteRange varBytes() {
+        const auto length = varInt();
+        if (length > remaining()) {
+            throw std::invalid_argument("Transaction truncated");
+        }
+        return bytes(static_cast<size_t>(length));
+    }
+
+  private:
+    const byte* data;
+    size_t size;
+    size_t offset = 0;
+};
+
+// smallest serialized input: outpoint, script length, sequence
+constexpr size_t minInputSize = hashSize + 4 + 1 + 4;
+// smallest serialized output: value, script length
+constexpr size_t minOutputSize = 8 + 1;
+
+void readInputs(Reader& reader, std::vector<InputView>& inputs) {
+    inputs.resize(reader.count(minInputSize));
+    for (auto& input : inputs) {
+        input = InputView();
+        input.previousHash = reader.bytes(hashSize);
+        input.previousIndex = reader.u32();
+        input.script = reader.varBytes();
+        input.sequence = reader.u32();
+    }
+}
+
+void readOutputs(Reader& reader, std::vector<OutputView>& outputs) {
+    outputs.resize(reader.count(minOutputSize));
+    for (auto& output : outputs) {
+        output = OutputView();
+        output.value = reader.u64();
+        output.script = reader.varBytes();
+    }
+}
+
+void sha256Final(SHA256_CTX& context, bool doubleHash, Data& hash) {
+    hash.resize(SHA256_DIGEST_LENGTH);
+    sha256_Final(&context, hash.data());
+    if (doubleHash) {
+        sha256_Raw(hash.data(), hash.size(), hash.data());
+    }
+}
+
+Data decredHash(uint32_t versionWord, const byte* data, size_t size) {
+    byte versionBytes[4];
+    versionBytes[0] = static_cast<byte>(versionWord);
+    versionBytes[1] = static_cast<byte>(versionWord >> 8);
+    versionBytes[2] = static_cast<byte>(versionWord >> 16);
+    versionBytes[3] = static_cast<byte>(versionWord >> 24);
+    BLAKE256_CTX context;
+    blake256_Init(&context);
+    blake256_Update(&context, versionBytes, sizeof(versionBytes));
+    blake256_Update(&context, data, size);
+    Data hash(BLAKE256_DIGEST_LENGTH);
+    blake256_Final(&context, hash.data());
+    return hash;
+}
+
+// Decred serialization types
+constexpr uint16_t decredFull = 0;
+constexpr uint16_t decredNoWitness = 1;
+constexpr uint16_t decredOnlyWitness = 2;
+
+} // namespace
+
+std::vector<ByteRange> InputView::witnessStack() const {
+    std::vector<ByteRange> items;
+    if (witness.size == 0) {
+        return items;
+    }
+    auto reader = Reader(witness.data, witness.size);
+    items.resize(reader.count(1));
+    for (auto& item : items) {
+        item = reader.varBytes();
+    }
+    return items;
+}
+
+size_t TransactionView::parse(const byte* data, size_t size, TransactionFormat format) {
+    this->format = format;
+    overwintered = false;
+    versionGroupId = 0;
+    serializeType = 0;
+    lockTime = 0;
+    expiry = 0;
+    valueBalance = 0;
+    bodyBegin = bodyEnd = witnessBegin = witnessEnd = 0;
+
+    auto reader = Reader(data, size);
+    version = reader.u32();
+
+    switch (format) {
+    case TransactionFormat::Bitcoin:
+    case TransactionFormat::Groestlcoin: {
+        bool segwit = false;
+        if (reader.remaining() >= 2 && data[reader.position()] == 0) {
+            // segwit marker, then flag
+            reader.u8();
+            if (reader.u8() != 1) {
+                throw std::invalid_argument("Unsupported transaction flag");
+            }
+            segwit = true;
+        }
+        bodyBegin = reader.position();
+        readInputs(reader, inputs);
+        readOutputs(reader, outputs);
+        bodyEnd = reader.position();
+        if (segwit) {
+            witnessBegin = reader.position();
+            for (auto& input : inputs) {
+                const auto begin = reader.position();
+                const auto items = reader.count(1);
+                for (size_t i = 0; i < items; ++i) {
+                    reader.varBytes();
+                }
+                input.witness = ByteRange{data + begin, reader.position() - begin};
+            }
+            witnessEnd = reader.position();
+        }
+        lockTime = reader.u32();
+        break;
+    }
+
+    case TransactionFormat::Zcash: {
+        overwintered = (version & 0x80000000) != 0;
+        version &= 0x7fffffff;
+        if (!overwintered || (version != 3 && version != 4)) {
+            throw std::invalid_argument("Unsupported Zcash transaction version");
+        }
+        versionGroupId = reader.u32();
+        bodyBegin = reader.position();
+        readInputs(reader, inputs);
+        readOutputs(reader, outputs);
+        lockTime = reader.u32();
+        expiry = reader.u32();
+        if (version == 4) {
+            valueBalance = static_cast<int64_t>(reader.u64());
+            // vShieldedSpend, vShieldedOutput
+            if (reader.varInt() != 0 || reader.varInt() != 0) {
+                throw std::invalid_argument("Shielded Zcash transactions are not supported");
+            }
+        }
+        // vJoinSplit
+        if (reader.varInt() != 0) {
+            throw std::invalid_argument("Shielded Zcash transactions are not supported");
+        }
+        bodyEnd = reader.position();
+        break;
+    }
+
+    case TransactionFormat::Decred: {
+        serializeType = static_cast<uint16_t>(version >> 16);
+        version &= 0xffff;
+        if (serializeType > decredOnlyWitness) {
+            throw std::invalid_argument("Unsupported Decred serialization type");
+        }
+        if (serializeType != decredOnlyWitness) {
+            bodyBegin = reader.position();
+            // outpoint with tree, sequence
+            inputs.resize(reader.count(hashSize + 4 + 1 + 4));
+            for (auto& input : inputs) {
+                input = InputView();
+                input.previousHash = reader.bytes(hashSize);
+                input.previousIndex = reader.u32();
+                input.tree = reader.u8();
+                input.sequence = reader.u32();
+            }
+            // value, script version, script
+            outputs.resize(reader.count(8 + 2 + 1));
+            for (auto& output : outputs) {
+                output = OutputView();
+                output.value = reader.u64();
+                output.scriptVersion = reader.u16();
+                output.script = reader.varBytes();
+            }
+            lockTime = reader.u32();
+            expiry = reader.u32();
+            bodyEnd = reader.position();
+        } else {
+            inputs.clear();
+            outputs.clear();
+        }
+        if (serializeType != decredNoWitness) {
+            witnessBegin = reader.position();
+            const auto count = reader.count(8 + 4 + 4 + 1);
+            if (serializeType == decredOnlyWitness) {
+                inputs.resize(count);
+            } else if (count != inputs.size()) {
+                throw std::invalid_argument("Mismatched witness count");
+            }
+            for (auto& input : inputs) {
+                input.valueIn = reader.u64();
+                input.blockHeight = reader.u32();
+                input.blockIndex = reader.u32();
+                input.script = reader.varBytes();
+            }
+            witnessEnd = reader.position();
+        }
+        break;
+    }
+    }
+
+    encoded = ByteRange{data, reader.position()};
+    return reader.position();
+}
+
+Data TransactionView::txid() const {
+    Data hash;
+    switch (format) {
+    case TransactionFormat::Bitcoin:
+    case TransactionFormat::Groestlcoin: {
+        // version, inputs and outputs, lock time: the serialization without marker, flag and witness
+        SHA256_CTX context;
+        sha256_Init(&context);
+        sha256_Update(&context, encoded.data, 4);
+        sha256_Update(&context, encoded.data + bodyBegin, bodyEnd - bodyBegin);
+        sha256_Update(&context, encoded.data + encoded.size - 4, 4);
+        sha256Final(context, format == TransactionFormat::Bitcoin, hash);
+        break;
+    }
+    case TransactionFormat::Zcash: {
+        SHA256_CTX context;
+        sha256_Init(&context);
+        sha256_Update(&context, encoded.data, encoded.size);
+        sha256Final(context, true, hash);
+        break;
+    }
+    case TransactionFormat::Decred:
+        if (serializeType == decredOnlyWitness) {
+            throw std::logic_error("Witness-only Decred transaction has no id");
+        }
+        hash = decredHash(version | (uint32_t(decredNoWitness) << 16), encoded.data + bodyBegin, bodyEnd - bodyBegin);
+        break;
+    }
+    return hash;
+}
+
+Data TransactionView::wtxid() const {
+    switch (format) {
+    case TransactionFormat::Bitcoin:
+    case TransactionFormat::Groestlcoin: {
+        Data hash;
+        SHA256_CTX context;
+        sha256_Init(&context);
+        sha256_Update(&context, encoded.data, encoded.size);
+        sha256Final(context, format == TransactionFormat::Bitcoin, hash);
+        return hash;
+    }
+    case TransactionFormat::Zcash:
+        return txid();
+    case TransactionFormat::Decred: {
+        if (serializeType != decredFull) {
+            throw std::logic_error("Decred full hash needs prefix and witness");
+        }
+        // hash of the prefix hash and the witness hash
+        auto hashes = txid();
+        append(hashes, decredHash(version | (uint32_t(decredOnlyWitness) << 16), encoded.data + witnessBegin, witnessEnd - witnessBegin));
+        Data hash(BLAKE256_DIGEST_LENGTH);
+        blake256(hashes.data(), hashes.size(), hash.data());
+        return hash;
+    }
+    }
+    return {};
+}
+
+std::vector<Data> TW::Bitcoin::transactionIds(const byte* data, size_t size, TransactionFormat format) {
+    std::vector<Data> ids;
+    scanTransactions(data, size, format, [&ids](const TransactionView& view) { ids.push_back(view.txid()); });
+    return ids;
+}
@@ -0,0 +1,135 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Data.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// Serialization variants understood by `TransactionView`.
+enum class TransactionFormat {
+    /// Legacy and segwit (BIP144) Bitcoin transactions, and coins sharing that format
+    Bitcoin,
+    /// Bitcoin format, hashed with single SHA256
+    Groestlcoin,
+    /// Transparent Overwinter (v3) and Sapling (v4) Zcash transactions
+    Zcash,
+    /// Decred transactions, in any of the full, prefix-only and witness-only serializations
+    Decred,
+};
+
+/// View of a transaction input.
+struct InputView {
+    /// Previous transaction hash, 32 bytes
+    ByteRange previousHash;
+    uint32_t previousIndex = 0;
+    uint32_t sequence = 0;
+    /// Signature script (Decred: from the witness part)
+    ByteRange script;
+
+    /// Serialized witness stack, item count included; empty for transactions without witness (Bitcoin, Groestlcoin)
+    ByteRange witness;
+
+    /// Previous output tree (Decred)
+    uint8_t tree = 0;
+    /// Witness data (Decred)
+    uint64_t valueIn = 0;
+    uint32_t blockHeight = 0;
+    uint32_t blockIndex = 0;
+
+    /// Returns the items of the witness stack.
+    std::vector<ByteRange> witnessStack() const;
+};
+
+/// View of a transaction output.
+struct OutputView {
+    uint64_t value = 0;
+    /// Script version (Decred)
+    uint16_t scriptVersion = 0;
+    ByteRange script;
+};
+
+/// Zero-copy parser and inspector of raw transactions.  All ranges point into the parsed buffer, which must outlive
+/// the view.  A view can be reused to parse many transactions, keeping the capacity of its input and output lists.
+class TransactionView {
+  public:
+    TransactionFormat format = TransactionFormat::Bitcoin;
+
+    /// Transaction version; Zcash: without the overwintered flag; Decred: without the serialization type
+    uint32_t version = 0;
+    /// Whether the Zcash overwintered flag is set
+    bool overwintered = false;
+    /// Version group id (Zcash)
+    uint32_t versionGroupId = 0;
+    /// Serialization type (Decred): 0 full, 1 prefix only, 2 witness only
+    uint16_t serializeType = 0;
+
+    uint32_t lockTime = 0;
+    /// Expiry height (Zcash, Decred)
+    uint32_t expiry = 0;
+    /// Transparent value balance (Zcash v4)
+    int64_t valueBalance = 0;
+
+    std::vector<InputView> inputs;
+    std::vector<OutputView> outputs;
+
+    /// The whole serialized transaction
+    ByteRange encoded;
+
+    /// Whether witness data was serialized (segwit marker for Bitcoin, witness part for Decred).
+    bool hasWitness() const { return witnessBegin != witnessEnd; }
+
+    /// Parses the transaction at the start of `data`, which may be followed by other bytes.
+    ///
+    /// @returns the size of the transaction.
+    /// @throws std::invalid_argument if the data is not a valid transaction of the format.
+    size_t parse(const byte* data, size_t size, TransactionFormat format);
+
+    /// Transaction id, in hash byte order (reverse for display): the hash of the serialization without witness.
+    ///
+    /// @throws std::logic_error for witness-only Decred transactions.
+    Data txid() const;
+
+    /// Hash of the transaction including witness: Bitcoin wtxid (equal to txid without witness), Decred full hash.
+    ///
+    /// @throws std::logic_error for Decred transactions without prefix or witness.
+    Data wtxid() const;
+
+  private:
+    /// Offset of the data hashed for the txid besides version and lock time (Bitcoin: inputs and outputs;
+    /// Decred: prefix), then offsets of the witness part.
+    size_t bodyBegin = 0;
+    size_t bodyEnd = 0;
+    size_t witnessBegin = 0;
+    size_t witnessEnd = 0;
+};
+
+/// Parses concatenated raw transactions, calling `visitor(const TransactionView&)` for each in order.  A single view
+/// is reused, so after the first few transactions nothing is allocated.
+///
+/// @returns the number of transactions.
+/// @throws std::invalid_argument if some transaction is malformed.
+template <typename Visitor>
+size_t scanTransactions(const byte* data, size_t size, TransactionFormat format, Visitor&& visitor) {
+    TransactionView view;
+    size_t count = 0;
+    size_t offset = 0;
+    while (offset < size) {
+        offset += view.parse(data + offset, size - offset, format);
+        visitor(static_cast<const TransactionView&>(view));
+        ++count;
+    }
+    return count;
+}
+
+/// Returns the ids of concatenated raw transactions.
+std::vector<Data> transactionIds(const byte* data, size_t size, TransactionFormat format);
+
+} // namespace TW::Bitcoin
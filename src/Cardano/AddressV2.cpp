@@ -24,28 +24,28 @@ bool AddressV2::parseAndCheck(const std::string& addr, Data& root_out, Data& att
     if (base58decoded.size() == 0) {
         throw invalid_argument("Invalid address: could not Base58 decode");
     }
-    auto elems = Cbor::Decode(base58decoded).getArrayElements();
-    if (elems.size() < 2) {
+    Cbor::Reader reader(base58decoded);
+    if (reader.readArray() < 2) {
         throw invalid_argument("Could not parse address payload from CBOR data");
     }
-    auto tag = elems[0].getTagValue();
+    auto tag = reader.readTag();
     if (tag != PayloadTag) {
         throw invalid_argument("wrong tag value");
     }
-    Data payload = elems[0].getTagElement().getBytes();
-    uint64_t crcPresent = (uint32_t)elems[1].getValue();
-    uint32_t crcComputed = TW::Crc::crc32(payload);
+    const auto payload = reader.readBytes();
+    uint64_t crcPresent = (uint32_t)reader.readValue();
+    uint32_t crcComputed = TW::Crc::crc32(payload.toData());
     if (crcPresent != crcComputed) {
         throw invalid_argument("CRC mismatch");
     }
     // parse payload, 3 elements
-    auto payloadElems = Cbor::Decode(payload).getArrayElements();
-    if (payloadElems.size() < 3) {
+    Cbor::Reader payloadReader(payload.data, payload.size);
+    if (payloadReader.readArray() < 3) {
         throw invalid_argument("Could not parse address root and attrs from CBOR data");
     }
-    root_out = payloadElems[0].getBytes();
-    attrs_out = payloadElems[1].encoded(); // map, but encoded as bytes
-    type_out = (TW::byte)payloadElems[2].getValue();
+    root_out = payloadReader.readBytes().toData();
+    attrs_out = payloadReader.readEncoded().toData(); // map, but encoded as bytes
+    type_out = (TW::byte)payloadReader.readValue();
     return true;
 }
 
@@ -14,6 +14,35 @@ namespace TW::Cbor {
 
 using namespace std;
 
+namespace {
+
+/// Append types + value, on variable number of bytes (1..8)
+void appendHead(Data& data, byte majorType, uint64_t value) {
+    byte byteCount = 0;
+    byte minorType = 0;
+    if (value < 24) {
+        byteCount = 1;
+        minorType = (byte)value;
+    } else if (value <= 0xFF) {
+        byteCount = 1 + 1;
+        minorType = 24;
+    } else if (value <= 0xFFFF) {
+        byteCount = 1 + 2;
+        minorType = 25;
+    } else if (value <= 0xFFFFFFFF) {
+        byteCount = 1 + 4;
+        minorType = 26;
+    } else {
+        byteCount = 1 + 8;
+        minorType = 27;
+    }
+    data.push_back((byte)((majorType << 5) | (minorType & 0x1F)));
+    for (int i = byteCount - 2; i >= 0; --i) {
+        data.push_back((byte)(value >> (8 * i)));
+    }
+}
+
+} // namespace
 
 TW::Data Encode::encoded() const {
     if (openIndefCount > 0) {
@@ -104,32 +133,7 @@ Encode Encode::fromRaw(const TW::Data& rawData) {
 }
 
 Encode Encode::appendValue(byte majorType, uint64_t value) {
-    byte byteCount = 0;
-    byte minorType = 0;
-    if (value < 24) {
-        byteCount = 1;
-        minorType = (byte)value;
-    } else if (value <= 0xFF) {
-        byteCount = 1 + 1;
-        minorType = 24;
-    } else if (value <= 0xFFFF) {
-        byteCount = 1 + 2;
-        minorType = 25;
-    } else if (value <= 0xFFFFFFFF) {
-        byteCount = 1 + 4;
-        minorType = 26;
-    } else {
-        byteCount = 1 + 8;
-        minorType = 27;
-    }
-    // add bytes
-    TW::append(data, (byte)((majorType << 5) | (minorType & 0x1F)));
-    Data valBytes = Data(byteCount - 1);
-    for (int i = 0; i < valBytes.size(); ++i) {
-        valBytes[valBytes.size() - 1 - i] = (byte)(value & 0xFF);
-        value = value >> 8;
-    }
-    append(valBytes);
+    appendHead(data, majorType, value);
     return *this;
 }
 
@@ -462,4 +466,226 @@ Data Decode::encoded() const
     return TW::data(data->origData.data() + subStart, subLen);
 }
 
+Writer& Writer::uint(uint64_t value) {
+    appendHead(out, Decode::MT_uint, value);
+    return *this;
+}
+
+Writer& Writer::negInt(uint64_t value) {
+    if (value == 0) {
+        // special handling for -1, to avoid underflow
+        return uint(0);
+    }
+    appendHead(out, Decode::MT_negint, value - 1);
+    return *this;
+}
+
+Writer& Writer::string(std::string_view str) {
+    appendHead(out, Decode::MT_string, str.size());
+    out.insert(out.end(), str.begin(), str.end());
+    return *this;
+}
+
+Writer& Writer::bytes(const byte* data, size_t size) {
+    appendHead(out, Decode::MT_bytes, size);
+    out.insert(out.end(), data, data + size);
+    return *this;
+}
+
+Writer& Writer::array(uint64_t count) {
+    appendHead(out, Decode::MT_array, count);
+    return *this;
+}
+
+Writer& Writer::map(uint64_t count) {
+    appendHead(out, Decode::MT_map, count);
+    return *this;
+}
+
+Writer& Writer::tag(uint64_t value) {
+    appendHead(out, Decode::MT_tag, value);
+    return *this;
+}
+
+Writer& Writer::indefArray() {
+    out.push_back((byte)((Decode::MT_array << 5) | 31));
+    return *this;
+}
+
+Writer& Writer::closeIndef() {
+    out.push_back(0xFF);
+    return *this;
+}
+
+Writer& Writer::raw(const Data& encoded) {
+    TW::append(out, encoded);
+    return *this;
+}
+
+
+const byte* Reader::advance(uint64_t count) {
+    if (count > size - pos) {
+        throw std::invalid_argument("CBOR data too short");
+    }
+    const byte* start = data + pos;
+    pos += count;
+    return start;
+}
+
+Reader::Head Reader::readHead() {
+    Head head;
+    const byte first = *advance(1);
+    head.majorType = (Decode::MajorType)(first >> 5);
+    const byte minorType = first & 0x1F;
+    if (minorType < 24) {
+        // direct value
+        head.value = minorType;
+        return head;
+    }
+    if (minorType <= 27) {
+        const int byteCount = 1 << (minorType - 24);
+        const byte* bytes = advance(byteCount);
+        for (int i = 0; i < byteCount; ++i) {
+            head.value = (head.value << 8) | bytes[i];
+        }
+        return head;
+    }
+    if (minorType == 31 && head.majorType != Decode::MT_uint && head.majorType != Decode::MT_negint && head.majorType != Decode::MT_tag) {
+        // indefinite length, or break code
+        head.isIndefinite = true;
+        return head;
+    }
+    throw std::invalid_argument("CBOR unassigned type not supported");
+}
+
+Reader::Head Reader::readHead(Decode::MajorType expectedType) {
+    const auto head = readHead();
+    if (head.majorType != expectedType) {
+        throw std::invalid_argument("CBOR data type mismatch");
+    }
+    return head;
+}
+
+Decode::MajorType Reader::peekType() const {
+    if (atEnd()) {
+        throw std::invalid_argument("CBOR data too short");
+    }
+    return (Decode::MajorType)(data[pos] >> 5);
+}
+
+bool Reader::isBreak() const {
+    return !atEnd() && data[pos] == 0xFF;
+}
+
+void Reader::readBreak() {
+    if (!isBreak()) {
+        throw std::invalid_argument("CBOR break expected");
+    }
+    ++pos;
+}
+
+uint64_t Reader::readUint() {
+    return readHead(Decode::MT_uint).value;
+}
+
+uint64_t Reader::readValue() {
+    const auto head = readHead();
+    if (head.majorType != Decode::MT_uint && head.majorType != Decode::MT_negint) {
+        throw std::invalid_argument("CBOR data type not a value-type");
+    }
+    return head.value;
+}
+
+ByteRange Reader::readBytes() {
+    const auto head = readHead(Decode::MT_bytes);
+    if (head.isIndefinite) {
+        throw std::invalid_argument("CBOR indefinite-length bytes not supported");
+    }
+    return ByteRange{advance(head.value), (size_t)head.value};
+}
+
+std::string_view Reader::readString() {
+    const auto head = readHead(Decode::MT_string);
+    if (head.isIndefinite) {
+        throw std::invalid_argument("CBOR indefinite-length string not supported");
+    }
+    return std::string_view((const char*)advance(head.value), (size_t)head.value);
+}
+
+uint64_t Reader::readArray() {
+    const auto head = readHead(Decode::MT_array);
+    return head.isIndefinite ? indefinite : head.value;
+}
+
+uint64_t Reader::readMap() {
+    const auto head = readHead(Decode::MT_map);
+    return head.isIndefinite ? indefinite : head.value;
+}
+
+uint64_t Reader::readTag() {
+    return readHead(Decode::MT_tag).value;
+}
+
+void Reader::skip() {
+    // Items still to be read at the current level; definite-length items just add their element count.
+    // Indefinite-length items open a new level, ending with a break code; the enclosing counts are saved.
+    uint64_t pending = 1;
+    std::vector<uint64_t> enclosing;
+    while (pending > 0 || !enclosing.empty()) {
+        if (pending == 0) {
+            // inside an indefinite-length item: either a break or another element
+            if (isBreak()) {
+                ++pos;
+                pending = enclosing.back();
+                enclosing.pop_back();
+                continue;
+            }
+            pending = 1;
+        }
+        --pending;
+        const auto head = readHead();
+        switch (head.majorType) {
+            case Decode::MT_uint:
+            case Decode::MT_negint:
+                break;
+
+            case Decode::MT_special:
+                if (head.isIndefinite) {
+                    throw std::invalid_argument("CBOR unexpected break");
+                }
+                break;
+
+            case Decode::MT_bytes:
+            case Decode::MT_string:
+            case Decode::MT_array:
+            case Decode::MT_map:
+                if (head.isIndefinite) {
+                    enclosing.push_back(pending);
+                    pending = 0;
+                } else if (head.majorType == Decode::MT_bytes || head.majorType == Decode::MT_string) {
+                    advance(head.value);
+                } else {
+                    // every element takes at least one byte, this also bounds the count
+                    const uint64_t count = head.value * (head.majorType == Decode::MT_map ? 2 : 1);
+                    if (head.value > size - pos || count > size - pos) {
+                        throw std::invalid_argument("CBOR array data too short");
+                    }
+                    pending += count;
+                }
+                break;
+
+            case Decode::MT_tag:
+            default:
+                ++pending;
+                break;
+        }
+    }
+}
+
+ByteRange Reader::readEncoded() {
+    const size_t start = pos;
+    skip();
+    return ByteRange{data + start, pos - start};
+}
+
 } // namespace TW::Cbor
@@ -9,6 +9,7 @@
 #include "Data.h"
 
 #include <string>
+#include <string_view>
 #include <memory>
 
 namespace TW::Cbor {
@@ -144,4 +145,98 @@ private:
     uint32_t subLen;
 };
 
+/// Streaming CBOR encoder, appending items directly to a caller-provided (reusable) buffer, without building
+/// nested Encode temporaries.  Arrays and maps are written as a header with their element count, followed by
+/// the elements (key, value pairs for maps).
+/// See CborTests.cpp for usage.
+class Writer {
+public:
+    /// Appends to `buffer`; clear it beforehand to reuse its capacity.
+    explicit Writer(Data& buffer) : out(buffer) {}
+
+    /// encode an unsigned int
+    Writer& uint(uint64_t value);
+    /// encode a negative int (positive is given), same as Encode::negInt
+    Writer& negInt(uint64_t value);
+    /// encode a string
+    Writer& string(std::string_view str);
+    /// encode a byte array
+    Writer& bytes(const byte* data, size_t size);
+    Writer& bytes(const Data& data) { return bytes(data.data(), data.size()); }
+    /// start an array of `count` elements, to be written next
+    Writer& array(uint64_t count);
+    /// start a map of `count` key-value pairs, to be written next
+    Writer& map(uint64_t count);
+    /// write a tag, its element is written next
+    Writer& tag(uint64_t value);
+    /// start an indefinite-length array, closed by closeIndef
+    Writer& indefArray();
+    /// close an indefinite-length array
+    Writer& closeIndef();
+    /// append an already encoded item as is
+    Writer& raw(const Data& encoded);
+
+private:
+    Data& out;
+};
+
+/// Zero-copy CBOR pull parser: reads items one after the other from a byte range, without copying the input or
+/// building a tree.  Arrays and maps are walked lazily: read the header, then read (or skip) that many elements
+/// (twice as many for maps), or until isBreak() for indefinite lengths.  Returned views point into the input,
+/// which must outlive them.
+/// See CborTests.cpp for usage.
+class Reader {
+public:
+    /// Element count returned for indefinite-length arrays and maps
+    static constexpr uint64_t indefinite = UINT64_MAX;
+
+    Reader(const byte* data, size_t size) : data(data), size(size) {}
+    explicit Reader(const Data& data) : Reader(data.data(), data.size()) {}
+    explicit Reader(Data&& data) = delete;
+
+    bool atEnd() const { return pos == size; }
+    /// Offset of the next item
+    size_t position() const { return pos; }
+    /// Type of the next item, without consuming it
+    Decode::MajorType peekType() const;
+    /// Check if the next item is the break code, ending an indefinite-length item
+    bool isBreak() const;
+    /// Consume a break code
+    void readBreak();
+
+    uint64_t readUint();
+    /// Read an unsigned or negative int, as Decode::getValue (magnitude - 1 for negative)
+    uint64_t readValue();
+    /// Read a definite-length byte string, without copying
+    ByteRange readBytes();
+    /// Read a definite-length text string, without copying
+    std::string_view readString();
+    /// Read an array header, return the element count or `indefinite`
+    uint64_t readArray();
+    /// Read a map header, return the number of key-value pairs or `indefinite`
+    uint64_t readMap();
+    /// Read a tag, return the tag number; the tagged element is the next item
+    uint64_t readTag();
+    /// Skip the next item including all nested items, iteratively
+    void skip();
+    /// Skip the next item and return its encoded form (e.g. for parsed out sub-parts)
+    ByteRange readEncoded();
+
+private:
+    struct Head {
+        Decode::MajorType majorType = Decode::MT_uint;
+        uint64_t value = 0;
+        bool isIndefinite = false;
+    };
+    /// Parse the type byte and value of the next item, advancing past them
+    Head readHead();
+    Head readHead(Decode::MajorType expectedType);
+    /// Advance past `count` content bytes
+    const byte* advance(uint64_t count);
+
+    const byte* data;
+    size_t size;
+    size_t pos = 0;
+};
+
 } // namespace TW::Cbor
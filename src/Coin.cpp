@@ -10,7 +10,10 @@
 #include <TrustWalletCore/TWCoinTypeConfiguration.h>
 #include <TrustWalletCore/TWHRP.h>
 
+#include <algorithm>
 #include <map>
+#include <numeric>
+#include <thread>
 
 // #coin-list# Includes for entry points for coin implementations
 #include "Aeternity/Entry.h"
@@ -97,7 +100,8 @@ Zcash::Entry zcashDP;
 Zilliqa::Entry zilliqaDP;
 // end_of_coin_dipatcher_declarations_marker_do_not_modify
 
-CoinEntry* coinDispatcher(TWCoinType coinType) {
+/// Entry of a coin, or nullptr for unknown or unsupported coin ids
+CoinEntry* findCoinDispatcher(TWCoinType coinType) {
     // switch is preferred instead of a data structure, due to initialization issues
     CoinEntry* entry = nullptr;
     switch (coinType) {
@@ -170,10 +174,19 @@ CoinEntry* coinDispatcher(TWCoinType coinType) {
 
         default: entry = nullptr; break;
     }
+    return entry;
+}
+
+CoinEntry* coinDispatcher(TWCoinType coinType) {
+    auto* entry = findCoinDispatcher(coinType);
     assert(entry != nullptr);
     return entry;
 }
 
+bool TW::isCoinSupported(TWCoinType coin) {
+    return findCoinDispatcher(coin) != nullptr;
+}
+
 bool TW::validateAddress(TWCoinType coin, const std::string& string) {
     auto p2pkh = TW::p2pkhPrefix(coin);
     auto p2sh = TW::p2shPrefix(coin);
@@ -185,6 +198,62 @@ bool TW::validateAddress(TWCoinType coin, const std::string& string) {
     return dispatcher->validateAddress(coin, string, p2pkh, p2sh, hrp);
 }
 
+std::vector<bool> TW::validateAddresses(const std::vector<std::pair<TWCoinType, std::string>>& addresses, unsigned threads) {
+    // visit items grouped by coin, so that coin parameters are looked up once per coin
+    std::vector<size_t> order(addresses.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&addresses](size_t lhs, size_t rhs) {
+        return addresses[lhs].first < addresses[rhs].first;
+    });
+
+    // one byte per item, so that workers never share a written word
+    Data valid(addresses.size(), 0);
+    const auto validateRange = [&](size_t begin, size_t end) {
+        const CoinEntry* dispatcher = nullptr;
+        bool resolved = false;
+        TWCoinType coin = TWCoinTypeBitcoin;
+        byte p2pkh = 0;
+        byte p2sh = 0;
+        const char* hrp = nullptr;
+        for (size_t i = begin; i < end; ++i) {
+            const auto& item = addresses[order[i]];
+            if (!resolved || item.first != coin) {
+                resolved = true;
+                coin = item.first;
+                dispatcher = findCoinDispatcher(coin);
+                if (dispatcher != nullptr) {
+                    p2pkh = TW::p2pkhPrefix(coin);
+                    p2sh = TW::p2shPrefix(coin);
+                    hrp = stringForHRP(TW::hrp(coin));
+                }
+            }
+            // unknown or unsupported coin ids come from untrusted input; their addresses are invalid
+            if (dispatcher != nullptr) {
+                valid[order[i]] = dispatcher->validateAddress(coin, item.second, p2pkh, p2sh, hrp);
+            }
+        }
+    };
+
+    // not worth a thread below this many items
+    const size_t minItemsPerThread = 256;
+    // the requested thread count comes from untrusted input, never exceed the hardware
+    const size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const auto workers = std::min<size_t>({threads, hardwareThreads, addresses.size() / minItemsPerThread});
+    if (workers <= 1) {
+        validateRange(0, addresses.size());
+    } else {
+        std::vector<std::thread> pool;
+        const auto chunk = (addresses.size() + workers - 1) / workers;
+        for (size_t begin = 0; begin < addresses.size(); begin += chunk) {
+            pool.emplace_back(validateRange, begin, std::min(begin + chunk, addresses.size()));
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+    return std::vector<bool>(valid.begin(), valid.end());
+}
+
 std::string TW::normalizeAddress(TWCoinType coin, const std::string& address) {
     if (!TW::validateAddress(coin, address)) {
         // invalid address, not normalizing
@@ -238,7 +307,9 @@ void TW::anyCoinPlan(TWCoinType coinType, const Data& dataIn, Data& dataOut) {
 
 // Coin info accessors
 
-extern const CoinInfo getCoinInfo(TWCoinType coin); // in generated CoinInfoData.cpp file
+// in generated CoinInfoData.cpp file
+extern const CoinInfo& getCoinInfo(TWCoinType coin);
+extern const DerivationPath& getCoinDerivationPath(TWCoinType coin);
 
 TWBlockchain TW::blockchain(TWCoinType coin) {
     return getCoinInfo(coin).blockchain;
@@ -260,8 +331,8 @@ TWHDVersion TW::xprvVersion(TWCoinType coin) {
     return getCoinInfo(coin).xprvVersion;
 }
 
-DerivationPath TW::derivationPath(TWCoinType coin) {
-    return DerivationPath(getCoinInfo(coin).derivationPath);
+const DerivationPath& TW::derivationPath(TWCoinType coin) {
+    return getCoinDerivationPath(coin);
 }
 
 enum TWPublicKeyType TW::publicKeyType(TWCoinType coin) {
@@ -284,11 +355,11 @@ enum TWHRP TW::hrp(TWCoinType coin) {
     return getCoinInfo(coin).hrp;
 }
 
-Hash::Hasher TW::publicKeyHasher(TWCoinType coin) {
+Hash::HasherSimpleType TW::publicKeyHasher(TWCoinType coin) {
     return getCoinInfo(coin).publicKeyHasher;
 }
 
-Hash::Hasher TW::base58Hasher(TWCoinType coin) {
+Hash::HasherSimpleType TW::base58Hasher(TWCoinType coin) {
     return getCoinInfo(coin).base58Hasher;
 }
 
@@ -26,9 +26,18 @@ namespace TW {
 // Return the set of supported coin types.
 std::vector<TWCoinType> getCoinTypes();
 
+/// Whether a coin id is supported by this build, i.e. it can be dispatched to a blockchain implementation.
+bool isCoinSupported(TWCoinType coin);
+
 /// Validates an address for a particular coin.
 bool validateAddress(TWCoinType coin, const std::string& address);
 
+/// Validates many (coin, address) pairs.  Items are grouped by coin so coin parameters and
+/// dispatch are resolved once per coin; with `threads` > 1 the work is split across worker threads, at most
+/// one per hardware thread.
+/// \returns one flag per item, in input order.
+std::vector<bool> validateAddresses(const std::vector<std::pair<TWCoinType, std::string>>& addresses, unsigned threads = 1);
+
 /// Validates and normalizes an address for a particular coin.
 std::string normalizeAddress(TWCoinType coin, const std::string& address);
 
@@ -47,8 +56,8 @@ TWHDVersion xpubVersion(TWCoinType coin);
 /// Returns the xprv HD version that should be used for a coin type.
 TWHDVersion xprvVersion(TWCoinType coin);
 
-/// Returns the default derivation path for a particular coin.
-DerivationPath derivationPath(TWCoinType coin);
+/// Returns the default derivation path for a particular coin, parsed once per coin.
+const DerivationPath& derivationPath(TWCoinType coin);
 
 /// Returns the public key type for a particular coin.
 enum TWPublicKeyType publicKeyType(TWCoinType coin);
@@ -60,10 +69,10 @@ std::string deriveAddress(TWCoinType coin, const PrivateKey& privateKey);
 std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey);
 
 /// Hasher for deriving the public key hash.
-Hash::Hasher publicKeyHasher(TWCoinType coin);
+Hash::HasherSimpleType publicKeyHasher(TWCoinType coin);
 
 /// Hasher to use for base 58 checksums.
-Hash::Hasher base58Hasher(TWCoinType coin);
+Hash::HasherSimpleType base58Hasher(TWCoinType coin);
 
 /// Returns static prefix for a coin type.
 byte staticPrefix(TWCoinType coin);
@@ -91,7 +100,7 @@ void anyCoinPlan(TWCoinType coinType, const Data& dataIn, Data& dataOut);
 // Return coins handled by the same dispatcher as the given coin (mostly for testing)
 const std::vector<TWCoinType> getSimilarCoinTypes(TWCoinType coinType);
 
-// Contains only simple types.
+// Contains only simple types, so that entries can be compile-time constants.
 struct CoinInfo {
     const char* id;
     const char* name;
@@ -106,8 +115,8 @@ struct CoinInfo {
     byte p2pkhPrefix;
     byte p2shPrefix;
     TWHRP hrp;
-    Hash::Hasher publicKeyHasher;
-    Hash::Hasher base58Hasher;
+    Hash::HasherSimpleType publicKeyHasher;
+    Hash::HasherSimpleType base58Hasher;
     const char* symbol;
     int decimals;
     const char* explorerTransactionUrl;
@@ -9,13 +9,17 @@
 #include "../Cosmos/Address.h"
 #include "../proto/Cosmos.pb.h"
 #include "Base64.h"
+#include "JSONWriter.h"
 #include "PrivateKey.h"
 
+#include <nlohmann/json.hpp>
+
 using namespace TW;
 using namespace TW::Cosmos;
 
 using json = nlohmann::json;
 using string = std::string;
+using Writer = JSONWriter;
 
 const string TYPE_PREFIX_MSG_SEND = "cosmos-sdk/MsgSend";
 const string TYPE_PREFIX_MSG_DELEGATE = "cosmos-sdk/MsgDelegate";
@@ -34,163 +38,185 @@ static string broadcastMode(Proto::BroadcastMode mode) {
     }
 }
 
-static json broadcastJSON(json& j, Proto::BroadcastMode mode) {
-    return {
-        {"tx", j},
-        {"mode", broadcastMode(mode)}
-    };
-}
+// Object keys are written in sorted order, see JSONWriter.
 
-static json amountJSON(const Proto::Amount& amount) {
-    return {
-        {"amount", std::to_string(amount.amount())},
-        {"denom", amount.denom()}
-    };
+static void amountJSON(Writer& w, const Proto::Amount& amount) {
+    w.beginObject();
+    w.field("amount", std::to_string(amount.amount()));
+    w.field("denom", amount.denom());
+    w.endObject();
 }
 
-static json amountsJSON(const ::google::protobuf::RepeatedPtrField<Proto::Amount>& amounts) {
-    json j = json::array();
+static void amountsJSON(Writer& w, const ::google::protobuf::RepeatedPtrField<Proto::Amount>& amounts) {
+    w.beginArray();
     for (auto& amount : amounts) {
-        j.push_back(amountJSON(amount));
+        amountJSON(w, amount);
     }
-    return j;
+    w.endArray();
 }
 
-static json feeJSON(const Proto::Fee& fee) {
-    json js = json::array();
-
-    for (auto& amount : fee.amounts()) {
-        js.push_back(amountJSON(amount));
-    }
-
-    return {
-        {"amount", js},
-        {"gas", std::to_string(fee.gas())}
-    };
+static void feeJSON(Writer& w, const Proto::Fee& fee) {
+    w.beginObject();
+    w.key("amount");
+    amountsJSON(w, fee.amounts());
+    w.field("gas", std::to_string(fee.gas()));
+    w.endObject();
 }
 
-static json messageSend(const Proto::Message_Send& message) {
-    auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_SEND : message.type_prefix();
-
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountsJSON(message.amounts())},
-            {"from_address", message.from_address()},
-            {"to_address", message.to_address()}
-        }}
-    };
+static void messageSend(Writer& w, const Proto::Message_Send& message) {
+    const auto& typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_SEND : message.type_prefix();
+
+    w.beginObject();
+    w.field("type", typePrefix);
+    w.key("value");
+    w.beginObject();
+    w.key("amount");
+    amountsJSON(w, message.amounts());
+    w.field("from_address", message.from_address());
+    w.field("to_address", message.to_address());
+    w.endObject();
+    w.endObject();
 }
 
-static json messageDelegate(const Proto::Message_Delegate& message) {
-    auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_DELEGATE : message.type_prefix();
-
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountJSON(message.amount())},
-            {"delegator_address", message.delegator_address()},
-            {"validator_address", message.validator_address()}
-        }}
-    };
+static void messageDelegate(Writer& w, const Proto::Message_Delegate& message) {
+    const auto& typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_DELEGATE : message.type_prefix();
+
+    w.beginObject();
+    w.field("type", typePrefix);
+    w.key("value");
+    w.beginObject();
+    w.key("amount");
+    amountJSON(w, message.amount());
+    w.field("delegator_address", message.delegator_address());
+    w.field("validator_address", message.validator_address());
+    w.endObject();
+    w.endObject();
 }
 
-static json messageUndelegate(const Proto::Message_Undelegate& message) {
-    auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_UNDELEGATE : message.type_prefix();
-
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountJSON(message.amount())},
-            {"delegator_address", message.delegator_address()},
-            {"validator_address", message.validator_address()}
-        }}
-    };
+static void messageUndelegate(Writer& w, const Proto::Message_Undelegate& message) {
+    const auto& typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_UNDELEGATE : message.type_prefix();
+
+    w.beginObject();
+    w.field("type", typePrefix);
+    w.key("value");
+    w.beginObject();
+    w.key("amount");
+    amountJSON(w, message.amount());
+    w.field("delegator_address", message.delegator_address());
+    w.field("validator_address", message.validator_address());
+    w.endObject();
+    w.endObject();
 }
 
-static json messageRedelegate(const Proto::Message_BeginRedelegate& message) {
-    auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_REDELEGATE : message.type_prefix();
-
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountJSON(message.amount())},
-            {"delegator_address", message.delegator_address()},
-            {"validator_src_address", message.validator_src_address()},
-            {"validator_dst_address", message.validator_dst_address()},
-        }}
-    };
+static void messageRedelegate(Writer& w, const Proto::Message_BeginRedelegate& message) {
+    const auto& typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_REDELEGATE : message.type_prefix();
+
+    w.beginObject();
+    w.field("type", typePrefix);
+    w.key("value");
+    w.beginObject();
+    w.key("amount");
+    amountJSON(w, message.amount());
+    w.field("delegator_address", message.delegator_address());
+    w.field("validator_dst_address", message.validator_dst_address());
+    w.field("validator_src_address", message.validator_src_address());
+    w.endObject();
+    w.endObject();
 }
 
-static json messageWithdrawReward(const Proto::Message_WithdrawDelegationReward& message) {
-    auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_WITHDRAW_REWARD : message.type_prefix();
-
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"delegator_address", message.delegator_address()},
-            {"validator_address", message.validator_address()}
-        }}
-    };
+static void messageWithdrawReward(Writer& w, const Proto::Message_WithdrawDelegationReward& message) {
+    const auto& typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_WITHDRAW_REWARD : message.type_prefix();
+
+    w.beginObject();
+    w.field("type", typePrefix);
+    w.key("value");
+    w.beginObject();
+    w.field("delegator_address", message.delegator_address());
+    w.field("validator_address", message.validator_address());
+    w.endObject();
+    w.endObject();
 }
 
-static json messageRawJSON(const Proto::Message_RawJSON& message) {
-    return {
-        {"type", message.type()},
-        {"value", json::parse(message.value())},
-    };
+static void messageRawJSON(Writer& w, const Proto::Message_RawJSON& message) {
+    w.beginObject();
+    w.field("type", message.type());
+    // re-serialized, for sorted keys and compact form
+    w.key("value");
+    w.raw(json::parse(message.value()).dump());
+    w.endObject();
 }
-static json messagesJSON(const Proto::SigningInput& input) {
-    json j = json::array();
+
+static void messagesJSON(Writer& w, const Proto::SigningInput& input) {
+    w.beginArray();
     for (auto& msg : input.messages()) {
         if (msg.has_send_coins_message()) {
-            j.push_back(messageSend(msg.send_coins_message()));
+            messageSend(w, msg.send_coins_message());
         } else if (msg.has_stake_message()) {
-            j.push_back(messageDelegate(msg.stake_message()));
+            messageDelegate(w, msg.stake_message());
         } else if (msg.has_unstake_message()) {
-            j.push_back(messageUndelegate(msg.unstake_message()));
+            messageUndelegate(w, msg.unstake_message());
         } else if (msg.has_withdraw_stake_reward_message()) {
-            j.push_back(messageWithdrawReward(msg.withdraw_stake_reward_message()));
+            messageWithdrawReward(w, msg.withdraw_stake_reward_message());
         } else if (msg.has_restake_message()) {
-            j.push_back(messageRedelegate(msg.restake_message()));
+            messageRedelegate(w, msg.restake_message());
         } else if (msg.has_raw_json_message()) {
-            j.push_back(messageRawJSON(msg.raw_json_message()));
+            messageRawJSON(w, msg.raw_json_message());
         }
     }
-    return j;
+    w.endArray();
 }
 
-static json signatureJSON(const Data& signature, const Data& pubkey) {
-    return {
-        {"pub_key", {
-            {"type", TYPE_PREFIX_PUBLIC_KEY},
-            {"value", Base64::encode(pubkey)}
-        }},
-        {"signature", Base64::encode(signature)}
-    };
+static void signatureJSON(Writer& w, const Data& signature, const Data& pubkey) {
+    w.beginObject();
+    w.key("pub_key");
+    w.beginObject();
+    w.field("type", TYPE_PREFIX_PUBLIC_KEY);
+    w.field("value", Base64::encode(pubkey));
+    w.endObject();
+    w.field("signature", Base64::encode(signature));
+    w.endObject();
 }
 
-json Cosmos::signaturePreimage(const Proto::SigningInput& input) {
-    return {
-        {"account_number", std::to_string(input.account_number())},
-        {"chain_id", input.chain_id()},
-        {"fee", feeJSON(input.fee())},
-        {"memo", input.memo()},
-        {"msgs", messagesJSON(input)},
-        {"sequence", std::to_string(input.sequence())}
-    };
+void Cosmos::signaturePreimage(const Proto::SigningInput& input, string& buffer) {
+    Writer w(buffer);
+    w.beginObject();
+    w.field("account_number", std::to_string(input.account_number()));
+    w.field("chain_id", input.chain_id());
+    w.key("fee");
+    feeJSON(w, input.fee());
+    w.field("memo", input.memo());
+    w.key("msgs");
+    messagesJSON(w, input);
+    w.field("sequence", std::to_string(input.sequence()));
+    w.endObject();
 }
 
-json Cosmos::transactionJSON(const Proto::SigningInput& input, const Data& signature) {
+string Cosmos::signaturePreimage(const Proto::SigningInput& input) {
+    string buffer;
+    signaturePreimage(input, buffer);
+    return buffer;
+}
+
+string Cosmos::transactionJSON(const Proto::SigningInput& input, const Data& signature) {
     auto privateKey = PrivateKey(input.private_key());
     auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1);
-    json tx = {
-        {"fee", feeJSON(input.fee())},
-        {"memo", input.memo()},
-        {"msg", messagesJSON(input)},
-        {"signatures", json::array({
-            signatureJSON(signature, Data(publicKey.bytes))
-        })}
-    };
-    return broadcastJSON(tx, input.mode());
+
+    string buffer;
+    Writer w(buffer);
+    w.beginObject();
+    w.field("mode", broadcastMode(input.mode()));
+    w.key("tx");
+    w.beginObject();
+    w.key("fee");
+    feeJSON(w, input.fee());
+    w.field("memo", input.memo());
+    w.key("msg");
+    messagesJSON(w, input);
+    w.key("signatures");
+    w.beginArray();
+    signatureJSON(w, signature, Data(publicKey.bytes));
+    w.endArray();
+    w.endObject();
+    w.endObject();
+    return buffer;
 }
@@ -8,10 +8,10 @@
 
 #include "../proto/Cosmos.pb.h"
 #include "Data.h"
-#include <nlohmann/json.hpp>
+
+#include <string>
 
 using string = std::string;
-using json = nlohmann::json;
 
 extern const string TYPE_PREFIX_MSG_SEND;
 extern const string TYPE_PREFIX_MSG_DELEGATE;
@@ -22,7 +22,13 @@ extern const string TYPE_PREFIX_PUBLIC_KEY;
 
 namespace TW::Cosmos {
 
-json signaturePreimage(const Proto::SigningInput& input);
-json transactionJSON(const Proto::SigningInput& input, const Data& signature);
+/// Canonical (sorted, compact) JSON document to sign.
+string signaturePreimage(const Proto::SigningInput& input);
+
+/// Appends the canonical JSON document to sign to `buffer`.
+void signaturePreimage(const Proto::SigningInput& input, string& buffer);
+
+/// Signed transaction JSON, in broadcast form.
+string transactionJSON(const Proto::SigningInput& input, const Data& signature);
 
 } // namespace
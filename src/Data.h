@@ -36,6 +36,14 @@ inline void append(Data& data, const byte suffix) {
     data.push_back(suffix);
 }
 
+/// Non-owning reference to a range of bytes inside a buffer, which must outlive it.
+struct ByteRange {
+    const byte* data = nullptr;
+    size_t size = 0;
+
+    Data toData() const { return Data(data, data + size); }
+};
+
 /// Return a part (subdata) of the requested size of the input data.
 Data subData(const Data& data, size_t index, size_t length);
 
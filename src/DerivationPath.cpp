@@ -6,7 +6,6 @@
 
 #include "DerivationPath.h"
 
-#include <cstdio>
 #include <stdexcept>
 
 using namespace TW;
@@ -23,11 +22,15 @@ DerivationPath::DerivationPath(const std::string& string) {
     }
 
     while (it != end) {
-        uint32_t value;
-        if (std::sscanf(it, "%ud", &value) != 1) {
+        if (*it < '0' || *it > '9') {
             throw std::invalid_argument("Invalid component");
         }
-        while (it != end && isdigit(*it)) {
+        uint64_t value = 0;
+        while (it != end && *it >= '0' && *it <= '9') {
+            value = value * 10 + static_cast<uint64_t>(*it - '0');
+            if (value > UINT32_MAX) {
+                throw std::invalid_argument("Invalid component");
+            }
             ++it;
         }
 
@@ -35,7 +38,7 @@ DerivationPath::DerivationPath(const std::string& string) {
         if (hardened) {
             ++it;
         }
-        indices.emplace_back(value, hardened);
+        indices.emplace_back(static_cast<uint32_t>(value), hardened);
 
         if (it == end) {
             break;
@@ -58,3 +61,59 @@ std::string DerivationPath::string() const noexcept {
     }
     return result;
 }
+
+bool DerivationPath::startsWith(const DerivationPath& other) const {
+    return other.indices.size() <= indices.size() &&
+           std::equal(other.indices.begin(), other.indices.end(), indices.begin());
+}
+
+size_t TW::commonPrefixLength(const DerivationPath& lhs, const DerivationPath& rhs) {
+    const auto length = std::min(lhs.indices.size(), rhs.indices.size());
+    size_t i = 0;
+    while (i < length && lhs.indices[i] == rhs.indices[i]) {
+        ++i;
+    }
+    return i;
+}
+
+DerivationPath DerivationPathCache::get(const std::string& string) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto found = index.find(string);
+        if (found != index.end()) {
+            entries.splice(entries.begin(), entries, found->second);
+            return found->second->second;
+        }
+    }
+    // parse outside of the lock
+    auto path = DerivationPath(string);
+    if (capacity == 0) {
+        return path;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index.find(string) == index.end()) {
+        entries.emplace_front(string, path);
+        index.emplace(string, entries.begin());
+        if (entries.size() > capacity) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+    return path;
+}
+
+size_t DerivationPathCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void DerivationPathCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+}
+
+DerivationPath TW::cachedDerivationPath(const std::string& string) {
+    static DerivationPathCache cache(256);
+    return cache.get(string);
+}
@@ -9,9 +9,14 @@
 #include <TrustWalletCore/TWCoinType.h>
 #include <TrustWalletCore/TWPurpose.h>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <initializer_list>
+#include <list>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TW {
@@ -41,9 +46,106 @@ struct DerivationPathIndex {
     }
 };
 
+/// Sequence of derivation path indices, stored inline up to `inlineCapacity` entries (deeper paths spill to the heap),
+/// so the usual BIP44-style paths are built, copied and parsed without allocating.
+class DerivationPathIndices {
+  public:
+    static constexpr size_t inlineCapacity = 8;
+
+    using value_type = DerivationPathIndex;
+    using iterator = DerivationPathIndex*;
+    using const_iterator = const DerivationPathIndex*;
+
+    DerivationPathIndices() = default;
+    DerivationPathIndices(std::initializer_list<DerivationPathIndex> l) : DerivationPathIndices(l.begin(), l.end()) {}
+    DerivationPathIndices(const std::vector<DerivationPathIndex>& v) : DerivationPathIndices(v.data(), v.data() + v.size()) {}
+    DerivationPathIndices(const DerivationPathIndex* first, const DerivationPathIndex* last) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+    /// Creates `count` default (hardened 0) indices.
+    explicit DerivationPathIndices(size_t count) { resize(count); }
+
+    DerivationPathIndices(const DerivationPathIndices& other) = default;
+    DerivationPathIndices& operator=(const DerivationPathIndices& other) = default;
+    DerivationPathIndices(DerivationPathIndices&& other) noexcept
+        : count(other.count), local(other.local), spilled(std::move(other.spilled)) {
+        other.count = 0;
+    }
+    DerivationPathIndices& operator=(DerivationPathIndices&& other) noexcept {
+        count = other.count;
+        local = other.local;
+        spilled = std::move(other.spilled);
+        other.count = 0;
+        return *this;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    DerivationPathIndex* data() { return count > inlineCapacity ? spilled.data() : local.data(); }
+    const DerivationPathIndex* data() const { return count > inlineCapacity ? spilled.data() : local.data(); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + count; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + count; }
+
+    DerivationPathIndex& operator[](size_t i) { return data()[i]; }
+    const DerivationPathIndex& operator[](size_t i) const { return data()[i]; }
+    DerivationPathIndex& back() { return data()[count - 1]; }
+    const DerivationPathIndex& back() const { return data()[count - 1]; }
+
+    void push_back(const DerivationPathIndex& index) {
+        if (count < inlineCapacity) {
+            local[count] = index;
+        } else {
+            if (count == inlineCapacity) {
+                spilled.assign(local.begin(), local.end());
+            }
+            spilled.push_back(index);
+        }
+        ++count;
+    }
+
+    template <typename... Args>
+    DerivationPathIndex& emplace_back(Args&&... args) {
+        push_back(DerivationPathIndex(std::forward<Args>(args)...));
+        return back();
+    }
+
+    void pop_back() { resize(count - 1); }
+
+    void resize(size_t newCount) {
+        if (newCount > inlineCapacity) {
+            if (count <= inlineCapacity) {
+                spilled.assign(local.begin(), local.begin() + count);
+            }
+            spilled.resize(newCount);
+        } else {
+            if (count > inlineCapacity) {
+                std::copy(spilled.begin(), spilled.begin() + newCount, local.begin());
+                spilled.clear();
+            } else if (newCount > count) {
+                std::fill(local.begin() + count, local.begin() + newCount, DerivationPathIndex());
+            }
+        }
+        count = newCount;
+    }
+
+    void clear() { resize(0); }
+
+  private:
+    size_t count = 0;
+    std::array<DerivationPathIndex, inlineCapacity> local;
+    /// all indices, used instead of `local` once there are more than `inlineCapacity`
+    std::vector<DerivationPathIndex> spilled;
+};
+
 /// A BIP32 HD wallet derivation path.
 struct DerivationPath {
-    std::vector<DerivationPathIndex> indices;
+    DerivationPathIndices indices;
 
     TWPurpose purpose() const {
         if (indices.size() == 0) { return TWPurposeBIP44; }
@@ -97,12 +199,12 @@ struct DerivationPath {
 
     DerivationPath() = default;
     explicit DerivationPath(std::initializer_list<DerivationPathIndex> l) : indices(l) {}
-    explicit DerivationPath(std::vector<DerivationPathIndex> indices) : indices(std::move(indices)) {}
+    explicit DerivationPath(const std::vector<DerivationPathIndex>& indices) : indices(indices) {}
 
     /// Creates a `DerivationPath` by BIP44 components.
     DerivationPath(TWPurpose purpose, uint32_t coin, uint32_t account, uint32_t change,
                    uint32_t address) 
-    : indices(std::vector<DerivationPathIndex>(5)) {
+    : indices(5) {
         setPurpose(purpose);
         setCoin(coin);
         setAccount(account);
@@ -118,8 +220,47 @@ struct DerivationPath {
 
     /// String representation.
     std::string string() const noexcept;
+
+    /// Returns the path made of the first `depth` indices (the whole path if it is shorter).
+    DerivationPath prefix(size_t depth) const {
+        DerivationPath result;
+        result.indices = DerivationPathIndices(indices.begin(), indices.begin() + std::min(depth, indices.size()));
+        return result;
+    }
+
+    /// Whether `other` is an ancestor of (or equal to) this path.
+    bool startsWith(const DerivationPath& other) const;
 };
 
+/// Returns the number of leading indices two paths have in common, i.e. the depth of their closest common ancestor.
+size_t commonPrefixLength(const DerivationPath& lhs, const DerivationPath& rhs);
+
+/// Bounded cache of parsed derivation path strings, evicting the least recently used.  Thread-safe.
+class DerivationPathCache {
+  public:
+    explicit DerivationPathCache(size_t capacity) : capacity(capacity) {}
+
+    /// Returns the parsed path, same as `DerivationPath(string)`.
+    ///
+    /// @throws std::invalid_argument if the string is not a valid derivation path; invalid strings are not cached.
+    DerivationPath get(const std::string& string);
+
+    size_t size() const;
+    void clear();
+
+  private:
+    using Entry = std::pair<std::string, DerivationPath>;
+
+    const size_t capacity;
+    mutable std::mutex mutex;
+    /// most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+};
+
+/// Parses a derivation path string through a process-wide `DerivationPathCache`.
+DerivationPath cachedDerivationPath(const std::string& string);
+
 inline bool operator==(const DerivationPathIndex& lhs, const DerivationPathIndex& rhs) {
     return lhs.value == rhs.value && lhs.hardened == rhs.hardened;
 }
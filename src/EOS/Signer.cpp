@@ -73,21 +73,40 @@ void Signer::sign(const PrivateKey& privateKey, Type type, Transaction& transact
         throw std::invalid_argument("Invalid transaction!");
     }
 
-    // values for Legacy and ModernK1
-    TWCurve curve = TWCurveSECP256k1;
-    auto canonicalChecker = isCanonical;
-
     //  Values for ModernR1
     if (type == Type::ModernR1) {
-        curve = TWCurveNIST256p1;
-        canonicalChecker = nullptr;
+        const Data result = privateKey.sign(hash(transaction), TWCurveNIST256p1, nullptr);
+        transaction.signatures.push_back(Signature(result, type));
+        return;
     }
 
-    const Data result = privateKey.sign(hash(transaction), curve, canonicalChecker);
-
+    // values for Legacy and ModernK1
+    const Data result = privateKey.signCanonical(hash(transaction), TWCurveSECP256k1);
     transaction.signatures.push_back(Signature(result, type));
 }
 
+void Signer::sign(const PrivateKey& privateKey, Type type, std::vector<Transaction>& transactions) const {
+    if (type == Type::ModernR1) {
+        for (auto& transaction : transactions) {
+            sign(privateKey, type, transaction);
+        }
+        return;
+    }
+
+    std::vector<Data> hashes;
+    hashes.reserve(transactions.size());
+    for (auto& transaction : transactions) {
+        if (!transaction.isValid()) {
+            throw std::invalid_argument("Invalid transaction!");
+        }
+        hashes.push_back(hash(transaction));
+    }
+    const auto signatures = privateKey.signCanonical(hashes, TWCurveSECP256k1);
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        transactions[i].signatures.push_back(Signature(signatures[i], type));
+    }
+}
+
 TW::Data Signer::hash(const Transaction& transaction) const noexcept {
     Data hashInput(chainID);
     transaction.serialize(hashInput);
@@ -103,8 +122,5 @@ TW::Data Signer::hash(const Transaction& transaction) const noexcept {
 
 // canonical check for EOS
 int Signer::isCanonical(uint8_t by, uint8_t sig[64]) {
-    return !(sig[0] & 0x80) 
-        && !(sig[0] == 0 && !(sig[1] & 0x80))
-        && !(sig[32] & 0x80)
-        && !(sig[32] == 0 && !(sig[33] & 0x80));
+    return PrivateKey::isCanonical(sig);
 }
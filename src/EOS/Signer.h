@@ -14,6 +14,7 @@
 #include "../proto/EOS.pb.h"
 
 #include <stdexcept>
+#include <vector>
 
 namespace TW::EOS {
 
@@ -32,6 +33,9 @@ class Signer {
     /// Signs the given transaction.
     void sign(const PrivateKey& privateKey, Type type, Transaction& transaction) const;
 
+    /// Signs many transactions with one key; secp256k1 signatures share the parsed key.
+    void sign(const PrivateKey& privateKey, Type type, std::vector<Transaction>& transactions) const;
+
     /// Computes the transaction hash.
     Data hash(const Transaction& transaction) const noexcept;
 
@@ -0,0 +1,362 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TypedData.h"
+#include "ValueEncoder.h"
+
+#include <Hash.h>
+#include <HexCoding.h>
+#include <uint256.h>
+
+#include <TrezorCrypto/sha3.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <set>
+#include <stdexcept>
+
+namespace TW::Ethereum::ABI {
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr size_t wordSize = ValueEncoder::encodedIntSize;
+
+void keccak(const byte* data, size_t size, byte* out) {
+    keccak_256(data, size, out);
+}
+
+void writeUInt256(uint256_t value, byte* out) {
+    for (auto i = wordSize; i-- > 0;) {
+        out[i] = static_cast<byte>(static_cast<unsigned>(value & 0xff));
+        value >>= 8;
+    }
+}
+
+/// Parses a number given as a JSON number, a decimal string, or a 0x-prefixed hex string
+template <typename Number>
+Number parseNumber(const json& value) {
+    if (value.is_number_unsigned()) {
+        return Number(value.get<uint64_t>());
+    }
+    constexpr bool isSigned = std::numeric_limits<Number>::is_signed;
+    if (value.is_number_integer() && isSigned) {
+        return Number(value.get<int64_t>());
+    }
+    if (value.is_string() && !value.get_ref<const std::string&>().empty() &&
+        (isSigned || value.get_ref<const std::string&>()[0] != '-')) {
+        try {
+            return Number(value.get_ref<const std::string&>());
+        } catch (const std::exception&) {
+        }
+    }
+    throw std::invalid_argument("Invalid number");
+}
+
+Data parseHexValue(const json& value) {
+    if (!value.is_string()) {
+        throw std::invalid_argument("Invalid hex value");
+    }
+    const auto& string = value.get_ref<const std::string&>();
+    auto bytes = parse_hex(string);
+    if (bytes.empty() && string != "0x" && !string.empty()) {
+        throw std::invalid_argument("Invalid hex value");
+    }
+    return bytes;
+}
+
+/// Parses the N of uintN/intN/bytesN, empty if the type doesn't have the prefix
+std::optional<size_t> typeSize(const std::string& type, const std::string& prefix) {
+    if (type.size() <= prefix.size() || type.compare(0, prefix.size(), prefix) != 0) {
+        return std::nullopt;
+    }
+    size_t size = 0;
+    for (auto i = prefix.size(); i < type.size(); ++i) {
+        if (type[i] < '0' || type[i] > '9' || size > 1000) {
+            return std::nullopt;
+        }
+        size = size * 10 + static_cast<size_t>(type[i] - '0');
+    }
+    return size;
+}
+
+} // namespace
+
+TypedData::TypedData(const json& types, const std::string& primaryType) {
+    if (!types.is_object()) {
+        throw std::invalid_argument("Invalid types");
+    }
+    for (auto it = types.begin(); it != types.end(); ++it) {
+        if (!it.value().is_array()) {
+            throw std::invalid_argument("Invalid fields of " + it.key());
+        }
+        structs.push_back(Struct{it.key(), {}, {}, {}});
+    }
+    std::sort(structs.begin(), structs.end(), [](const Struct& lhs, const Struct& rhs) { return lhs.name < rhs.name; });
+
+    // fields, and the "Name(type name,...)" member string of each struct
+    std::vector<std::string> members(structs.size());
+    for (size_t i = 0; i < structs.size(); ++i) {
+        auto& current = structs[i];
+        members[i] = current.name + "(";
+        for (const auto& field : types[current.name]) {
+            if (!field.is_object() || !field.contains("name") || !field.contains("type") || !field["name"].is_string() ||
+                !field["type"].is_string()) {
+                throw std::invalid_argument("Invalid field of " + current.name);
+            }
+            const auto& fieldName = field["name"].get_ref<const std::string&>();
+            const auto& fieldType = field["type"].get_ref<const std::string&>();
+            current.fields.push_back(Field{fieldName, parseFieldType(fieldType)});
+            if (current.fields.size() > 1) {
+                members[i] += ",";
+            }
+            members[i] += fieldType + " " + fieldName;
+        }
+        members[i] += ")";
+    }
+
+    // encodeType: the struct itself, then every struct it references (directly or not) in alphabetical order
+    for (size_t i = 0; i < structs.size(); ++i) {
+        std::set<size_t> dependencies;
+        std::vector<size_t> pending = {i};
+        while (!pending.empty()) {
+            const auto current = pending.back();
+            pending.pop_back();
+            for (const auto& field : structs[current].fields) {
+                if (field.type.kind == Kind::Struct && field.type.structIndex != i &&
+                    dependencies.insert(field.type.structIndex).second) {
+                    pending.push_back(field.type.structIndex);
+                }
+            }
+        }
+        // structs are sorted by name, so the set is in alphabetical order
+        structs[i].encodeType = members[i];
+        for (const auto dependency : dependencies) {
+            structs[i].encodeType += members[dependency];
+        }
+        keccak(reinterpret_cast<const byte*>(structs[i].encodeType.data()), structs[i].encodeType.size(),
+               structs[i].typeHash.data());
+    }
+
+    primaryIndex = structIndex(primaryType);
+}
+
+size_t TypedData::structIndex(const std::string& type) const {
+    const auto it = std::lower_bound(structs.begin(), structs.end(), type,
+                                     [](const Struct& current, const std::string& name) { return current.name < name; });
+    if (it == structs.end() || it->name != type) {
+        throw std::invalid_argument("Unknown type " + type);
+    }
+    return static_cast<size_t>(it - structs.begin());
+}
+
+TypedData::FieldType TypedData::parseFieldType(const std::string& type) const {
+    FieldType result{Kind::Struct};
+    // array suffixes, outermost last in the string
+    auto base = type;
+    while (!base.empty() && base.back() == ']') {
+        const auto open = base.rfind('[');
+        if (open == std::string::npos) {
+            throw std::invalid_argument("Invalid type " + type);
+        }
+        size_t length = 0;
+        if (open + 2 < base.size()) {
+            const auto parsed = typeSize(base.substr(open, base.size() - open - 1), "[");
+            if (!parsed.has_value() || *parsed == 0) {
+                throw std::invalid_argument("Invalid type " + type);
+            }
+            length = *parsed;
+        }
+        result.dimensions.push_back(length);
+        base.resize(open);
+    }
+    std::reverse(result.dimensions.begin(), result.dimensions.end());
+
+    if (base == "bool") {
+        result.kind = Kind::Bool;
+    } else if (base == "address") {
+        result.kind = Kind::Address;
+    } else if (base == "bytes") {
+        result.kind = Kind::Bytes;
+    } else if (base == "string") {
+        result.kind = Kind::String;
+    } else if (const auto bits = typeSize(base, "uint"); bits.has_value()) {
+        if (*bits == 0 || *bits > 256 || *bits % 8 != 0) {
+            throw std::invalid_argument("Invalid type " + type);
+        }
+        result.kind = Kind::UInt;
+        result.size = *bits;
+    } else if (const auto bits = typeSize(base, "int"); bits.has_value()) {
+        if (*bits == 0 || *bits > 256 || *bits % 8 != 0) {
+            throw std::invalid_argument("Invalid type " + type);
+        }
+        result.kind = Kind::Int;
+        result.size = *bits;
+    } else if (const auto size = typeSize(base, "bytes"); size.has_value()) {
+        if (*size == 0 || *size > wordSize) {
+            throw std::invalid_argument("Invalid type " + type);
+        }
+        result.kind = Kind::FixedBytes;
+        result.size = *size;
+    } else {
+        result.structIndex = structIndex(base);
+    }
+    return result;
+}
+
+void TypedData::encodeValue(const FieldType& type, size_t depth, const json& value, byte* out) const {
+    if (depth > 0) {
+        // arrays hash the concatenated encodings of their elements
+        const auto length = type.dimensions[depth - 1];
+        if (!value.is_array() || (length != 0 && value.size() != length)) {
+            throw std::invalid_argument("Invalid array value");
+        }
+        Data encoded(value.size() * wordSize);
+        for (size_t i = 0; i < value.size(); ++i) {
+            encodeValue(type, depth - 1, value[i], encoded.data() + i * wordSize);
+        }
+        keccak(encoded.data(), encoded.size(), out);
+        return;
+    }
+
+    std::memset(out, 0, wordSize);
+    switch (type.kind) {
+    case Kind::UInt: {
+        const auto number = parseNumber<uint256_t>(value);
+        if (type.size < 256 && (number >> type.size) != 0) {
+            throw std::invalid_argument("Number out of range");
+        }
+        writeUInt256(number, out);
+    } break;
+    case Kind::Int: {
+        const auto number = parseNumber<int256_t>(value);
+        const auto limit = int256_t(1) << (type.size - 1);
+        if (type.size < 256 && (number >= limit || number < -limit)) {
+            throw std::invalid_argument("Number out of range");
+        }
+        writeUInt256(ValueEncoder::uint256FromInt256(number), out);
+    } break;
+    case Kind::Bool:
+        if (!value.is_boolean()) {
+            throw std::invalid_argument("Invalid bool value");
+        }
+        out[wordSize - 1] = value.get<bool>() ? 1 : 0;
+        break;
+    case Kind::Address: {
+        const auto bytes = parseHexValue(value);
+        if (bytes.size() != 20) {
+            throw std::invalid_argument("Invalid address value");
+        }
+        std::copy(bytes.begin(), bytes.end(), out + wordSize - bytes.size());
+    } break;
+    case Kind::FixedBytes: {
+        const auto bytes = parseHexValue(value);
+        if (bytes.size() > type.size) {
+            throw std::invalid_argument("Invalid bytes value");
+        }
+        // padded on the right
+        std::copy(bytes.begin(), bytes.end(), out);
+    } break;
+    case Kind::Bytes: {
+        const auto bytes = parseHexValue(value);
+        keccak(bytes.data(), bytes.size(), out);
+    } break;
+    case Kind::String: {
+        if (!value.is_string()) {
+            throw std::invalid_argument("Invalid string value");
+        }
+        const auto& string = value.get_ref<const std::string&>();
+        keccak(reinterpret_cast<const byte*>(string.data()), string.size(), out);
+    } break;
+    case Kind::Struct: {
+        const auto hash = hashStruct(type.structIndex, value);
+        std::copy(hash.begin(), hash.end(), out);
+    } break;
+    }
+}
+
+TypedData::Hash256 TypedData::hashStruct(size_t index, const json& value) const {
+    const auto& current = structs[index];
+    if (!value.is_object()) {
+        throw std::invalid_argument("Invalid value of " + current.name);
+    }
+    Data encoded((1 + current.fields.size()) * wordSize);
+    std::copy(current.typeHash.begin(), current.typeHash.end(), encoded.begin());
+    for (size_t i = 0; i < current.fields.size(); ++i) {
+        const auto& field = current.fields[i];
+        const auto it = value.find(field.name);
+        if (it == value.end()) {
+            throw std::invalid_argument("Missing field " + current.name + "." + field.name);
+        }
+        encodeValue(field.type, field.type.dimensions.size(), *it, encoded.data() + (1 + i) * wordSize);
+    }
+    Hash256 hash;
+    keccak(encoded.data(), encoded.size(), hash.data());
+    return hash;
+}
+
+const std::string& TypedData::encodeType(const std::string& type) const {
+    return structs[structIndex(type)].encodeType;
+}
+
+const TypedData::Hash256& TypedData::typeHash(const std::string& type) const {
+    return structs[structIndex(type)].typeHash;
+}
+
+TypedData::Hash256 TypedData::hashStruct(const json& message) const {
+    return hashStruct(primaryIndex, message);
+}
+
+TypedData::Hash256 TypedData::domainSeparator(const json& domain) const {
+    return hashStruct(structIndex("EIP712Domain"), domain);
+}
+
+TypedData::Hash256 TypedData::signingHash(const Hash256& domainSeparator, const json& message) const {
+    byte encoded[2 + 2 * wordSize] = {0x19, 0x01};
+    std::copy(domainSeparator.begin(), domainSeparator.end(), encoded + 2);
+    const auto structHash = hashStruct(message);
+    std::copy(structHash.begin(), structHash.end(), encoded + 2 + wordSize);
+    Hash256 hash;
+    keccak(encoded, sizeof(encoded), hash.data());
+    return hash;
+}
+
+std::vector<TypedData::Hash256> TypedData::signingHashes(const Hash256& domainSeparator,
+                                                         const std::vector<json>& messages) const {
+    // the struct hashes vary in depth; the final 66-byte hashes all have the same shape and go through the
+    // multi-lane Keccak together
+    Data encoded(messages.size() * (2 + 2 * wordSize));
+    std::vector<const byte*> inputs(messages.size());
+    std::vector<size_t> sizes(messages.size(), 2 + 2 * wordSize);
+    for (size_t i = 0; i < messages.size(); ++i) {
+        auto* preimage = encoded.data() + i * (2 + 2 * wordSize);
+        preimage[0] = 0x19;
+        preimage[1] = 0x01;
+        std::copy(domainSeparator.begin(), domainSeparator.end(), preimage + 2);
+        const auto structHash = hashStruct(messages[i]);
+        std::copy(structHash.begin(), structHash.end(), preimage + 2 + wordSize);
+        inputs[i] = preimage;
+    }
+    std::vector<Hash256> hashes(messages.size());
+    if (!messages.empty()) {
+        Hash::keccak256Many(inputs.data(), sizes.data(), messages.size(), hashes[0].data());
+    }
+    return hashes;
+}
+
+TypedData::Hash256 TypedData::hashMessage(const json& typedData) {
+    if (!typedData.is_object() || !typedData.contains("types") || !typedData.contains("primaryType") ||
+        !typedData["primaryType"].is_string() || !typedData.contains("domain") || !typedData.contains("message")) {
+        throw std::invalid_argument("Invalid typed data");
+    }
+    const TypedData compiled(typedData["types"], typedData["primaryType"].get<std::string>());
+    return compiled.signingHash(compiled.domainSeparator(typedData["domain"]), typedData["message"]);
+}
+
+} // namespace TW::Ethereum::ABI
@@ -0,0 +1,91 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <Data.h>
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace TW::Ethereum::ABI {
+
+/// EIP712 typed structured data hasher.  A type schema (the `types` object of a typed-data message) is parsed once:
+/// each struct gets its dependency-sorted `encodeType` string, its type hash, and a list of field encoders.  Messages
+/// of that schema are then hashed by walking the compiled fields, without building type strings.
+/// See: https://github.com/ethereum/EIPs/blob/master/EIPS/eip-712.md
+class TypedData {
+public:
+    using Hash256 = std::array<byte, 32>;
+
+    /// Compiles the struct types of a schema, e.g. `{"EIP712Domain": [...], "Mail": [{"name": "from", "type":
+    /// "Person"}, ...], ...}`; `primaryType` is the struct messages are hashed as.
+    ///
+    /// @throws std::invalid_argument if a field type is unknown, or the primary type is not defined.
+    TypedData(const nlohmann::json& types, const std::string& primaryType);
+
+    /// Parses a complete typed-data message, with `types`, `primaryType`, `domain` and `message`, and returns the
+    /// hash to sign: keccak256(0x19 0x01 || domainSeparator || hashStruct(message)).
+    ///
+    /// @throws std::invalid_argument on a malformed message.
+    static Hash256 hashMessage(const nlohmann::json& typedData);
+
+    /// `encodeType` string of a struct: the struct followed by its referenced structs in alphabetical order.
+    const std::string& encodeType(const std::string& type) const;
+
+    /// Hash of the `encodeType` string of a struct.
+    const Hash256& typeHash(const std::string& type) const;
+
+    /// hashStruct of a value of the primary type.
+    Hash256 hashStruct(const nlohmann::json& message) const;
+
+    /// hashStruct of the domain, as an `EIP712Domain`.
+    Hash256 domainSeparator(const nlohmann::json& domain) const;
+
+    /// Hash to sign for a message of the primary type under a domain separator.
+    Hash256 signingHash(const Hash256& domainSeparator, const nlohmann::json& message) const;
+
+    /// Hashes to sign for many messages of the primary type under one domain separator, in input order.
+    std::vector<Hash256> signingHashes(const Hash256& domainSeparator, const std::vector<nlohmann::json>& messages) const;
+
+private:
+    enum class Kind { UInt, Int, Bool, Address, FixedBytes, Bytes, String, Struct };
+
+    struct FieldType {
+        Kind kind;
+        /// Bits of an integer, bytes of a fixed byte array
+        size_t size = 0;
+        /// Index in `structs` of a struct
+        size_t structIndex = 0;
+        /// Array dimensions, innermost first; 0 for a dynamic array
+        std::vector<size_t> dimensions;
+    };
+
+    struct Field {
+        std::string name;
+        FieldType type;
+    };
+
+    struct Struct {
+        std::string name;
+        std::vector<Field> fields;
+        std::string encodeType;
+        Hash256 typeHash;
+    };
+
+    size_t structIndex(const std::string& type) const;
+    FieldType parseFieldType(const std::string& type) const;
+    void encodeValue(const FieldType& type, size_t depth, const nlohmann::json& value, byte* out) const;
+    Hash256 hashStruct(size_t index, const nlohmann::json& value) const;
+
+    std::vector<Struct> structs;
+    size_t primaryIndex;
+};
+
+} // namespace TW::Ethereum::ABI
@@ -7,28 +7,73 @@
 #include "AddressChecksum.h"
 
 #include "../Hash.h"
-#include "../HexCoding.h"
-#include <cctype>
+
+#include <TrezorCrypto/sha3.h>
+
+#include <algorithm>
 
 using namespace TW;
 using namespace TW::Ethereum;
 
-std::string Ethereum::checksumed(const Address& address, enum ChecksumType type) {
-    const auto addressString = hex(address.bytes);
-    const auto hash = hex(Hash::keccak256(addressString));
-
-    std::string string = "0x";
-    for (auto i = 0; i < std::min(addressString.size(), hash.size()); i += 1) {
-        const auto a = addressString[i];
-        const auto h = hash[i];
-        if (a >= '0' && a <= '9') {
-            string.push_back(a);
-        } else if ((h >= '8' && h <= '9') || (h >= 'a' && h <= 'f')) {
-            string.push_back(static_cast<char>(toupper(a)));
-        } else {
-            string.push_back(static_cast<char>(tolower(a)));
+namespace {
+
+/// Writes "0x" and the lowercase hex digits of an address
+void writeLowercase(const Address& address, ChecksumedAddress& output) {
+    static constexpr char hexmap[] = "0123456789abcdef";
+    output[0] = '0';
+    output[1] = 'x';
+    for (size_t i = 0; i < Address::size; ++i) {
+        output[2 + 2 * i] = hexmap[address.bytes[i] >> 4];
+        output[3 + 2 * i] = hexmap[address.bytes[i] & 0x0f];
+    }
+}
+
+/// Uppercases each letter whose nibble in the Keccak-256 of the lowercase digits is 8 or more
+void applyChecksum(const uint8_t* hash, ChecksumedAddress& output) {
+    for (size_t i = 0; i < 2 * Address::size; ++i) {
+        const auto nibble = (i % 2 == 0) ? (hash[i / 2] >> 4) : (hash[i / 2] & 0x0f);
+        auto& c = output[2 + i];
+        if (c >= 'a' && nibble >= 8) {
+            c = static_cast<char>(c - 'a' + 'A');
         }
     }
+}
+
+} // namespace
 
-    return string;
+void Ethereum::checksumed(const Address& address, enum ChecksumType type, ChecksumedAddress& output) {
+    writeLowercase(address, output);
+    uint8_t hash[32];
+    keccak_256(reinterpret_cast<const uint8_t*>(output.data() + 2), 2 * Address::size, hash);
+    applyChecksum(hash, output);
+}
+
+std::string Ethereum::checksumed(const Address& address, enum ChecksumType type) {
+    ChecksumedAddress output;
+    checksumed(address, type, output);
+    return std::string(output.begin(), output.end());
+}
+
+std::vector<ChecksumedAddress> Ethereum::checksumedMany(const std::vector<Address>& addresses, enum ChecksumType type) {
+    std::vector<ChecksumedAddress> output(addresses.size());
+    // lowercase a group of addresses, hash the group, then apply the checksums
+    constexpr size_t groupSize = 64;
+    uint8_t hashes[groupSize][32];
+    for (size_t begin = 0; begin < addresses.size(); begin += groupSize) {
+        const auto end = std::min(begin + groupSize, addresses.size());
+        for (auto i = begin; i < end; ++i) {
+            writeLowercase(addresses[i], output[i]);
+        }
+        const byte* digits[groupSize];
+        size_t sizes[groupSize];
+        for (auto i = begin; i < end; ++i) {
+            digits[i - begin] = reinterpret_cast<const byte*>(output[i].data() + 2);
+            sizes[i - begin] = 2 * Address::size;
+        }
+        Hash::keccak256Many(digits, sizes, end - begin, hashes[0]);
+        for (auto i = begin; i < end; ++i) {
+            applyChecksum(hashes[i - begin], output[i]);
+        }
+    }
+    return output;
 }
@@ -7,7 +7,10 @@
 #pragma once
 
 #include "Address.h"
+
+#include <array>
 #include <string>
+#include <vector>
 
 namespace TW::Ethereum {
 
@@ -17,6 +20,15 @@ enum ChecksumType {
     wanchain = 1,
 };
 
+/// A checksumed address string, "0x" followed by 40 hex digits, not null-terminated.
+using ChecksumedAddress = std::array<char, 2 + 2 * Address::size>;
+
 std::string checksumed(const Address& address, enum ChecksumType type);
 
+/// Writes the checksumed string of an address into a fixed buffer, without allocating.
+void checksumed(const Address& address, enum ChecksumType type, ChecksumedAddress& output);
+
+/// Checksums many addresses, hashing them as a batch.
+std::vector<ChecksumedAddress> checksumedMany(const std::vector<Address>& addresses, enum ChecksumType type);
+
 } // namespace TW::Ethereum
@@ -36,10 +36,19 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 
 Data Signer::signData(const PrivateKey& privKey, const Data& data) {
     Data hash = Hash::sha256(data);
-    Data signature = privKey.sign(hash, TWCurveSECP256k1, isCanonical);
+    Data signature = privKey.signCanonical(hash, TWCurveSECP256k1);
     return signature;
 }
 
+std::vector<Data> Signer::signData(const PrivateKey& privKey, const std::vector<Data>& data) {
+    std::vector<Data> hashes;
+    hashes.reserve(data.size());
+    for (const auto& item : data) {
+        hashes.push_back(Hash::sha256(item));
+    }
+    return privKey.signCanonical(hashes, TWCurveSECP256k1);
+}
+
 std::string Signer::signatureToBsase58(const Data& sig) {
     Data sigWithSuffix(sig);
     append(sigWithSuffix, TW::data(SignatureSuffix));
@@ -57,10 +66,7 @@ bool Signer::verify(const PublicKey& pubKey, const Data& data, const Data& signa
 
 // canonical check for FIO, both R and S lenght is 32
 int Signer::isCanonical(uint8_t by, uint8_t sig[64]) {
-    return !(sig[0] & 0x80)
-        && !(sig[0] == 0 && !(sig[1] & 0x80))
-        && !(sig[32] & 0x80)
-        && !(sig[32] == 0 && !(sig[33] & 0x80));
+    return PrivateKey::isCanonical(sig);
 }
 
 } // namespace TW::FIO
@@ -13,6 +13,7 @@
 #include "../proto/FIO.pb.h"
 
 #include <string>
+#include <vector>
 
 namespace TW::FIO {
 
@@ -29,6 +30,9 @@ class Signer {
     /// Sign the hash of the provided data
     static Data signData(const PrivateKey& privKey, const Data& data);
 
+    /// Sign the hashes of many data items, reading the key once
+    static std::vector<Data> signData(const PrivateKey& privKey, const std::vector<Data>& data);
+
     /// Used internally, encode signature to base58 with prefix. Ex.: "SIG_K1_K54CA1jmhgWrSdvrNrkokPyvqh7dwsSoQHNU9xgD3Ezf6cJySzhKeUubVRqmpYdnjoP1DM6SorroVAgrCu3qqvJ9coAQ6u"
     static std::string signatureToBsase58(const Data& sig);
 
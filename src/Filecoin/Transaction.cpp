@@ -35,28 +35,38 @@ const Data cidPrefix = {
     0x20,
 };
 
+void Transaction::message(Data& out) const {
+    Cbor::Writer writer(out);
+    writer.array(10)
+        .uint(0)                          // version
+        .bytes(to.bytes)                  // to address
+        .bytes(from.bytes)                // from address
+        .uint(nonce)                      // nonce
+        .bytes(encodeBigInt(value));      // value
+    if (gasLimit >= 0) {                  // gas limit
+        writer.uint((uint64_t)gasLimit);
+    } else {
+        writer.negInt((uint64_t)(-gasLimit - 1));
+    }
+    writer.bytes(encodeBigInt(gasFeeCap)) // gas fee cap
+        .bytes(encodeBigInt(gasPremium))  // gas premium
+        .uint(0)                          // abi.MethodNum (0 => send)
+        .bytes(Data());                   // data (empty)
+}
+
 Cbor::Encode Transaction::message() const {
-    Cbor::Encode cborGasLimit = gasLimit >= 0 ? Cbor::Encode::uint((uint64_t)gasLimit)
-                                              : Cbor::Encode::negInt((uint64_t)(-gasLimit - 1));
-    return Cbor::Encode::array({
-        Cbor::Encode::uint(0),                         // version
-        Cbor::Encode::bytes(to.bytes),                 // to address
-        Cbor::Encode::bytes(from.bytes),               // from address
-        Cbor::Encode::uint(nonce),                     // nonce
-        Cbor::Encode::bytes(encodeBigInt(value)),      // value
-        cborGasLimit,                                  // gas limit
-        Cbor::Encode::bytes(encodeBigInt(gasFeeCap)),  // gas fee cap
-        Cbor::Encode::bytes(encodeBigInt(gasPremium)), // gas premium
-        Cbor::Encode::uint(0),                         // abi.MethodNum (0 => send)
-        Cbor::Encode::bytes(Data())                    // data (empty)
-    });
+    Data encoded;
+    message(encoded);
+    return Cbor::Encode::fromRaw(encoded);
 }
 
 Data Transaction::cid() const {
     Data cid;
     cid.reserve(cidPrefix.size() + 32);
     cid.insert(cid.end(), cidPrefix.begin(), cidPrefix.end());
-    Data hash = Hash::blake2b(message().encoded(), 32);
+    Data encoded;
+    message(encoded);
+    Data hash = Hash::blake2b(encoded, 32);
     cid.insert(cid.end(), hash.begin(), hash.end());
     return cid;
 }
@@ -53,6 +53,9 @@ class Transaction {
     // message returns the CBOR encoding of the Filecoin Message to be signed.
     Cbor::Encode message() const;
 
+    // message appends the CBOR encoding of the Filecoin Message to `out`.
+    void message(Data& out) const;
+
     // cid returns the raw Filecoin message CID (excluding the signature).
     Data cid() const;
 
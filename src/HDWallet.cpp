@@ -11,13 +11,20 @@
 #include "Bitcoin/SegwitAddress.h"
 #include "Bitcoin/CashAddress.h"
 #include "Coin.h"
+#include "Mnemonic.h"
+#include "PBKDF2.h"
 
 #include <TrustWalletCore/TWHRP.h>
 #include <TrezorCrypto/bip32.h>
 #include <TrezorCrypto/bip39.h>
 #include <TrezorCrypto/curves.h>
+#include <TrezorCrypto/memzero.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <exception>
+#include <thread>
 
 using namespace TW;
 
@@ -28,34 +35,72 @@ std::string serialize(const HDNode *node, uint32_t fingerprint, uint32_t version
 bool deserialize(const std::string& extended, TWCurve curve, Hash::Hasher hasher, HDNode *node);
 HDNode getNode(const HDWallet& wallet, TWCurve curve, const DerivationPath& derivationPath);
 HDNode getMasterNode(const HDWallet& wallet, TWCurve curve);
+std::vector<PrivateKey> getKeys(const HDWallet& wallet, TWCurve curve, const std::vector<DerivationPath>& derivationPaths);
+void deriveChild(HDNode& node, HDWallet::PrivateKeyType privateKeyType, const DerivationPathIndex& index);
+PrivateKey privateKey(const HDNode& node, HDWallet::PrivateKeyType privateKeyType);
 
 const char* curveName(TWCurve curve);
 } // namespace
 
 HDWallet::HDWallet(int strength, const std::string& passphrase)
-    : seed(), mnemonic(), passphrase(passphrase) {
+    : seed(seedSize), mnemonic(), passphrase(passphrase.begin(), passphrase.end()) {
     const char* mnemonic_chars = mnemonic_generate(strength);
-    mnemonic_to_seed(mnemonic_chars, passphrase.c_str(), seed.data(), nullptr);
+    mnemonic_to_seed(mnemonic_chars, this->passphrase.c_str(), seed.data(), nullptr);
     mnemonic = mnemonic_chars;
+    mnemonic_clear();
     updateEntropy();
 }
 
-HDWallet::HDWallet(const std::string& mnemonic, const std::string& passphrase)
-    : seed(), mnemonic(mnemonic), passphrase(passphrase) {
-    mnemonic_to_seed(mnemonic.c_str(), passphrase.c_str(), seed.data(), nullptr);
+HDWallet::HDWallet(std::string_view mnemonic, const std::string& passphrase)
+    : seed(seedSize), mnemonic(mnemonic.begin(), mnemonic.end()), passphrase(passphrase.begin(), passphrase.end()) {
+    mnemonic_to_seed(this->mnemonic.c_str(), this->passphrase.c_str(), seed.data(), nullptr);
     updateEntropy();
 }
 
 HDWallet::HDWallet(const Data& data, const std::string& passphrase)
-    : seed(), mnemonic(), passphrase(passphrase) {
+    : seed(seedSize), mnemonic(), passphrase(passphrase.begin(), passphrase.end()) {
     const char* mnemonic_chars = mnemonic_from_data(data.data(), static_cast<int>(data.size()));
     if (mnemonic_chars) {
-        mnemonic_to_seed(mnemonic_chars, passphrase.c_str(), seed.data(), nullptr);
+        mnemonic_to_seed(mnemonic_chars, this->passphrase.c_str(), seed.data(), nullptr);
         mnemonic = mnemonic_chars;
+        mnemonic_clear();
         updateEntropy();
     }
 }
 
+std::vector<std::optional<std::array<byte, HDWallet::seedSize>>> HDWallet::computeSeeds(const std::vector<std::string>& mnemonics, const std::string& passphrase, unsigned threads) {
+    // same salt as mnemonic_to_seed, which reads at most 256 passphrase bytes
+    Data salt = {'m', 'n', 'e', 'm', 'o', 'n', 'i', 'c'};
+    const auto passphraseLength = strnlen(passphrase.c_str(), 256);
+    salt.insert(salt.end(), passphrase.begin(), passphrase.begin() + passphraseLength);
+
+    // only valid mnemonics are derived
+    const auto valid = Mnemonic::isValidBatch(mnemonics);
+    std::vector<PBKDF2::Input> inputs;
+    inputs.reserve(mnemonics.size());
+    for (size_t i = 0; i < mnemonics.size(); ++i) {
+        if (valid[i]) {
+            inputs.push_back({mnemonics[i], salt});
+        }
+    }
+    auto derived = PBKDF2::hmacSha512(inputs, BIP39_PBKDF2_ROUNDS, threads);
+    for (auto& input : inputs) {
+        std::fill(input.password.begin(), input.password.end(), 0);
+        std::fill(input.salt.begin(), input.salt.end(), 0);
+    }
+    std::fill(salt.begin(), salt.end(), 0);
+
+    std::vector<std::optional<std::array<byte, seedSize>>> seeds(mnemonics.size());
+    for (size_t i = 0, next = 0; i < mnemonics.size(); ++i) {
+        if (valid[i]) {
+            seeds[i] = derived[next];
+            memzero(derived[next].data(), derived[next].size());
+            ++next;
+        }
+    }
+    return seeds;
+}
+
 HDWallet::~HDWallet() {
     std::fill(seed.begin(), seed.end(), 0);
     std::fill(mnemonic.begin(), mnemonic.end(), 0);
@@ -64,10 +109,10 @@ HDWallet::~HDWallet() {
 
 void HDWallet::updateEntropy() {
     // generate entropy (from mnemonic)
-    Data entropyRaw(32 + 1);
+    SecureData entropyRaw(32 + 1);
     auto entropyBits = mnemonic_to_bits(mnemonic.c_str(), entropyRaw.data());
     // copy to truncate
-    entropy = data(entropyRaw.data(), entropyBits / 8);
+    entropy = secureData(entropyRaw.data(), entropyBits / 8);
 }
 
 PrivateKey HDWallet::getMasterKey(TWCurve curve) const {
@@ -86,28 +131,79 @@ PrivateKey HDWallet::getKey(TWCoinType coin, const DerivationPath& derivationPat
     const auto curve = TWCoinTypeCurve(coin);
     const auto privateKeyType = getPrivateKeyType(curve);
     auto node = getNode(*this, curve, derivationPath);
-    switch (privateKeyType) {
-        case PrivateKeyTypeExtended96:
-            {
-                auto pkData = Data(node.private_key, node.private_key + PrivateKey::size);
-                auto extData = Data(node.private_key_extension, node.private_key_extension + PrivateKey::size);
-                auto chainCode = Data(node.chain_code, node.chain_code + PrivateKey::size);
-                return PrivateKey(pkData, extData, chainCode);
-            }
+    return privateKey(node, privateKeyType);
+}
 
-        case PrivateKeyTypeDefault32:
-        default:
-            // default path
-            auto data = Data(node.private_key, node.private_key + PrivateKey::size);
-            return PrivateKey(data);
-    }
+std::vector<PrivateKey> HDWallet::getKeys(TWCoinType coin, const std::vector<DerivationPath>& derivationPaths) const {
+    return ::getKeys(*this, TWCoinTypeCurve(coin), derivationPaths);
 }
 
 std::string HDWallet::deriveAddress(TWCoinType coin) const {
-    const auto derivationPath = TW::derivationPath(coin);
+    const auto& derivationPath = TW::derivationPath(coin);
     return TW::deriveAddress(coin, getKey(coin, derivationPath));
 }
 
+std::vector<std::string> HDWallet::deriveAddresses(const std::vector<TWCoinType>& coins, unsigned threads) const {
+    // group coins by curve, each group shares a master node; unsupported coins are left with an empty address
+    std::vector<std::pair<TWCurve, std::vector<size_t>>> groups;
+    for (size_t i = 0; i < coins.size(); ++i) {
+        if (!TW::isCoinSupported(coins[i])) {
+            continue;
+        }
+        const auto curve = TWCoinTypeCurve(coins[i]);
+        auto group = std::find_if(groups.begin(), groups.end(), [curve](const auto& g) { return g.first == curve; });
+        if (group == groups.end()) {
+            group = groups.insert(groups.end(), {curve, {}});
+        }
+        group->second.push_back(i);
+    }
+
+    std::vector<std::string> addresses(coins.size());
+    const auto deriveGroup = [&](const std::pair<TWCurve, std::vector<size_t>>& group) {
+        std::vector<DerivationPath> paths;
+        paths.reserve(group.second.size());
+        for (const auto i : group.second) {
+            paths.push_back(TW::derivationPath(coins[i]));
+        }
+        const auto keys = ::getKeys(*this, group.first, paths);
+        for (size_t j = 0; j < keys.size(); ++j) {
+            const auto i = group.second[j];
+            addresses[i] = TW::deriveAddress(coins[i], keys[j]);
+        }
+    };
+
+    const auto workers = std::min<size_t>(threads, groups.size());
+    if (workers <= 1) {
+        for (const auto& group : groups) {
+            deriveGroup(group);
+        }
+    } else {
+        std::atomic<size_t> next{0};
+        std::vector<std::exception_ptr> errors(workers);
+        std::vector<std::thread> pool;
+        for (size_t w = 0; w < workers; ++w) {
+            pool.emplace_back([&, w] {
+                try {
+                    for (auto g = next++; g < groups.size(); g = next++) {
+                        deriveGroup(groups[g]);
+                    }
+                } catch (...) {
+                    errors[w] = std::current_exception();
+                }
+            });
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+    return addresses;
+}
+
 std::string HDWallet::getExtendedPrivateKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version) const {
     if (version == TWHDVersionNone) {
         return "";
@@ -250,21 +346,85 @@ HDNode getNode(const HDWallet& wallet, TWCurve curve, const DerivationPath& deri
     const auto privateKeyType = HDWallet::getPrivateKeyType(curve);
     auto node = getMasterNode(wallet, curve);
     for (auto& index : derivationPath.indices) {
-        switch (privateKeyType) {
-            case HDWallet::PrivateKeyTypeHD:
-            case HDWallet::PrivateKeyTypeExtended96:
-                // special handling for extended
-                hdnode_private_ckd_cardano(&node, index.derivationIndex());
-                break;
-            case HDWallet::PrivateKeyTypeDefault32:
-            default:
-                hdnode_private_ckd(&node, index.derivationIndex());
-                break;
-        }
+        deriveChild(node, privateKeyType, index);
     }
     return node;
 }
 
+std::vector<PrivateKey> getKeys(const HDWallet& wallet, TWCurve curve, const std::vector<DerivationPath>& derivationPaths) {
+    const auto privateKeyType = HDWallet::getPrivateKeyType(curve);
+
+    // visit paths in lexicographic order, so that each one shares the longest possible prefix with the previous
+    std::vector<size_t> order(derivationPaths.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&derivationPaths](size_t lhs, size_t rhs) {
+        const auto& l = derivationPaths[lhs].indices;
+        const auto& r = derivationPaths[rhs].indices;
+        return std::lexicographical_compare(l.begin(), l.end(), r.begin(), r.end(),
+            [](const DerivationPathIndex& a, const DerivationPathIndex& b) { return a.derivationIndex() < b.derivationIndex(); });
+    });
+
+    // nodes[d] is the node at depth d of the previously derived path
+    std::vector<HDNode> nodes{getMasterNode(wallet, curve)};
+    const DerivationPath* previous = nullptr;
+    std::vector<std::optional<PrivateKey>> keys(derivationPaths.size());
+    for (const auto i : order) {
+        const auto& path = derivationPaths[i];
+        const auto common = previous == nullptr ? 0 : commonPrefixLength(*previous, path);
+        nodes.resize(common + 1);
+        for (auto depth = common; depth < path.indices.size(); ++depth) {
+            nodes.push_back(nodes.back());
+            deriveChild(nodes.back(), privateKeyType, path.indices[depth]);
+        }
+        keys[i] = privateKey(nodes.back(), privateKeyType);
+        previous = &path;
+    }
+    for (auto& node : nodes) {
+        memzero(&node, sizeof(node));
+    }
+
+    std::vector<PrivateKey> result;
+    result.reserve(keys.size());
+    for (auto& key : keys) {
+        result.push_back(std::move(*key));
+    }
+    return result;
+}
+
+void deriveChild(HDNode& node, HDWallet::PrivateKeyType privateKeyType, const DerivationPathIndex& index) {
+    switch (privateKeyType) {
+        case HDWallet::PrivateKeyTypeHD:
+        case HDWallet::PrivateKeyTypeExtended96:
+            // special handling for extended
+            hdnode_private_ckd_cardano(&node, index.derivationIndex());
+            break;
+        case HDWallet::PrivateKeyTypeDefault32:
+        default:
+            hdnode_private_ckd(&node, index.derivationIndex());
+            break;
+    }
+}
+
+PrivateKey privateKey(const HDNode& node, HDWallet::PrivateKeyType privateKeyType) {
+    switch (privateKeyType) {
+        case HDWallet::PrivateKeyTypeExtended96:
+            {
+                auto pkData = Data(node.private_key, node.private_key + PrivateKey::size);
+                auto extData = Data(node.private_key_extension, node.private_key_extension + PrivateKey::size);
+                auto chainCode = Data(node.chain_code, node.chain_code + PrivateKey::size);
+                return PrivateKey(pkData, extData, chainCode);
+            }
+
+        case HDWallet::PrivateKeyTypeDefault32:
+        default:
+            // default path
+            auto data = Data(node.private_key, node.private_key + PrivateKey::size);
+            return PrivateKey(data);
+    }
+}
+
 HDNode getMasterNode(const HDWallet& wallet, TWCurve curve) {
     const auto privateKeyType = HDWallet::getPrivateKeyType(curve);
     auto node = HDNode();
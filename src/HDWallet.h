@@ -11,6 +11,7 @@
 #include "Hash.h"
 #include "PrivateKey.h"
 #include "PublicKey.h"
+#include "SecureMemory.h"
 
 #include <TrustWalletCore/TWCoinType.h>
 #include <TrustWalletCore/TWCurve.h>
@@ -20,6 +21,8 @@
 #include <array>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace TW {
 
@@ -30,31 +33,32 @@ class HDWallet {
     static constexpr size_t maxExtendedKeySize = 128;
 
   public:
-    /// Wallet seed.
-    std::array<byte, seedSize> seed;
+    /// Wallet seed, `seedSize` bytes.  Secrets are kept in locked memory that is zeroed when freed.
+    SecureData seed;
 
     /// Mnemonic word list.
-    std::string mnemonic;
+    SecureString mnemonic;
 
     /// Mnemonic passphrase.
-    std::string passphrase;
+    SecureString passphrase;
 
     /// Entropy bytes (11 bits from each word)
-    TW::Data entropy;
+    SecureData entropy;
 
   public:
     /// Initializes a new random HDWallet with the provided strength in bits.
     HDWallet(int strength, const std::string& passphrase);
 
     /// Initializes an HDWallet from a mnemonic seed.
-    HDWallet(const std::string& mnemonic, const std::string& passphrase);
+    HDWallet(std::string_view mnemonic, const std::string& passphrase);
 
     /// Initializes an HDWallet from a seed.
     HDWallet(const Data& data, const std::string& passphrase);
 
-    HDWallet(const HDWallet& other) = default;
+    /// Move-only, so secrets are not copied implicitly.
+    HDWallet(const HDWallet& other) = delete;
     HDWallet(HDWallet&& other) = default;
-    HDWallet& operator=(const HDWallet& other) = default;
+    HDWallet& operator=(const HDWallet& other) = delete;
     HDWallet& operator=(HDWallet&& other) = default;
 
     virtual ~HDWallet();
@@ -70,9 +74,18 @@ class HDWallet {
     /// Returns the private key at the given derivation path.
     PrivateKey getKey(const TWCoinType coin, const DerivationPath& derivationPath) const;
 
+    /// Returns the private keys at the given derivation paths, in order.  Nodes of common ancestors
+    /// (e.g. the account level of many address paths) are derived only once.
+    std::vector<PrivateKey> getKeys(const TWCoinType coin, const std::vector<DerivationPath>& derivationPaths) const;
+
     /// Derives the address for a coin.
     std::string deriveAddress(TWCoinType coin) const;
 
+    /// Derives the default addresses of many coins, same as `deriveAddress` for each, in order.  Coins are
+    /// grouped by curve, so each master key and each common path prefix is derived once; with `threads` > 1
+    /// the curve groups are spread over worker threads.  Unsupported coin ids get an empty address.
+    std::vector<std::string> deriveAddresses(const std::vector<TWCoinType>& coins, unsigned threads = 1) const;
+
     /// Returns the extended private key.
     std::string getExtendedPrivateKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version) const;
 
@@ -85,6 +98,11 @@ class HDWallet {
     /// Computes the private key from an exteded private key representation.
     static std::optional<PrivateKey> getPrivateKeyFromExtended(const std::string& extended, TWCoinType coin, const DerivationPath& path);
 
+    /// Computes the BIP39 seeds of many mnemonics sharing a passphrase, same as constructing an HDWallet
+    /// from each.  Each mnemonic is validated first; invalid ones get no seed.  Derivations run interleaved
+    /// through a multi-lane PBKDF2 and are spread over up to `threads` threads.
+    static std::vector<std::optional<std::array<byte, seedSize>>> computeSeeds(const std::vector<std::string>& mnemonics, const std::string& passphrase, unsigned threads = 1);
+
   public:
     // Private key type (later could be moved out of HDWallet)
     enum PrivateKeyType {
@@ -7,6 +7,7 @@
 #include "Hash.h"
 #include "XXHash64.h"
 #include "BinaryCoding.h"
+#include "KeccakLanes.h"
 
 #include <TrezorCrypto/blake256.h>
 #include <TrezorCrypto/blake2b.h>
@@ -50,6 +51,31 @@ Data Hash::keccak256(const byte* data, size_t size) {
     return result;
 }
 
+void Hash::keccak256Many(const byte* const* inputs, const size_t* sizes, size_t count, byte* output) {
+    KeccakLanes::keccak256(inputs, sizes, count, output, KeccakLanes::preferredLanes());
+}
+
+std::vector<Data> Hash::keccak256Many(const std::vector<Data>& inputs) {
+    std::vector<const byte*> pointers;
+    std::vector<size_t> sizes;
+    pointers.reserve(inputs.size());
+    sizes.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        pointers.push_back(input.data());
+        sizes.push_back(input.size());
+    }
+    constexpr auto digestSize = KeccakLanes::digestSize;
+    Data digests(inputs.size() * digestSize);
+    keccak256Many(pointers.data(), sizes.data(), inputs.size(), digests.data());
+
+    std::vector<Data> result;
+    result.reserve(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        result.emplace_back(digests.begin() + i * digestSize, digests.begin() + (i + 1) * digestSize);
+    }
+    return result;
+}
+
 Data Hash::keccak512(const byte* data, size_t size) {
     Data result(sha512Size);
     keccak_512(data, size, result.data());
@@ -9,6 +9,7 @@
 #include "Data.h"
 
 #include <functional>
+#include <vector>
 
 namespace TW::Hash {
 
@@ -44,6 +45,13 @@ Data sha512_256(const byte* data, size_t size);
 /// Computes the Keccak SHA256 hash.
 Data keccak256(const byte* data, size_t size);
 
+/// Computes the Keccak SHA256 hashes of many inputs, several at a time through the widest multi-lane Keccak kernel
+/// the CPU supports.  Writes 32 bytes per input to `output`, in input order.
+void keccak256Many(const byte* const* inputs, const size_t* sizes, size_t count, byte* output);
+
+/// Computes the Keccak SHA256 hashes of many inputs, in input order.
+std::vector<Data> keccak256Many(const std::vector<Data>& inputs);
+
 /// Computes the Keccak SHA512 hash.
 Data keccak512(const byte* data, size_t size);
 
@@ -0,0 +1,188 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "JSONWriter.h"
+
+#include <cassert>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+using namespace TW;
+
+namespace {
+
+/// Returns the length of the valid UTF-8 sequence starting at `s`, or 0 if it is invalid.
+size_t utf8SequenceLength(const uint8_t* s, size_t available) {
+    const auto isContinuation = [](uint8_t c) { return (c & 0xC0) == 0x80; };
+    const uint8_t c = s[0];
+    if (c < 0x80) {
+        return 1;
+    }
+    if (c >= 0xC2 && c <= 0xDF) {
+        return available >= 2 && isContinuation(s[1]) ? 2 : 0;
+    }
+    if (c >= 0xE0 && c <= 0xEF) {
+        if (available < 3 || !isContinuation(s[1]) || !isContinuation(s[2])) {
+            return 0;
+        }
+        // no overlong encodings, no surrogates
+        if ((c == 0xE0 && s[1] < 0xA0) || (c == 0xED && s[1] > 0x9F)) {
+            return 0;
+        }
+        return 3;
+    }
+    if (c >= 0xF0 && c <= 0xF4) {
+        if (available < 4 || !isContinuation(s[1]) || !isContinuation(s[2]) || !isContinuation(s[3])) {
+            return 0;
+        }
+        // no overlong encodings, nothing above U+10FFFF
+        if ((c == 0xF0 && s[1] < 0x90) || (c == 0xF4 && s[1] > 0x8F)) {
+            return 0;
+        }
+        return 4;
+    }
+    return 0;
+}
+
+} // namespace
+
+void JSONWriter::separate() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (depth > 0) {
+        if (!empty[depth]) {
+            out.push_back(',');
+        }
+        empty[depth] = false;
+    }
+}
+
+void JSONWriter::push(char bracket) {
+    separate();
+    if (depth + 1 >= maxDepth) {
+        throw std::length_error("JSON nesting too deep");
+    }
+    out.push_back(bracket);
+    ++depth;
+    empty[depth] = true;
+    lastKey[depth] = nullptr;
+}
+
+void JSONWriter::pop(char bracket) {
+    assert(depth > 0 && !afterKey);
+    out.push_back(bracket);
+    --depth;
+}
+
+void JSONWriter::beginObject() {
+    push('{');
+}
+
+void JSONWriter::endObject() {
+    pop('}');
+}
+
+void JSONWriter::beginArray() {
+    push('[');
+}
+
+void JSONWriter::endArray() {
+    pop(']');
+}
+
+void JSONWriter::key(const char* name) {
+    assert(lastKey[depth] == nullptr || std::strcmp(lastKey[depth], name) < 0);
+    lastKey[depth] = name;
+    separate();
+    writeString(name, std::strlen(name));
+    out.push_back(':');
+    afterKey = true;
+}
+
+void JSONWriter::value(const char* string) {
+    value(string, std::strlen(string));
+}
+
+void JSONWriter::value(const char* string, size_t length) {
+    separate();
+    writeString(string, length);
+}
+
+void JSONWriter::writeInteger(int64_t number) {
+    separate();
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out.append(buffer, result.ptr);
+}
+
+void JSONWriter::writeInteger(uint64_t number) {
+    separate();
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out.append(buffer, result.ptr);
+}
+
+void JSONWriter::value(bool boolean) {
+    separate();
+    out.append(boolean ? "true" : "false");
+}
+
+void JSONWriter::null() {
+    separate();
+    out.append("null");
+}
+
+void JSONWriter::raw(const std::string& json) {
+    separate();
+    out.append(json);
+}
+
+void JSONWriter::writeString(const char* string, size_t length) {
+    static constexpr char hexDigits[] = "0123456789abcdef";
+    const auto bytes = reinterpret_cast<const uint8_t*>(string);
+    out.push_back('"');
+    size_t i = 0;
+    while (i < length) {
+        // copy runs of characters needing no escaping at once
+        size_t run = i;
+        while (run < length && bytes[run] >= 0x20 && bytes[run] < 0x80 && bytes[run] != '"' && bytes[run] != '\\') {
+            ++run;
+        }
+        out.append(string + i, run - i);
+        i = run;
+        if (i == length) {
+            break;
+        }
+        const uint8_t c = bytes[i];
+        switch (c) {
+        case '\b': out.append("\\b"); break;
+        case '\t': out.append("\\t"); break;
+        case '\n': out.append("\\n"); break;
+        case '\f': out.append("\\f"); break;
+        case '\r': out.append("\\r"); break;
+        case '"': out.append("\\\""); break;
+        case '\\': out.append("\\\\"); break;
+        default:
+            if (c < 0x20) {
+                const char escaped[] = {'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0x0F]};
+                out.append(escaped, sizeof(escaped));
+            } else {
+                const auto sequence = utf8SequenceLength(bytes + i, length - i);
+                if (sequence == 0) {
+                    throw std::invalid_argument("invalid UTF-8 byte at index " + std::to_string(i));
+                }
+                out.append(string + i, sequence);
+                i += sequence;
+                continue;
+            }
+        }
+        ++i;
+    }
+    out.push_back('"');
+}
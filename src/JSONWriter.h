@@ -0,0 +1,76 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace TW {
+
+/// Streaming writer of compact JSON into a caller-provided (reusable) buffer, without building a document tree.
+///
+/// Output is byte-identical to `nlohmann::json::dump()` of the equivalent document, provided object keys are
+/// written in sorted (byte-wise) order, as nlohmann keeps them.  Keys are normally literals, so the order is
+/// fixed by the calling code; debug builds assert it.  Strings must be valid UTF-8.
+class JSONWriter {
+  public:
+    static constexpr size_t maxDepth = 32;
+
+    /// Appends to `buffer`; clear it beforehand to reuse its capacity.
+    explicit JSONWriter(std::string& buffer) : out(buffer) {}
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    /// Writes an object key, the next call writes its value.
+    void key(const char* name);
+
+    void value(const std::string& string) { value(string.data(), string.size()); }
+    void value(const char* string);
+    void value(const char* string, size_t length);
+    /// Any integer type, so that `size_t`, `long` and `long long` are never ambiguous.
+    template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    void value(T number) {
+        if constexpr (std::is_signed_v<T>) {
+            writeInteger(static_cast<int64_t>(number));
+        } else {
+            writeInteger(static_cast<uint64_t>(number));
+        }
+    }
+    void value(bool boolean);
+    void null();
+
+    /// Writes an already serialized JSON value as is.
+    void raw(const std::string& json);
+
+    /// Writes a key and its value.
+    template <typename T>
+    void field(const char* name, const T& fieldValue) {
+        key(name);
+        value(fieldValue);
+    }
+
+  private:
+    void separate();
+    void push(char bracket);
+    void pop(char bracket);
+    void writeString(const char* string, size_t length);
+    void writeInteger(int64_t number);
+    void writeInteger(uint64_t number);
+
+    std::string& out;
+    size_t depth = 0;
+    bool afterKey = false;
+    std::array<bool, maxDepth> empty{};
+    std::array<const char*, maxDepth> lastKey{};
+};
+
+} // namespace TW
@@ -0,0 +1,205 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "KeccakLanes.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace TW;
+
+namespace {
+
+/// One 64-bit state word from each lane; the compiler maps these onto SSE2/NEON, AVX2 and AVX-512 registers.
+typedef uint64_t Words2 __attribute__((vector_size(sizeof(uint64_t) * 2)));
+typedef uint64_t Words4 __attribute__((vector_size(sizeof(uint64_t) * 4)));
+typedef uint64_t Words8 __attribute__((vector_size(sizeof(uint64_t) * 8)));
+
+/// Bytes absorbed per permutation by Keccak-256.
+constexpr size_t rate = 136;
+
+constexpr uint64_t roundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+
+/// Rotation of state word x + 5y
+constexpr int rotations[25] = {
+    0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14,
+};
+
+/// Destination of state word x + 5y after the pi step, y + 5 * ((2x + 3y) % 5)
+constexpr int positions[25] = {
+    0, 10, 20, 5, 15, 16, 1, 11, 21, 6, 7, 17, 2, 12, 22, 23, 8, 18, 3, 13, 14, 24, 9, 19, 4,
+};
+
+inline uint64_t load64(const byte* bytes) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+inline void store64(uint64_t value, byte* bytes) {
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<byte>(value >> (8 * i));
+    }
+}
+
+/// Keccak-f[1600] on every lane.  Vectors are only passed by pointer, so nothing crosses a call boundary with a vector
+/// type the caller's target may not have.
+template <typename Words>
+__attribute__((always_inline)) inline void permute(Words a[25]) {
+    for (const auto constant : roundConstants) {
+        // theta
+        Words c[5], d[5];
+#pragma GCC unroll 5
+        for (int x = 0; x < 5; ++x) {
+            c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+        }
+#pragma GCC unroll 5
+        for (int x = 0; x < 5; ++x) {
+            const auto& e = c[(x + 1) % 5];
+            d[x] = c[(x + 4) % 5] ^ (e << 1) ^ (e >> 63);
+        }
+        // rho and pi
+        Words b[25];
+        b[0] = a[0] ^ d[0];
+        // fully unrolled so the rotations are immediates
+#pragma GCC unroll 24
+        for (int i = 1; i < 25; ++i) {
+            const auto e = a[i] ^ d[i % 5];
+            b[positions[i]] = (e << rotations[i]) | (e >> (64 - rotations[i]));
+        }
+        // chi
+#pragma GCC unroll 5
+        for (int y = 0; y < 25; y += 5) {
+#pragma GCC unroll 5
+            for (int x = 0; x < 5; ++x) {
+                a[y + x] = b[y + x] ^ (~b[y + (x + 1) % 5] & b[y + (x + 2) % 5]);
+            }
+        }
+        // iota
+        a[0] ^= constant;
+    }
+}
+
+/// Hashes up to `sizeof(Words) / 8` inputs; unused lanes repeat the first input
+template <typename Words>
+__attribute__((always_inline)) inline void hashLanes(const byte* const* inputs, const size_t* sizes, size_t count,
+                                                     byte* output) {
+    constexpr size_t lanes = sizeof(Words) / sizeof(uint64_t);
+    const byte* data[lanes];
+    size_t size[lanes];
+    size_t blocks[lanes];
+    size_t maxBlocks = 0;
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        const auto input = lane < count ? lane : 0;
+        data[lane] = inputs[input];
+        size[lane] = sizes[input];
+        // the padding always takes at least one byte, so there is always a final block
+        blocks[lane] = size[lane] / rate + 1;
+        maxBlocks = std::max(maxBlocks, blocks[lane]);
+    }
+
+    Words a[25] = {};
+    byte padded[rate];
+    for (size_t block = 0; block < maxBlocks; ++block) {
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            if (block >= blocks[lane]) {
+                continue;
+            }
+            const byte* bytes = data[lane] + block * rate;
+            if (block + 1 == blocks[lane]) {
+                const auto tail = size[lane] - block * rate;
+                std::memset(padded, 0, rate);
+                if (tail > 0) {
+                    std::memcpy(padded, bytes, tail);
+                }
+                padded[tail] |= 0x01;
+                padded[rate - 1] |= 0x80;
+                bytes = padded;
+            }
+            for (size_t word = 0; word < rate / 8; ++word) {
+                a[word][lane] ^= load64(bytes + 8 * word);
+            }
+        }
+
+        permute(a);
+
+        for (size_t lane = 0; lane < count; ++lane) {
+            if (block + 1 != blocks[lane]) {
+                continue;
+            }
+            for (size_t word = 0; word < KeccakLanes::digestSize / 8; ++word) {
+                store64(a[word][lane], output + lane * KeccakLanes::digestSize + 8 * word);
+            }
+        }
+    }
+}
+
+void hashLanes2(const byte* const* inputs, const size_t* sizes, size_t count, byte* output) {
+    hashLanes<Words2>(inputs, sizes, count, output);
+}
+
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define KECCAK_LANES_X86 1
+
+__attribute__((target("avx2"))) void hashLanes4(const byte* const* inputs, const size_t* sizes, size_t count,
+                                                byte* output) {
+    hashLanes<Words4>(inputs, sizes, count, output);
+}
+
+__attribute__((target("avx512f"))) void hashLanes8(const byte* const* inputs, const size_t* sizes, size_t count,
+                                                   byte* output) {
+    hashLanes<Words8>(inputs, sizes, count, output);
+}
+#endif
+
+} // namespace
+
+bool KeccakLanes::supported(size_t lanes) {
+    switch (lanes) {
+    case 2:
+        return true;
+#ifdef KECCAK_LANES_X86
+    case 4:
+        return __builtin_cpu_supports("avx2");
+    case 8:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return false;
+    }
+}
+
+size_t KeccakLanes::preferredLanes() {
+    static const size_t lanes = supported(8) ? 8 : supported(4) ? 4 : 2;
+    return lanes;
+}
+
+void KeccakLanes::keccak256(const byte* const* inputs, const size_t* sizes, size_t count, byte* output, size_t lanes) {
+    if (!supported(lanes)) {
+        throw std::invalid_argument("Unsupported Keccak lane count");
+    }
+    auto* kernel = hashLanes2;
+#ifdef KECCAK_LANES_X86
+    if (lanes == 4) {
+        kernel = hashLanes4;
+    } else if (lanes == 8) {
+        kernel = hashLanes8;
+    }
+#endif
+    for (size_t first = 0; first < count; first += lanes) {
+        kernel(inputs + first, sizes + first, std::min(lanes, count - first), output + first * digestSize);
+    }
+}
@@ -0,0 +1,29 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+namespace TW::KeccakLanes {
+
+/// Size of a Keccak-256 digest.
+static constexpr size_t digestSize = 32;
+
+/// Whether a multi-lane kernel of the given width (2, 4 or 8) can run on this CPU.  The 2-lane kernel is portable;
+/// the 4- and 8-lane kernels need AVX2 and AVX-512 on x86-64.
+bool supported(size_t lanes);
+
+/// Widest kernel supported by this CPU, picked once at runtime.
+size_t preferredLanes();
+
+/// Computes the Keccak-256 digest of `count` inputs, `lanes` of them at a time through one multi-lane Keccak-f[1600]
+/// permutation.  Writes `count * digestSize` bytes to `output`, in input order.
+///
+/// @throws std::invalid_argument if the kernel is not supported.
+void keccak256(const byte* const* inputs, const size_t* sizes, size_t count, byte* output, size_t lanes);
+
+} // namespace TW::KeccakLanes
@@ -30,7 +30,7 @@ static Data computeMAC(Iter begin, Iter end, const Data& key) {
 
 EncryptionParameters::EncryptionParameters(const Data& password, const Data& data) : mac() {
     auto scryptParams = boost::get<ScryptParameters>(kdfParams);
-    auto derivedKey = Data(scryptParams.desiredKeyLength);
+    auto derivedKey = SecureData(scryptParams.desiredKeyLength);
     scrypt(reinterpret_cast<const byte*>(password.data()), password.size(), scryptParams.salt.data(),
            scryptParams.salt.size(), scryptParams.n, scryptParams.r, scryptParams.p, derivedKey.data(),
            scryptParams.desiredKeyLength);
@@ -52,7 +52,11 @@ EncryptionParameters::~EncryptionParameters() {
 }
 
 Data EncryptionParameters::decrypt(const Data& password) const {
-    auto derivedKey = Data();
+    return insecureData(decryptSecure(password));
+}
+
+SecureData EncryptionParameters::decryptSecure(const Data& password) const {
+    auto derivedKey = SecureData();
     auto mac = Data();
 
     if (kdfParams.which() == 0) {
@@ -77,7 +81,7 @@ Data EncryptionParameters::decrypt(const Data& password) const {
         throw DecryptionError::invalidPassword;
     }
 
-    Data decrypted(encrypted.size());
+    SecureData decrypted(encrypted.size());
     Data iv = cipherParams.iv;
     if (cipher == "aes-128-ctr") {
         aes_encrypt_ctx ctx;
@@ -10,6 +10,7 @@
 #include "PBKDF2Parameters.h"
 #include "ScryptParameters.h"
 #include "../Data.h"
+#include "../SecureMemory.h"
 
 #include <boost/variant.hpp>
 #include <nlohmann/json.hpp>
@@ -62,6 +63,9 @@ struct EncryptionParameters {
     /// Decrypts the payload with the given password.
     Data decrypt(const Data& password) const;
 
+    /// Decrypts the payload with the given password into secure memory.
+    SecureData decryptSecure(const Data& password) const;
+
     /// Saves `this` as a JSON object.
     nlohmann::json json() const;
 
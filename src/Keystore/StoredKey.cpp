@@ -40,7 +40,7 @@ StoredKey StoredKey::createWithMnemonic(const std::string& name, const Data& pas
 StoredKey StoredKey::createWithMnemonicRandom(const std::string& name, const Data& password) {
     const auto wallet = TW::HDWallet(128, "");
     const auto& mnemonic = wallet.mnemonic;
-    assert(Mnemonic::isValid(mnemonic));
+    assert(Mnemonic::isValid(std::string(mnemonic.begin(), mnemonic.end())));
     Data mnemonicData = TW::Data(mnemonic.begin(), mnemonic.end());
     StoredKey key = StoredKey(StoredKeyType::mnemonicPhrase, name, password, mnemonicData);
     return key;
@@ -50,7 +50,7 @@ StoredKey StoredKey::createWithMnemonicAddDefaultAddress(const std::string& name
     StoredKey key = createWithMnemonic(name, password, mnemonic);
 
     const auto wallet = HDWallet(mnemonic, "");
-    const auto derivationPath = TW::derivationPath(coin);
+    const auto& derivationPath = TW::derivationPath(coin);
     const auto address = TW::deriveAddress(coin, wallet.getKey(coin, derivationPath));
     const auto extendedKey = wallet.getExtendedPublicKey(TW::purpose(coin), coin, TW::xpubVersion(coin));
     key.accounts.emplace_back(address, coin, derivationPath, extendedKey);
@@ -71,7 +71,7 @@ StoredKey StoredKey::createWithPrivateKeyAddDefaultAddress(const std::string& na
 
     StoredKey key = createWithPrivateKey(name, password, privateKeyData);
 
-    const auto derivationPath = TW::derivationPath(coin);
+    const auto& derivationPath = TW::derivationPath(coin);
     const auto address = TW::deriveAddress(coin, PrivateKey(privateKeyData));
     key.accounts.emplace_back(address, coin, derivationPath);
 
@@ -84,12 +84,12 @@ StoredKey::StoredKey(StoredKeyType type, std::string name, const Data& password,
     id = boost::lexical_cast<std::string>(gen());
 }
 
-const HDWallet StoredKey::wallet(const Data& password) const {
+HDWallet StoredKey::wallet(const Data& password) const {
     if (type != StoredKeyType::mnemonicPhrase) {
         throw std::invalid_argument("Invalid account requested.");
     }
-    const auto data = payload.decrypt(password);
-    const auto mnemonic = std::string(reinterpret_cast<const char*>(data.data()), data.size());
+    const auto data = payload.decryptSecure(password);
+    const auto mnemonic = std::string_view(reinterpret_cast<const char*>(data.data()), data.size());
     return HDWallet(mnemonic, "");
 }
 
@@ -117,7 +117,7 @@ std::optional<const Account> StoredKey::account(TWCoinType coin, const HDWallet*
         }
     }
 
-    const auto derivationPath = TW::derivationPath(coin);
+    const auto& derivationPath = TW::derivationPath(coin);
     const auto address = wallet->deriveAddress(coin);
     
     const auto version = TW::xpubVersion(coin);
@@ -67,7 +67,7 @@ public:
     /// Returns the HDWallet for this key.
     ///
     /// @throws std::invalid_argument if this key is of a type other than `mnemonicPhrase`.
-    const HDWallet wallet(const Data& password) const;
+    HDWallet wallet(const Data& password) const;
 
     /// Returns the account for a specific coin, creating it if necessary and
     /// the provided wallet is not `nullptr`.
@@ -9,6 +9,7 @@
 #include <TrezorCrypto/bip39_english.h>
 #include <TrezorCrypto/bip39.h>
 
+#include <algorithm>
 #include <string.h>
 #include <string>
 #include <vector>
@@ -22,17 +23,36 @@ bool Mnemonic::isValid(const std::string& mnemonic) {
     return mnemonic_check(mnemonic.c_str()) != 0;
 }
 
-inline const char* const* mnemonicWordlist() { return wordlist; }
+std::vector<bool> Mnemonic::isValidBatch(const std::vector<std::string>& mnemonics) {
+    std::vector<bool> result;
+    result.reserve(mnemonics.size());
+    for (const auto& mnemonic : mnemonics) {
+        result.push_back(isValid(mnemonic));
+    }
+    return result;
+}
 
-bool Mnemonic::isValidWord(const std::string& word) {
+// The word list is sorted, so it serves directly as a binary search index.
+inline const char* const* wordsBegin() { return wordlist; }
+inline const char* const* wordsEnd() { return wordlist + BIP39_WORDS; }
+
+int Mnemonic::wordIndex(const std::string& word) {
     const char* wordC = word.c_str();
-    for (const char* const* w = mnemonicWordlist(); *w != nullptr; ++w) {
-        if (strncmp(*w, wordC, word.length()) == 0) {
-            return true;
-        }
+    const auto found = std::lower_bound(wordsBegin(), wordsEnd(), wordC,
+        [](const char* a, const char* b) { return strcmp(a, b) < 0; });
+    if (found == wordsEnd() || word.length() != strlen(*found) || strcmp(*found, wordC) != 0) {
+        // not found
+        return -1;
     }
-    // not found
-    return false;
+    return static_cast<int>(found - wordsBegin());
+}
+
+bool Mnemonic::isValidWord(const std::string& word) {
+    // words having `word` as a prefix start at the first word not less than it
+    const char* wordC = word.c_str();
+    const auto found = std::lower_bound(wordsBegin(), wordsEnd(), wordC,
+        [](const char* a, const char* b) { return strcmp(a, b) < 0; });
+    return found != wordsEnd() && strncmp(*found, wordC, word.length()) == 0;
 }
 
 std::string Mnemonic::suggest(const std::string& prefix) {
@@ -46,17 +66,14 @@ std::string Mnemonic::suggest(const std::string& prefix) {
         [](unsigned char c){ return std::tolower(c); });
     const char* prefixLoC = prefixLo.c_str();
 
+    // matches are contiguous, starting at the first word not less than the prefix
     std::vector<std::string> result;
-    for (const char* const* word = mnemonicWordlist(); *word != nullptr; ++word) {
-        // check first letter match (optimization)
-        if ((*word)[0] == prefixLo[0]) {
-            if (strncmp(*word, prefixLoC, prefixLo.length()) == 0) {
-                // we have a match
-                result.push_back(*word);
-                if (result.size() >= SuggestMaxCount) {
-                    break; // enough results
-                }
-            }
+    auto word = std::lower_bound(wordsBegin(), wordsEnd(), prefixLoC,
+        [](const char* a, const char* b) { return strcmp(a, b) < 0; });
+    for (; word != wordsEnd() && strncmp(*word, prefixLoC, prefixLo.length()) == 0; ++word) {
+        result.push_back(*word);
+        if (result.size() >= SuggestMaxCount) {
+            break; // enough results
         }
     }
 
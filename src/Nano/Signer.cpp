@@ -6,6 +6,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Signer.h"
+#include "Work.h"
 #include "../BinaryCoding.h"
 #include "../Hash.h"
 #include "../HexCoding.h"
@@ -155,6 +156,23 @@ std::array<byte, 64> Signer::sign() const noexcept {
     return signature;
 }
 
+std::array<byte, 32> Signer::workRoot() const {
+    const bool emptyPrevious = std::all_of(previous.begin(), previous.end(), [](auto b) { return b == 0; });
+    if (!emptyPrevious) {
+        return previous;
+    }
+    std::array<byte, 32> root = {0};
+    std::copy_n(publicKey.bytes.begin(), root.size(), root.begin());
+    return root;
+}
+
+uint64_t Signer::workThreshold() const {
+    if (input.work_threshold() != 0) {
+        return input.work_threshold();
+    }
+    return input.link_oneof_case() == Proto::SigningInput::kLinkBlock ? kWorkThresholdReceive : kWorkThresholdSend;
+}
+
 Proto::SigningOutput Signer::build() const {
     auto output = Proto::SigningOutput();
     const auto signature = sign();
@@ -175,6 +193,8 @@ Proto::SigningOutput Signer::build() const {
 
     if (input.work().size() > 0) {
         json["work"] = input.work();
+    } else if (input.generate_work()) {
+        json["work"] = workString(*generateWork(workRoot(), workThreshold()));
     }
 
     output.set_json(json.dump());
@@ -32,7 +32,14 @@ class Signer {
     /// Signs the blockHash, returns signature bytes
     std::array<byte, 64> sign() const noexcept;
 
-    /// Builds signed transaction, incl. signature, and json format
+    /// Root hashed with the work: the previous block hash, or the account public key for open blocks
+    std::array<byte, 32> workRoot() const;
+
+    /// Minimum work difficulty of the block: the input threshold if set, else the receive threshold when linking a
+    /// block and the send threshold otherwise
+    uint64_t workThreshold() const;
+
+    /// Builds signed transaction, incl. signature, and json format; generates the work if requested and not given
     Proto::SigningOutput build() const;
 };
 
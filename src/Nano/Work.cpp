@@ -0,0 +1,202 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Work.h"
+
+#include "../BinaryCoding.h"
+#include "../HexCoding.h"
+
+#include <TrezorCrypto/blake2b.h>
+#include <TrezorCrypto/rand.h>
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace TW;
+
+namespace {
+
+constexpr uint64_t blake2bIV[8] = {
+    0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+    0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179,
+};
+
+constexpr uint8_t blake2bSigma[12][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+};
+
+/// Work size plus root size
+constexpr uint64_t messageSize = 8 + 32;
+/// Initial hash word 0 for an unkeyed 8-byte digest
+constexpr uint64_t initialHash = blake2bIV[0] ^ 0x01010000 ^ 8;
+
+/// Nonces hashed together; the lane loops are written so the compiler can map them to vector registers
+constexpr size_t lanes = 8;
+/// Nonces a thread hashes between checks of the stop flags
+constexpr uint64_t batchSize = 1 << 14;
+
+inline uint64_t rotr(uint64_t value, int bits) {
+    return (value >> bits) | (value << (64 - bits));
+}
+
+using LaneWords = uint64_t[lanes];
+
+inline void mix(LaneWords* v, int a, int b, int c, int d, const LaneWords& x, const LaneWords& y) {
+    for (size_t l = 0; l < lanes; ++l) {
+        v[a][l] = v[a][l] + v[b][l] + x[l];
+        v[d][l] = rotr(v[d][l] ^ v[a][l], 32);
+        v[c][l] = v[c][l] + v[d][l];
+        v[b][l] = rotr(v[b][l] ^ v[c][l], 24);
+        v[a][l] = v[a][l] + v[b][l] + y[l];
+        v[d][l] = rotr(v[d][l] ^ v[a][l], 16);
+        v[c][l] = v[c][l] + v[d][l];
+        v[b][l] = rotr(v[b][l] ^ v[c][l], 63);
+    }
+}
+
+/// Blake2b reduced to the single final block of a work message and the first output word
+class WorkHasher {
+  public:
+    explicit WorkHasher(const std::array<byte, 32>& root) {
+        for (auto& word : message) {
+            std::fill(std::begin(word), std::end(word), 0);
+        }
+        for (size_t i = 0; i < 4; ++i) {
+            std::fill(std::begin(message[i + 1]), std::end(message[i + 1]), decode64LE(root.data() + 8 * i));
+        }
+    }
+
+    /// Computes the difficulties of the `lanes` nonces starting at `first`.
+    void difficulties(uint64_t first, LaneWords& result) {
+        for (size_t l = 0; l < lanes; ++l) {
+            message[0][l] = first + l;
+        }
+
+        LaneWords v[16];
+        for (size_t i = 0; i < 8; ++i) {
+            std::fill(std::begin(v[i]), std::end(v[i]), i == 0 ? initialHash : blake2bIV[i]);
+            std::fill(std::begin(v[i + 8]), std::end(v[i + 8]), blake2bIV[i]);
+        }
+        for (size_t l = 0; l < lanes; ++l) {
+            v[12][l] ^= messageSize;
+            v[14][l] = ~v[14][l];
+        }
+
+        for (const auto& s : blake2bSigma) {
+            mix(v, 0, 4, 8, 12, message[s[0]], message[s[1]]);
+            mix(v, 1, 5, 9, 13, message[s[2]], message[s[3]]);
+            mix(v, 2, 6, 10, 14, message[s[4]], message[s[5]]);
+            mix(v, 3, 7, 11, 15, message[s[6]], message[s[7]]);
+            mix(v, 0, 5, 10, 15, message[s[8]], message[s[9]]);
+            mix(v, 1, 6, 11, 12, message[s[10]], message[s[11]]);
+            mix(v, 2, 7, 8, 13, message[s[12]], message[s[13]]);
+            mix(v, 3, 4, 9, 14, message[s[14]], message[s[15]]);
+        }
+
+        for (size_t l = 0; l < lanes; ++l) {
+            result[l] = initialHash ^ v[0][l] ^ v[8][l];
+        }
+    }
+
+  private:
+    LaneWords message[16];
+};
+
+} // namespace
+
+namespace TW::Nano {
+
+uint64_t workDifficulty(const std::array<byte, 32>& root, uint64_t work) {
+    byte workBytes[8];
+    for (size_t i = 0; i < sizeof(workBytes); ++i) {
+        workBytes[i] = static_cast<byte>(work >> (8 * i));
+    }
+    blake2b_state state;
+    blake2b_Init(&state, 8);
+    blake2b_Update(&state, workBytes, sizeof(workBytes));
+    blake2b_Update(&state, root.data(), root.size());
+    byte hash[8];
+    blake2b_Final(&state, hash, sizeof(hash));
+    return decode64LE(hash);
+}
+
+std::optional<uint64_t> generateWork(const std::array<byte, 32>& root, uint64_t threshold, unsigned threads,
+                                     const std::atomic<bool>* cancel) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    uint64_t start = 0;
+    random_buffer(reinterpret_cast<uint8_t*>(&start), sizeof(start));
+
+    std::atomic<bool> found{false};
+    std::atomic<uint64_t> result{0};
+
+    // thread i hashes batches i, i + threads, i + 2 * threads, ...
+    const auto search = [&](unsigned index) {
+        auto hasher = WorkHasher(root);
+        LaneWords difficulties;
+        for (uint64_t batch = index;; batch += threads) {
+            if (found.load(std::memory_order_relaxed) || (cancel != nullptr && cancel->load(std::memory_order_relaxed))) {
+                return;
+            }
+            const uint64_t base = start + batch * batchSize;
+            for (uint64_t offset = 0; offset < batchSize; offset += lanes) {
+                hasher.difficulties(base + offset, difficulties);
+                for (size_t l = 0; l < lanes; ++l) {
+                    if (difficulties[l] >= threshold) {
+                        if (!found.exchange(true)) {
+                            result = base + offset + l;
+                        }
+                        return;
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; ++i) {
+        workers.emplace_back(search, i);
+    }
+    search(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (!found) {
+        return std::nullopt;
+    }
+    return result.load();
+}
+
+std::string workString(uint64_t work) {
+    return hex(work);
+}
+
+uint64_t parseWork(const std::string& string) {
+    if (string.empty() || string.size() > 16 ||
+        !std::all_of(string.begin(), string.end(), [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); })) {
+        throw std::invalid_argument("Invalid work");
+    }
+    return std::stoull(string, nullptr, 16);
+}
+
+} // namespace TW::Nano
@@ -0,0 +1,49 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Data.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace TW::Nano {
+
+/// Minimum work difficulty of send and change blocks (epoch 2).
+constexpr uint64_t kWorkThresholdSend = 0xfffffff800000000;
+/// Minimum work difficulty of receive and open blocks (epoch 2).
+constexpr uint64_t kWorkThresholdReceive = 0xfffffe0000000000;
+
+/// Difficulty of `work` for a block root (previous block hash, or account public key for open blocks): the
+/// 8-byte Blake2b hash of the little-endian work followed by the root, read as a little-endian integer.
+uint64_t workDifficulty(const std::array<byte, 32>& root, uint64_t work);
+
+/// Whether `work` reaches the threshold for the root.
+inline bool validateWork(const std::array<byte, 32>& root, uint64_t work, uint64_t threshold) {
+    return workDifficulty(root, work) >= threshold;
+}
+
+/// Searches a work value reaching the threshold for the root, on `threads` threads (0: one per hardware thread).
+/// Each thread hashes several nonces per step with a Blake2b specialized for the 40-byte work message, and all
+/// threads stop as soon as one finds a solution.  The search starts from a random nonce.
+///
+/// @returns the work, or nothing if `cancel` was set before a solution was found.
+std::optional<uint64_t> generateWork(const std::array<byte, 32>& root, uint64_t threshold, unsigned threads = 0,
+                                     const std::atomic<bool>* cancel = nullptr);
+
+/// Work in the block JSON format: 16 hex digits, most significant first.
+std::string workString(uint64_t work);
+
+/// Parses work in the block JSON format.
+///
+/// @throws std::invalid_argument if it isn't at most 16 hex digits.
+uint64_t parseWork(const std::string& string);
+
+} // namespace TW::Nano
@@ -0,0 +1,164 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "PBKDF2.h"
+
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/pbkdf2.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace TW;
+
+namespace {
+
+/// One 64-bit word from each lane; the compiler maps this onto SIMD registers where available.
+typedef uint64_t Words __attribute__((vector_size(sizeof(uint64_t) * PBKDF2::lanes)));
+
+constexpr uint64_t K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+inline Words splat(uint64_t value) {
+    Words result;
+    for (size_t i = 0; i < PBKDF2::lanes; ++i) {
+        result[i] = value;
+    }
+    return result;
+}
+
+inline Words rotr(Words x, int n) {
+    return (x >> n) | (x << (64 - n));
+}
+
+/// SHA-512 compression of one block made of a 64-byte digest followed by the fixed HMAC padding
+/// (0x80, zeros, bit length of key pad + digest), as used by every PBKDF2 iteration.
+void transformDigestBlock(const Words state[8], Words digest[8]) {
+    Words w[80];
+    std::copy(digest, digest + 8, w);
+    w[8] = splat(0x8000000000000000ULL);
+    for (int i = 9; i < 15; ++i) {
+        w[i] = splat(0);
+    }
+    w[15] = splat(uint64_t(SHA512_BLOCK_LENGTH + SHA512_DIGEST_LENGTH) * 8);
+    for (int i = 16; i < 80; ++i) {
+        const Words s0 = rotr(w[i - 15], 1) ^ rotr(w[i - 15], 8) ^ (w[i - 15] >> 7);
+        const Words s1 = rotr(w[i - 2], 19) ^ rotr(w[i - 2], 61) ^ (w[i - 2] >> 6);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    Words a = state[0], b = state[1], c = state[2], d = state[3];
+    Words e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 80; ++i) {
+        const Words t1 = h + (rotr(e, 14) ^ rotr(e, 18) ^ rotr(e, 41)) + ((e & f) ^ (~e & g)) + splat(K[i]) + w[i];
+        const Words t2 = (rotr(a, 28) ^ rotr(a, 34) ^ rotr(a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    digest[0] = state[0] + a;
+    digest[1] = state[1] + b;
+    digest[2] = state[2] + c;
+    digest[3] = state[3] + d;
+    digest[4] = state[4] + e;
+    digest[5] = state[5] + f;
+    digest[6] = state[6] + g;
+    digest[7] = state[7] + h;
+}
+
+/// Derives the keys of `count` (at most `lanes`) inputs starting at `first`.
+void deriveLanes(const PBKDF2::Input* first, size_t count, uint32_t iterations, std::array<byte, PBKDF2::sha512Size>* out) {
+    // the inner/outer pad states and the first iteration are computed per lane by trezor-crypto;
+    // unused lanes repeat the first input
+    Words inner[8], outer[8], u[8], key[8];
+    for (size_t lane = 0; lane < PBKDF2::lanes; ++lane) {
+        const auto& input = first[lane < count ? lane : 0];
+        PBKDF2_HMAC_SHA512_CTX ctx;
+        pbkdf2_hmac_sha512_Init(&ctx, reinterpret_cast<const uint8_t*>(input.password.data()), static_cast<int>(input.password.size()),
+                                input.salt.data(), static_cast<int>(input.salt.size()), 1);
+        for (int i = 0; i < 8; ++i) {
+            inner[i][lane] = ctx.idig[i];
+            outer[i][lane] = ctx.odig[i];
+            u[i][lane] = ctx.g[i];
+            key[i][lane] = ctx.f[i];
+        }
+        memzero(&ctx, sizeof(ctx));
+    }
+
+    for (uint32_t iteration = 1; iteration < iterations; ++iteration) {
+        transformDigestBlock(inner, u);
+        transformDigestBlock(outer, u);
+        for (int i = 0; i < 8; ++i) {
+            key[i] ^= u[i];
+        }
+    }
+
+    for (size_t lane = 0; lane < count; ++lane) {
+        for (int i = 0; i < 8; ++i) {
+            const uint64_t word = key[i][lane];
+            for (int j = 0; j < 8; ++j) {
+                out[lane][i * 8 + j] = static_cast<byte>(word >> (56 - 8 * j));
+            }
+        }
+    }
+    memzero(inner, sizeof(inner));
+    memzero(outer, sizeof(outer));
+    memzero(u, sizeof(u));
+    memzero(key, sizeof(key));
+}
+
+} // namespace
+
+std::vector<std::array<byte, PBKDF2::sha512Size>> PBKDF2::hmacSha512(const std::vector<Input>& inputs, uint32_t iterations, unsigned threads) {
+    std::vector<std::array<byte, sha512Size>> keys(inputs.size());
+    const size_t chunks = (inputs.size() + lanes - 1) / lanes;
+    const auto deriveChunks = [&](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; ++chunk) {
+            const auto first = chunk * lanes;
+            deriveLanes(&inputs[first], std::min(lanes, inputs.size() - first), iterations, &keys[first]);
+        }
+    };
+
+    const auto workers = std::min<size_t>(std::max(threads, 1u), chunks);
+    if (workers <= 1) {
+        deriveChunks(0, chunks);
+        return keys;
+    }
+    std::vector<std::thread> pool;
+    const auto perWorker = (chunks + workers - 1) / workers;
+    for (size_t begin = 0; begin < chunks; begin += perWorker) {
+        pool.emplace_back(deriveChunks, begin, std::min(begin + perWorker, chunks));
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return keys;
+}
@@ -0,0 +1,37 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace TW::PBKDF2 {
+
+/// Number of derivations interleaved by the multi-lane SHA-512 core.
+static constexpr size_t lanes = 4;
+
+/// Size of a PBKDF2-HMAC-SHA512 output block.
+static constexpr size_t sha512Size = 64;
+
+/// A password and salt to derive a key from.
+struct Input {
+    std::string password;
+    Data salt;
+};
+
+/// Computes a single-block (64 byte) PBKDF2-HMAC-SHA512 key for each input, all with the same
+/// number of iterations.  Inputs are processed `lanes` at a time through a multi-lane SHA-512
+/// transform (vectorized where the target supports it), and chunks of lanes are spread over up
+/// to `threads` worker threads.
+///
+/// \returns one key per input, in input order.
+std::vector<std::array<byte, sha512Size>> hmacSha512(const std::vector<Input>& inputs, uint32_t iterations, unsigned threads = 1);
+
+} // namespace TW::PBKDF2
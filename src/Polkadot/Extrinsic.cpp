@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Extrinsic.h"
+#include "../Hash.h"
 #include <TrustWalletCore/TWSS58AddressType.h>
 #include <map>
 
@@ -13,12 +14,15 @@ using namespace TW::Polkadot;
 
 static constexpr uint8_t signedBit = 0x80;
 static constexpr uint8_t sigTypeEd25519 = 0x00;
+static constexpr size_t accountIdSize = 32;
+static constexpr size_t signatureSize = 64;
 static constexpr uint8_t extrinsicFormat = 4;
 static constexpr uint32_t multiAddrSpecVersion = 28;
 static constexpr uint32_t multiAddrSpecVersionKsm = 2028;
 
 static const std::string balanceTransfer = "Balances.transfer";
 static const std::string utilityBatch = "Utility.batch";
+static const std::string utilityBatchAll = "Utility.batch_all";
 static const std::string stakingBond = "Staking.bond";
 static const std::string stakingBondExtra = "Staking.bond_extra";
 static const std::string stakingUnbond = "Staking.unbond";
@@ -30,6 +34,7 @@ static const std::string stakingChill = "Staking.chill";
 static std::map<const std::string, Data> polkadotCallIndices = {
     {balanceTransfer,       Data{0x05, 0x00}},
     {utilityBatch,          Data{0x1a, 0x00}},
+    {utilityBatchAll,       Data{0x1a, 0x02}},
     {stakingBond,           Data{0x07, 0x00}},
     {stakingBondExtra,      Data{0x07, 0x01}},
     {stakingUnbond,         Data{0x07, 0x02}},
@@ -40,6 +45,7 @@ static std::map<const std::string, Data> polkadotCallIndices = {
 
 static std::map<const std::string, Data> kusamaCallIndices = {
     {balanceTransfer,       Data{0x04, 0x00}},
+    {utilityBatchAll,       Data{0x18, 0x02}},
     {stakingBond,           Data{0x06, 0x00}},
     {stakingBondExtra,      Data{0x06, 0x01}},
     {stakingUnbond,         Data{0x06, 0x02}},
@@ -65,15 +71,13 @@ bool Extrinsic::encodeRawAccount(TWSS58AddressType network, uint32_t specVersion
     return true;
 }
 
-Data Extrinsic::encodeEraNonceTip() const {
-    Data data;
+void Extrinsic::encodeEraNonceTip(const Data& era, uint64_t nonce, const uint256_t& tip, Data& data) {
     // era
     append(data, era);
     // nonce
-    append(data, encodeCompact(nonce));
+    encodeCompact(nonce, data);
     // tip
-    append(data, encodeCompact(tip));
-    return data;
+    encodeCompact(tip, data);
 }
 
 Data Extrinsic::encodeCall(const Proto::SigningInput& input) {
@@ -96,9 +100,9 @@ Data Extrinsic::encodeBalanceCall(const Proto::Balance& balance, TWSS58AddressTy
     // call index
     append(data, getCallIndex(network, balanceTransfer));
     // destination
-    append(data, encodeAccountId(address.keyBytes(), encodeRawAccount(network, specVersion)));
+    encodeAccountId(address.keyBytes(), encodeRawAccount(network, specVersion), data);
     // value
-    append(data, encodeCompact(value));
+    encodeCompact(value, data);
     return data;
 }
 
@@ -120,9 +124,9 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
                 // call index
                 append(data, getCallIndex(network, stakingBond));
                 // controller
-                append(data, encodeAccountId(address.keyBytes(), encodeRawAccount(network, specVersion)));
+                encodeAccountId(address.keyBytes(), encodeRawAccount(network, specVersion), data);
                 // value
-                append(data, encodeCompact(value));
+                encodeCompact(value, data);
                 // reward destination
                 append(data, reward);
             }
@@ -165,7 +169,7 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
                 // call index
                 append(data, getCallIndex(network, stakingBondExtra));
                 // value
-                append(data, encodeCompact(value));
+                encodeCompact(value, data);
             }
             break;
 
@@ -175,7 +179,7 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
                 // call index
                 append(data, getCallIndex(network, stakingUnbond));
                 // value
-                append(data, encodeCompact(value));
+                encodeCompact(value, data);
             }
             break;
 
@@ -213,12 +217,14 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
     return data;
 }
 
-Data Extrinsic::encodePayload() const {
-    Data data;
+void Extrinsic::encodePayload(const Data& call, const Data& era, uint64_t nonce, const uint256_t& tip, uint32_t specVersion,
+                              uint32_t version, const Data& genesisHash, const Data& blockHash, Data& data) {
+    // call, era, nonce and tip (at most 17 + 33 bytes), versions, hashes
+    data.reserve(data.size() + call.size() + era.size() + 50 + 8 + genesisHash.size() + blockHash.size());
     // call
     append(data, call);
     // era / nonce / tip
-    append(data, encodeEraNonceTip());
+    encodeEraNonceTip(era, nonce, tip, data);
     // specVersion
     encode32LE(specVersion, data);
     // transactionVersion
@@ -227,24 +233,139 @@ Data Extrinsic::encodePayload() const {
     append(data, genesisHash);
     // block hash
     append(data, blockHash);
+}
+
+Data Extrinsic::encodePayload() const {
+    Data data;
+    encodePayload(call, era, nonce, tip, specVersion, version, genesisHash, blockHash, data);
     return data;
 }
 
 Data Extrinsic::encodeSignature(const PublicKey& signer, const Data& signature) const {
+    const auto rawAccount = encodeRawAccount(network, specVersion);
+    const size_t length = 1 + (rawAccount ? 0 : 1) + signer.bytes.size() + 1 + signature.size()
+        + era.size() + compactSize(nonce) + compactSize(tip) + call.size();
     Data data;
+    data.reserve(compactSize(length) + length);
+    // length prefix
+    encodeCompact(length, data);
     // version header
-    append(data, Data{extrinsicFormat | signedBit});
+    data.push_back(extrinsicFormat | signedBit);
     // signer public key
-    append(data, encodeAccountId(signer.bytes, encodeRawAccount(network, specVersion)));
+    encodeAccountId(signer.bytes, rawAccount, data);
     // signature type
-    append(data, sigTypeEd25519);
+    data.push_back(sigTypeEd25519);
     // signature
     append(data, signature);
     // era / nonce / tip
-    append(data, encodeEraNonceTip());
+    encodeEraNonceTip(era, nonce, tip, data);
     // call
     append(data, call);
-    // append length
-    encodeLengthPrefix(data);
     return data;
 }
+
+std::optional<SignedExtrinsic> Extrinsic::decode(const Data& encoded, TWSS58AddressType network, uint32_t specVersion) {
+    auto decoder = ScaleDecoder(encoded);
+    uint64_t length = 0;
+    if (!decoder.decodeCompact(length) || length != decoder.remaining()) {
+        return std::nullopt;
+    }
+    const byte* header = nullptr;
+    if (!decoder.read(1, header) || *header != (extrinsicFormat | signedBit)) {
+        return std::nullopt;
+    }
+
+    SignedExtrinsic extrinsic;
+    if (!encodeRawAccount(network, specVersion)) {
+        // MultiAddress::AccountId
+        const byte* addressType = nullptr;
+        if (!decoder.read(1, addressType) || *addressType != 0x00) {
+            return std::nullopt;
+        }
+    }
+    const byte* sigType = nullptr;
+    const byte* eraFirst = nullptr;
+    if (!decoder.read(accountIdSize, extrinsic.signer) ||
+        !decoder.read(1, sigType) || *sigType != sigTypeEd25519 ||
+        !decoder.read(signatureSize, extrinsic.signature) ||
+        !decoder.read(1, eraFirst)) {
+        return std::nullopt;
+    }
+    // immortal era is a single zero byte, mortal era two bytes
+    extrinsic.era.push_back(*eraFirst);
+    if (*eraFirst != 0) {
+        const byte* eraSecond = nullptr;
+        if (!decoder.read(1, eraSecond)) {
+            return std::nullopt;
+        }
+        extrinsic.era.push_back(*eraSecond);
+    }
+    if (!decoder.decodeCompact(extrinsic.nonce) || !decoder.decodeCompact(extrinsic.tip)) {
+        return std::nullopt;
+    }
+    // the call is the rest
+    decoder.read(decoder.remaining(), extrinsic.call);
+    return extrinsic;
+}
+
+bool SignedExtrinsic::verify(uint32_t specVersion, uint32_t version, const Data& genesisHash, const Data& blockHash) const {
+    Data payload;
+    Extrinsic::encodePayload(call, era, nonce, tip, specVersion, version, genesisHash, blockHash, payload);
+    if (payload.size() > payloadHashThreshold) {
+        payload = Hash::blake2b(payload, 32);
+    }
+    return PublicKey(signer, TWPublicKeyTypeED25519).verify(signature, payload);
+}
+
+TransferBatchBuilder::TransferBatchBuilder(TWSS58AddressType network, uint32_t specVersion, size_t maxCallSize, size_t maxCalls)
+    : network(network)
+    , rawAccount(Extrinsic::encodeRawAccount(network, specVersion))
+    , maxCallSize(maxCallSize)
+    , maxCalls(maxCalls)
+    , transferIndex(getCallIndex(network, balanceTransfer))
+    , batchIndex(getCallIndex(network, utilityBatchAll)) {}
+
+void TransferBatchBuilder::add(const std::string& toAddress, const uint256_t& value) {
+    auto account = accounts.find(toAddress);
+    if (account == accounts.end()) {
+        auto address = SS58Address(toAddress, network);
+        account = accounts.emplace(toAddress, encodeAccountId(address.keyBytes(), rawAccount)).first;
+    }
+
+    // start a new batch if this transfer does not fit in the current one
+    const auto transferSize = transferIndex.size() + account->second.size() + compactSize(value);
+    const auto batchSize = batchIndex.size() + compactSize(transferCount + 1) + transfers.size() + transferSize;
+    if (transferCount > 0 && (batchSize > maxCallSize || transferCount + 1 > maxCalls)) {
+        flush();
+    }
+
+    // call index
+    append(transfers, transferIndex);
+    // destination
+    append(transfers, account->second);
+    // value
+    encodeCompact(value, transfers);
+    ++transferCount;
+}
+
+void TransferBatchBuilder::flush() {
+    if (transferCount == 0) {
+        return;
+    }
+    Data call;
+    call.reserve(batchIndex.size() + compactSize(transferCount) + transfers.size());
+    append(call, batchIndex);
+    encodeCompact(transferCount, call);
+    append(call, transfers);
+    batches.push_back(std::move(call));
+    transfers.clear();
+    transferCount = 0;
+}
+
+std::vector<Data> TransferBatchBuilder::finish() {
+    flush();
+    // a moved-from vector isn't guaranteed to be empty; clear it explicitly to reset the builder
+    auto result = std::move(batches);
+    batches.clear();
+    return result;
+}
@@ -12,8 +12,30 @@
 #include "../uint256.h"
 #include  "ScaleCodec.h"
 
+#include <optional>
+#include <unordered_map>
+
 namespace TW::Polkadot {
 
+/// Payloads longer than this are hashed before signing.
+static constexpr size_t payloadHashThreshold = 256;
+
+/// A signed extrinsic, as decoded from its encoding.
+struct SignedExtrinsic {
+    // signer public key (ed25519)
+    Data signer;
+    Data signature;
+    // encoded Era data
+    Data era;
+    uint64_t nonce = 0;
+    uint256_t tip;
+    // encoded Call data
+    Data call;
+
+    /// Verifies the signature, given the chain parameters which are signed but not part of the extrinsic.
+    bool verify(uint32_t specVersion, uint32_t version, const Data& genesisHash, const Data& blockHash) const;
+};
+
 // ExtrinsicV4
 class Extrinsic {
   public:
@@ -33,13 +55,17 @@ class Extrinsic {
     // network
     TWSS58AddressType network;
 
-    Extrinsic(const Proto::SigningInput& input)
+    Extrinsic(const Proto::SigningInput& input) : Extrinsic(input, encodeCall(input)) {}
+
+    /// Initializes with an already encoded call instead of the one in the input.
+    Extrinsic(const Proto::SigningInput& input, Data call)
         : blockHash(input.block_hash().begin(), input.block_hash().end())
         , genesisHash(input.genesis_hash().begin(), input.genesis_hash().end())
         , nonce(input.nonce())
         , specVersion(input.spec_version())
         , version(input.transaction_version())
-        , tip(load(input.tip())) {
+        , tip(load(input.tip()))
+        , call(std::move(call)) {
         if (input.has_era()) {
             era = encodeEra(input.era().block_number(), input.era().period());
         } else {
@@ -47,7 +73,6 @@ class Extrinsic {
           era = encodeCompact(0);
         }
         network = TWSS58AddressType(input.network());
-        call = encodeCall(input);
     }
 
     static Data encodeCall(const Proto::SigningInput& input);
@@ -56,12 +81,51 @@ class Extrinsic {
     // Encode final data with signer public key and signature.
     Data encodeSignature(const PublicKey& signer, const Data& signature) const;
 
-  protected:
+    /// Decodes a signed extrinsic (length prefixed, as produced by encodeSignature).  The network and spec version
+    /// determine how the signer account is encoded.  Returns nullopt if the data is malformed or not ed25519 signed.
+    static std::optional<SignedExtrinsic> decode(const Data& encoded, TWSS58AddressType network, uint32_t specVersion);
+
+    /// Appends the payload to sign for the given fields.
+    static void encodePayload(const Data& call, const Data& era, uint64_t nonce, const uint256_t& tip, uint32_t specVersion,
+                              uint32_t version, const Data& genesisHash, const Data& blockHash, Data& data);
+
     static bool encodeRawAccount(TWSS58AddressType network, uint32_t specVersion);
+
+  protected:
     static Data encodeBalanceCall(const Proto::Balance& balance, TWSS58AddressType network, uint32_t specVersion);
     static Data encodeStakingCall(const Proto::Staking& staking, TWSS58AddressType network, uint32_t specVersion);
     static Data encodeBatchCall(const std::vector<Data>& calls, TWSS58AddressType network);
-    Data encodeEraNonceTip() const;
+    static void encodeEraNonceTip(const Data& era, uint64_t nonce, const uint256_t& tip, Data& data);
+};
+
+/// Builds utility.batch_all calls of balances.transfer, for large payouts.  Each transfer is encoded straight
+/// into the batch being built, destination account ids are decoded once per distinct address, and a new batch is
+/// started whenever the current one would exceed `maxCallSize` bytes or `maxCalls` calls.
+class TransferBatchBuilder {
+  public:
+    TransferBatchBuilder(TWSS58AddressType network, uint32_t specVersion, size_t maxCallSize, size_t maxCalls);
+
+    /// Adds a transfer; throws std::invalid_argument if the address is not valid for the network.
+    void add(const std::string& toAddress, const uint256_t& value);
+
+    /// Returns the encoded batch_all calls, one per extrinsic, and resets the builder.
+    std::vector<Data> finish();
+
+  private:
+    void flush();
+
+    TWSS58AddressType network;
+    bool rawAccount;
+    size_t maxCallSize;
+    size_t maxCalls;
+    Data transferIndex;
+    Data batchIndex;
+    // encoded destination by address
+    std::unordered_map<std::string, Data> accounts;
+    // encoded transfers of the current batch
+    Data transfers;
+    size_t transferCount = 0;
+    std::vector<Data> batches;
 };
 
 } // namespace TW::Polkadot
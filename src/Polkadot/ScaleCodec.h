@@ -10,14 +10,15 @@
 #include "../Data.h"
 #include "../PublicKey.h"
 #include "../SS58Address.h"
-#include <boost/multiprecision/cpp_int.hpp>
+#include "../uint256.h"
 #include <cmath>
 #include <algorithm>
 #include <bitset>
+#include <limits>
 
 
 /// Reference https://github.com/soramitsu/kagome/blob/master/core/scale/scale_encoder_stream.cpp
-using CompactInteger = boost::multiprecision::cpp_int;
+/// Compact integers are handled as fixed width `uint64_t` or `uint256_t` (balances are u128), with no heap allocation.
 
 namespace TW::Polkadot {
 
@@ -25,57 +26,82 @@ static constexpr size_t kMinUint16 = (1ul << 6u);
 static constexpr size_t kMinUint32 = (1ul << 14u);
 static constexpr size_t kMinBigInteger = (1ul << 30u);
 
-inline size_t countBytes(CompactInteger value) {
+inline size_t countBytes(uint64_t value) {
+    size_t size = 1;
+    while (value >>= 8) {
+        ++size;
+    }
+    return size;
+}
+
+inline size_t countBytes(const uint256_t& value) {
     if (0 == value) {
         return 1;
     }
+    return boost::multiprecision::msb(value) / 8 + 1;
+}
 
-    size_t size = 0;
-    while (value > 0) {
-        ++size;
-        value >>= 8;
+/// Size of the compact encoding of a value.
+inline size_t compactSize(uint64_t value) {
+    if (value < kMinUint16) {
+        return 1;
+    } else if (value < kMinUint32) {
+        return 2;
+    } else if (value < kMinBigInteger) {
+        return 4;
     }
-
-    return size;
+    return 1 + countBytes(value);
 }
 
-inline Data encodeCompact(CompactInteger value) {
-    auto data = Data{};
+/// Size of the compact encoding of a value.
+inline size_t compactSize(const uint256_t& value) {
+    if (value <= std::numeric_limits<uint64_t>::max()) {
+        return compactSize(value.convert_to<uint64_t>());
+    }
+    return 1 + countBytes(value);
+}
 
+/// Appends the compact encoding of a value.
+inline void encodeCompact(uint64_t value, Data& data) {
     if (value < kMinUint16) {
-        auto v = value.convert_to<uint8_t>() << 2u;
-        data.push_back(static_cast<uint8_t>(v));
-        return data;
+        data.push_back(static_cast<uint8_t>(value << 2u));
     } else if (value < kMinUint32) {
-        auto v = (value.convert_to<uint16_t>() << 2u);
-        v += 0x01; // set 0b01 flag
-        auto minor_byte = static_cast<uint8_t>(v & 0xffu);
-        data.push_back(minor_byte);
-        v >>= 8u;
-        auto major_byte = static_cast<uint8_t>(v & 0xffu);
-        data.push_back(major_byte);
-        return data;
+        encode16LE(static_cast<uint16_t>((value << 2u) + 0x01), data); // set 0b01 flag
     } else if (value < kMinBigInteger) {
-        uint32_t v = (value.convert_to<uint32_t>() << 2u);
-        v += 0x02; // set 0b10 flag
-        encode32LE(v, data);
-        return data;
+        encode32LE(static_cast<uint32_t>((value << 2u) + 0x02), data); // set 0b10 flag
+    } else {
+        const auto length = countBytes(value);
+        data.push_back(static_cast<uint8_t>((length - 4) * 4 + 0x03)); // set 0b11 flag
+        for (size_t i = 0; i < length; ++i) {
+            data.push_back(static_cast<uint8_t>(value >> (8 * i))); // least significant byte first
+        }
     }
+}
 
-    auto length = countBytes(value);
-    if (length > 67) {
-        // too big
-        return data;
+/// Appends the compact encoding of a value.
+inline void encodeCompact(const uint256_t& value, Data& data) {
+    if (value <= std::numeric_limits<uint64_t>::max()) {
+        encodeCompact(value.convert_to<uint64_t>(), data);
+        return;
     }
-    uint8_t header = (static_cast<uint8_t>(length) - 4) * 4;
-    header += 0x03; // set 0b11 flag;
-    data.push_back(header);
-
-    auto v = CompactInteger{value};
+    const auto length = countBytes(value);
+    data.push_back(static_cast<uint8_t>((length - 4) * 4 + 0x03)); // set 0b11 flag
+    auto v = value;
     for (size_t i = 0; i < length; ++i) {
         data.push_back(static_cast<uint8_t>(v & 0xff)); // push back least significant byte
         v >>= 8;
     }
+}
+
+inline Data encodeCompact(uint64_t value) {
+    auto data = Data{};
+    encodeCompact(value, data);
+    return data;
+}
+
+inline Data encodeCompact(const uint256_t& value) {
+    auto data = Data{};
+    encodeCompact(value, data);
     return data;
 }
 
@@ -92,29 +118,34 @@ inline Data encodeBool(bool value) {
 
 inline Data encodeVector(const std::vector<Data>& vec) {
     auto data = encodeCompact(vec.size());
-    for (auto v : vec) {
+    for (const auto& v : vec) {
         append(data, v);
     }
     return data;
 }
 
-inline Data encodeAccountId(const Data& bytes, bool raw) {
-    auto data = Data{};
+/// Appends an account id, as MultiAddress::AccountId unless `raw`.
+inline void encodeAccountId(const Data& bytes, bool raw, Data& data) {
     if (!raw) {
         // MultiAddress::AccountId
         // https://github.com/paritytech/substrate/blob/master/primitives/runtime/src/multiaddress.rs#L28
         append(data, 0x00);
     }
     append(data, bytes);
+}
+
+inline Data encodeAccountId(const Data& bytes, bool raw) {
+    auto data = Data{};
+    encodeAccountId(bytes, raw, data);
     return data;
 }
 
 inline Data encodeAccountIds(const std::vector<SS58Address>& addresses, bool raw) {
-    std::vector<Data> vec;
-    for (auto addr : addresses) {
-        vec.push_back(encodeAccountId(addr.keyBytes(), raw));
+    auto data = encodeCompact(addresses.size());
+    for (const auto& addr : addresses) {
+        encodeAccountId(addr.keyBytes(), raw, data);
     }
-    return encodeVector(vec);
+    return data;
 }
 
 inline Data encodeEra(const uint64_t block, const uint64_t period) {
@@ -140,4 +171,117 @@ inline Data encodeEra(const uint64_t block, const uint64_t period) {
     return Data{byte(encoded & 0xff), byte(encoded >> 8)};
 }
 
+/// Reads SCALE encoded values from a byte range, without copying.  A read returns false, and consumes
+/// nothing, if the input is too short or not canonically encoded.
+class ScaleDecoder {
+  public:
+    ScaleDecoder(const byte* data, size_t size) : current(data), end(data + size) {}
+    explicit ScaleDecoder(const Data& data) : ScaleDecoder(data.data(), data.size()) {}
+
+    size_t remaining() const { return static_cast<size_t>(end - current); }
+
+    bool decodeCompact(uint64_t& value) {
+        uint256_t big;
+        if (!decodeCompactBytes(8, big)) {
+            return false;
+        }
+        value = big.convert_to<uint64_t>();
+        return true;
+    }
+
+    bool decodeCompact(uint256_t& value) { return decodeCompactBytes(32, value); }
+
+    bool decodeBool(bool& value) {
+        if (remaining() < 1 || current[0] > 1) {
+            return false;
+        }
+        value = *current++ == 1;
+        return true;
+    }
+
+    bool decode32LE(uint32_t& value) {
+        if (remaining() < 4) {
+            return false;
+        }
+        value = TW::decode32LE(current);
+        current += 4;
+        return true;
+    }
+
+    /// Returns a view of the next `size` bytes.
+    bool read(size_t size, const byte*& bytes) {
+        if (remaining() < size) {
+            return false;
+        }
+        bytes = current;
+        current += size;
+        return true;
+    }
+
+    bool read(size_t size, Data& bytes) {
+        const byte* view = nullptr;
+        if (!read(size, view)) {
+            return false;
+        }
+        bytes.assign(view, view + size);
+        return true;
+    }
+
+  private:
+    bool decodeCompactBytes(size_t maxLength, uint256_t& value) {
+        if (remaining() < 1) {
+            return false;
+        }
+        switch (current[0] & 0x03) {
+        case 0x00:
+            value = current[0] >> 2;
+            current += 1;
+            return true;
+        case 0x01: {
+            if (remaining() < 2) {
+                return false;
+            }
+            const auto v = TW::decode16LE(current) >> 2;
+            if (v < kMinUint16) {
+                return false;
+            }
+            value = v;
+            current += 2;
+            return true;
+        }
+        case 0x02: {
+            if (remaining() < 4) {
+                return false;
+            }
+            const auto v = TW::decode32LE(current) >> 2;
+            if (v < kMinUint32) {
+                return false;
+            }
+            value = v;
+            current += 4;
+            return true;
+        }
+        default: {
+            const size_t length = (current[0] >> 2) + 4;
+            if (length > maxLength || remaining() < 1 + length || current[length] == 0) {
+                return false;
+            }
+            uint256_t v = 0;
+            for (size_t i = length; i > 0; --i) {
+                v = (v << 8) | current[i];
+            }
+            if (v < kMinBigInteger) {
+                return false;
+            }
+            value = v;
+            current += 1 + length;
+            return true;
+        }
+        }
+    }
+
+    const byte* current;
+    const byte* end;
+};
+
 } // namespace TW::Polkadot
@@ -12,21 +12,35 @@
 using namespace TW;
 using namespace TW::Polkadot;
 
-static constexpr size_t hashTreshold = 256;
-
-Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
-    auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
-    auto extrinsic = Extrinsic(input);
+static Data signExtrinsic(const Extrinsic& extrinsic, const PrivateKey& privateKey, const PublicKey& publicKey) {
     auto payload = extrinsic.encodePayload();
     // check if need to hash
-    if (payload.size() > hashTreshold) {
+    if (payload.size() > payloadHashThreshold) {
         payload = Hash::blake2b(payload, 32);
     }
     auto signature = privateKey.sign(payload, TWCurveED25519);
-    auto encoded = extrinsic.encodeSignature(publicKey, signature);
+    return extrinsic.encodeSignature(publicKey, signature);
+}
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
+    auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+    auto encoded = signExtrinsic(Extrinsic(input), privateKey, publicKey);
 
     auto protoOutput = Proto::SigningOutput();
     protoOutput.set_encoded(encoded.data(), encoded.size());
     return protoOutput;
 }
+
+std::vector<Data> Signer::signCalls(const Proto::SigningInput& input, const std::vector<Data>& calls) {
+    auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+    std::vector<Data> encoded;
+    encoded.reserve(calls.size());
+    for (size_t i = 0; i < calls.size(); ++i) {
+        auto extrinsic = Extrinsic(input, calls[i]);
+        extrinsic.nonce = input.nonce() + i;
+        encoded.push_back(signExtrinsic(extrinsic, privateKey, publicKey));
+    }
+    return encoded;
+}
@@ -10,6 +10,8 @@
 #include "../PrivateKey.h"
 #include "../proto/Polkadot.pb.h"
 
+#include <vector>
+
 namespace TW::Polkadot {
 
 /// Helper class that performs Polkadot transaction signing.
@@ -20,6 +22,10 @@ public:
 
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// Signs one extrinsic per encoded call (e.g. from TransferBatchBuilder), with all other fields taken from
+    /// the input; nonces increase from the input nonce.  The call in the input is ignored.
+    static std::vector<Data> signCalls(const Proto::SigningInput& input, const std::vector<Data>& calls);
 };
 
 } // namespace TW::Polkadot
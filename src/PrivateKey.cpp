@@ -7,6 +7,7 @@
 #include "PrivateKey.h"
 
 #include "PublicKey.h"
+#include "SigningContext.h"
 
 #include <TrezorCrypto/bignum.h>
 #include <TrezorCrypto/curves.h>
@@ -260,6 +261,29 @@ Data PrivateKey::sign(const Data& digest, TWCurve curve, int(*canonicalChecker)(
     return result;
 }
 
+bool PrivateKey::isCanonical(const uint8_t sig[64]) {
+    return !(sig[0] & 0x80) && !(sig[0] == 0 && !(sig[1] & 0x80)) && !(sig[32] & 0x80) && !(sig[32] == 0 && !(sig[33] & 0x80));
+}
+
+Data PrivateKey::signCanonical(const Data& digest, TWCurve curve) const {
+    if (curve != TWCurveSECP256k1 && curve != TWCurveNIST256p1) {
+        return {};
+    }
+    return SigningContext(*this, curve).signCanonical(digest);
+}
+
+std::vector<Data> PrivateKey::signCanonical(const std::vector<Data>& digests, TWCurve curve) const {
+    std::vector<Data> signatures(digests.size());
+    if (curve != TWCurveSECP256k1 && curve != TWCurveNIST256p1) {
+        return signatures;
+    }
+    const SigningContext context(*this, curve);
+    for (size_t i = 0; i < digests.size(); ++i) {
+        signatures[i] = context.signCanonical(digests[i]);
+    }
+    return signatures;
+}
+
 Data PrivateKey::signAsDER(const Data& digest, TWCurve curve) const {
     Data sig(64);
     bool success =
@@ -11,6 +11,8 @@
 
 #include <TrustWalletCore/TWCurve.h>
 
+#include <vector>
+
 namespace TW {
 
 class PrivateKey {
@@ -64,6 +66,17 @@ class PrivateKey {
     /// Only a sig that passes canonicalChecker is returned
     Data sign(const Data& digest, TWCurve curve, int(*canonicalChecker)(uint8_t by, uint8_t sig[64])) const;
 
+    /// Graphene canonical signature check (EOS, FIO): r and s both have 32 significant bytes and the top bit clear.
+    static bool isCanonical(const uint8_t sig[64]);
+
+    /// Signs a digest using the given ECDSA curve (secp256k1 or nist256p1) and prepends the recovery id (a la
+    /// graphene), retrying until the signature is canonical.  Same result as `sign` with a graphene canonical
+    /// checker, but nonces with a non-canonical r are rejected before s is computed.
+    Data signCanonical(const Data& digest, TWCurve curve) const;
+
+    /// Signs many digests as `signCanonical`, reading the key once; failed signatures are empty.
+    std::vector<Data> signCanonical(const std::vector<Data>& digests, TWCurve curve) const;
+
     /// Signs a digest using the given ECDSA curve. The result is encoded with
     /// DER.
     Data signAsDER(const Data& digest, TWCurve curve) const;
@@ -14,6 +14,12 @@
 #include <TrezorCrypto/sodium/keypair.h>
 #include <TrezorCrypto/ed25519-donna/ed25519-donna.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+
 namespace TW {
 
 /// Determines if a collection of bytes makes a valid public key of the
@@ -195,6 +201,174 @@ PublicKey PublicKey::recover(const Data& signature, const Data& message) {
     return PublicKey(result, TWPublicKeyTypeSECP256k1Extended);
 }
 
+namespace {
+
+/// Largest number of signatures sharing one modular inversion
+constexpr size_t recoveryGroupSize = 64;
+
+struct RecoveryState {
+    bignum256 r, s, e;
+    curve_point R;
+};
+
+/// Reads r, s and -digest and lifts r to the curve point R, with the same checks as ecdsa_recover_pub_from_sig
+bool prepareRecovery(const Data& signature, const Data& digest, RecoveryState& state) {
+    const auto* curve = &secp256k1;
+    if (signature.size() < 65 || digest.size() < 32) {
+        return false;
+    }
+    auto v = signature[64];
+    if (v >= 27) {
+        v -= 27;
+    }
+
+    bn_read_be(signature.data(), &state.r);
+    bn_read_be(signature.data() + 32, &state.s);
+    if (!bn_is_less(&state.r, &curve->order) || bn_is_zero(&state.r)) {
+        return false;
+    }
+    if (!bn_is_less(&state.s, &curve->order) || bn_is_zero(&state.s)) {
+        return false;
+    }
+    bn_copy(&state.r, &state.R.x);
+    if (v & 2) {
+        bn_add(&state.R.x, &curve->order);
+        if (!bn_is_less(&state.R.x, &curve->prime)) {
+            return false;
+        }
+    }
+    uncompress_coords(curve, v & 1, &state.R.x, &state.R.y);
+    if (!ecdsa_validate_pubkey(curve, &state.R)) {
+        return false;
+    }
+    bn_read_be(digest.data(), &state.e);
+    bn_mod(&state.e, &curve->order);
+    bn_subtract(&curve->order, &state.e, &state.e);
+    return true;
+}
+
+/// Recovers the addresses of items [begin, end), at most `recoveryGroupSize` of them
+void recoverGroup(const std::vector<std::pair<Data, Data>>& items, size_t begin, size_t end, std::vector<Data>& addresses) {
+    const auto* curve = &secp256k1;
+    RecoveryState states[recoveryGroupSize];
+    // running products r0 * r1 * ... of the valid signatures, for Montgomery's batch inversion
+    bignum256 products[recoveryGroupSize];
+    size_t valid[recoveryGroupSize];
+    size_t count = 0;
+    for (auto i = begin; i < end; ++i) {
+        auto& state = states[count];
+        if (!prepareRecovery(items[i].first, items[i].second, state)) {
+            continue;
+        }
+        bn_copy(&state.r, &products[count]);
+        if (count > 0) {
+            bn_multiply(&products[count - 1], &products[count], &curve->order);
+        }
+        valid[count++] = i;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    uint8_t coordinates[recoveryGroupSize][64];
+    bignum256 inverse;
+    bn_copy(&products[count - 1], &inverse);
+    bn_mod(&inverse, &curve->order);
+    bn_inverse(&inverse, &curve->order);
+    for (auto j = count; j-- > 0;) {
+        auto& state = states[j];
+        // inverse holds (r0 * ... * rj)^-1; peel off rj
+        bignum256 rInverse;
+        bn_copy(&inverse, &rInverse);
+        if (j > 0) {
+            bn_multiply(&products[j - 1], &rInverse, &curve->order);
+            bn_multiply(&state.r, &inverse, &curve->order);
+        }
+        bn_mod(&rInverse, &curve->order);
+
+        // Pub = s * r^-1 * R - digest * r^-1 * G
+        bn_multiply(&rInverse, &state.e, &curve->order);
+        bn_mod(&state.e, &curve->order);
+        bn_multiply(&rInverse, &state.s, &curve->order);
+        bn_mod(&state.s, &curve->order);
+        point_multiply(curve, &state.s, &state.R, &state.R);
+        curve_point eG;
+        scalar_multiply(curve, &state.e, &eG);
+        point_add(curve, &eG, &state.R);
+
+        bn_write_be(&state.R.x, coordinates[j]);
+        bn_write_be(&state.R.y, coordinates[j] + 32);
+    }
+
+    const byte* inputs[recoveryGroupSize];
+    size_t sizes[recoveryGroupSize];
+    for (size_t j = 0; j < count; ++j) {
+        inputs[j] = coordinates[j];
+        sizes[j] = sizeof(coordinates[j]);
+    }
+    uint8_t hashes[recoveryGroupSize][32];
+    Hash::keccak256Many(inputs, sizes, count, hashes[0]);
+    for (size_t j = 0; j < count; ++j) {
+        addresses[valid[j]] = Data(hashes[j] + 12, hashes[j] + 32);
+    }
+}
+
+} // namespace
+
+std::vector<Data> PublicKey::recoverAddresses(const std::vector<std::pair<Data, Data>>& items, unsigned threads) {
+    std::vector<Data> addresses(items.size());
+    if (items.empty()) {
+        return addresses;
+    }
+
+    // the thread count comes from untrusted input, never exceed the hardware
+    const size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    // smaller groups when there are fewer signatures than workers * recoveryGroupSize, so every worker gets some
+    const auto workers = std::max<size_t>(1, std::min<size_t>({threads, hardwareThreads, items.size()}));
+    const auto groupSize = std::min(recoveryGroupSize, (items.size() + workers - 1) / workers);
+    const auto groups = (items.size() + groupSize - 1) / groupSize;
+    const auto recover = [&](size_t group) {
+        const auto begin = group * groupSize;
+        recoverGroup(items, begin, std::min(begin + groupSize, items.size()), addresses);
+    };
+    if (workers <= 1) {
+        for (size_t group = 0; group < groups; ++group) {
+            recover(group);
+        }
+        return addresses;
+    }
+
+    std::atomic<size_t> next{0};
+    std::vector<std::exception_ptr> errors(workers);
+    const auto work = [&](size_t w) {
+        try {
+            for (auto group = next++; group < groups; group = next++) {
+                recover(group);
+            }
+        } catch (...) {
+            errors[w] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> pool;
+    try {
+        for (size_t w = 1; w < workers; ++w) {
+            pool.emplace_back(work, w);
+        }
+    } catch (const std::system_error&) {
+        // no more threads available; the started ones and this thread share the groups
+    }
+    work(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return addresses;
+}
+
 bool PublicKey::isValidED25519() const {
     if (type != TWPublicKeyTypeED25519) {
         return false;
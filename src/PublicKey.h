@@ -13,6 +13,8 @@
 
 #include <cassert>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace TW {
 
@@ -73,6 +75,14 @@ class PublicKey {
     /// Recover public key from signature (SECP256k1Extended)
     static PublicKey recover(const Data& signature, const Data& message);
 
+    /// Recovers the signers of many (signature, digest) pairs (SECP256k1) and returns their Ethereum addresses,
+    /// the last 20 bytes of the Keccak-256 of the uncompressed key.  The modular inverses of r are computed with one
+    /// shared inversion per group of signatures, and groups are spread over `threads` workers, at most one per
+    /// hardware thread.
+    ///
+    /// \returns one 20-byte address per pair, in input order; empty where the signature doesn't recover.
+    static std::vector<Data> recoverAddresses(const std::vector<std::pair<Data, Data>>& items, unsigned threads = 1);
+
     /// Check if this key makes a valid ED25519 key (it is on the curve)
     bool isValidED25519() const;
 };
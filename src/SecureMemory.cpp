@@ -0,0 +1,202 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SecureMemory.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <cstring>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#define SECURE_ARENA_MMAP 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace TW;
+
+namespace {
+
+#ifdef SECURE_ARENA_MMAP
+
+size_t pageSize() {
+    static const auto size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+/// Maps zero-filled memory, locked and excluded from core dumps if possible; returns nullptr on failure
+void* systemMap(size_t size, bool& locked) {
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    locked = mlock(memory, size) == 0;
+#ifdef MADV_DONTDUMP
+    madvise(memory, size, MADV_DONTDUMP);
+#endif
+    return memory;
+}
+
+void systemUnmap(void* memory, size_t size) {
+    munlock(memory, size);
+    munmap(memory, size);
+}
+
+#else
+
+// no memory locking on this platform (Windows, WebAssembly): plain zero-filled heap blocks, still zeroed when freed
+size_t pageSize() {
+    return 4096;
+}
+
+void* systemMap(size_t size, bool& locked) {
+    locked = false;
+    void* memory = ::operator new(size, std::align_val_t(16), std::nothrow);
+    if (memory != nullptr) {
+        std::memset(memory, 0, size);
+    }
+    return memory;
+}
+
+void systemUnmap(void* memory, size_t /* size */) {
+    ::operator delete(memory, std::align_val_t(16));
+}
+
+#endif
+
+size_t roundUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+/// Free list index of a small block size: 16, 32, ... 4096
+size_t sizeClass(size_t size) {
+    size_t index = 0;
+    for (size_t blockSize = SecureArena::minBlockSize; blockSize < size; blockSize <<= 1) {
+        ++index;
+    }
+    return index;
+}
+
+size_t classSize(size_t index) {
+    return SecureArena::minBlockSize << index;
+}
+
+} // namespace
+
+SecureArena& SecureArena::shared() {
+    // never destroyed: secure containers may be freed during static destruction
+    static auto* arena = new SecureArena();
+    return *arena;
+}
+
+void* SecureArena::map(size_t size) {
+    bool locked = false;
+    void* memory = systemMap(size, locked);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    if (!locked) {
+        allLocked = false;
+    }
+    reserved += size;
+    return memory;
+}
+
+void* SecureArena::allocate(size_t size) {
+    if (size == 0) {
+        size = 1;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (size > maxBlockSize) {
+        return map(roundUp(size, pageSize()));
+    }
+
+    const auto index = sizeClass(size);
+    if (auto* block = freeLists[index]; block != nullptr) {
+        freeLists[index] = block->next;
+        block->next = nullptr;
+        return block;
+    }
+
+    const auto blockSize = classSize(index);
+    if (static_cast<size_t>(chunkEnd - chunkNext) < blockSize) {
+        // the rest of the current chunk is too small for this class; hand it to the smaller free lists
+        while (chunkNext != nullptr && chunkEnd - chunkNext >= static_cast<ptrdiff_t>(minBlockSize)) {
+            auto remainingClass = sizeClass(static_cast<size_t>(chunkEnd - chunkNext));
+            if (classSize(remainingClass) > static_cast<size_t>(chunkEnd - chunkNext)) {
+                --remainingClass;
+            }
+            auto* block = reinterpret_cast<FreeBlock*>(chunkNext);
+            block->next = freeLists[remainingClass];
+            freeLists[remainingClass] = block;
+            chunkNext += classSize(remainingClass);
+        }
+        chunkNext = static_cast<byte*>(map(chunkSize));
+        chunkEnd = chunkNext + chunkSize;
+    }
+    void* block = chunkNext;
+    chunkNext += blockSize;
+    return block;
+}
+
+void SecureArena::deallocate(void* pointer, size_t size) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    if (size == 0) {
+        size = 1;
+    }
+    if (size > maxBlockSize) {
+        const auto mappedSize = roundUp(size, pageSize());
+        memzero(pointer, mappedSize);
+        systemUnmap(pointer, mappedSize);
+        std::lock_guard<std::mutex> lock(mutex);
+        reserved -= mappedSize;
+        return;
+    }
+
+    const auto index = sizeClass(size);
+    memzero(pointer, classSize(index));
+    auto* block = static_cast<FreeBlock*>(pointer);
+    std::lock_guard<std::mutex> lock(mutex);
+    block->next = freeLists[index];
+    freeLists[index] = block;
+}
+
+bool SecureArena::locked() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return allLocked;
+}
+
+size_t SecureArena::reservedSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return reserved;
+}
+
+SecureString::SecureString(SecureString&& other) noexcept : Base(std::move(other)) {
+    other.scrub();
+}
+
+SecureString& SecureString::operator=(SecureString&& other) noexcept {
+    if (this != &other) {
+        scrub();
+        Base::operator=(std::move(other));
+        other.scrub();
+    }
+    return *this;
+}
+
+SecureString::~SecureString() {
+    scrub();
+}
+
+void SecureString::scrub() noexcept {
+    // a moved-from or short string may keep its text in the small-string buffer inside the object; growing to the
+    // capacity never allocates and exposes that whole buffer
+    resize(capacity());
+    memzero(data(), size());
+    clear();
+}
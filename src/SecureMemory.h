@@ -0,0 +1,135 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace TW {
+
+/// Process-wide pool of memory for secrets.  Memory is taken from the system in page-aligned chunks that are
+/// locked in RAM (kept out of swap) and excluded from core dumps where the platform allows.  Small blocks are
+/// served from per-size free lists, so repeated allocations of keys do not go back to the system.  Every block is
+/// zeroed when freed.
+class SecureArena {
+  public:
+    /// Smallest and largest block served from the free lists; larger blocks get their own mapping.
+    static constexpr size_t minBlockSize = 16;
+    static constexpr size_t maxBlockSize = 4096;
+    /// Size of the chunks small blocks are carved from.
+    static constexpr size_t chunkSize = 64 * 1024;
+
+    /// The shared arena.
+    static SecureArena& shared();
+
+    /// Allocates `size` bytes aligned to 16 bytes, zero-filled.
+    ///
+    /// @throws std::bad_alloc if the system can't provide memory.
+    void* allocate(size_t size);
+
+    /// Zeroes and releases a block returned by `allocate` with the same size.
+    void deallocate(void* pointer, size_t size) noexcept;
+
+    /// Whether all memory taken from the system so far could be locked (false if the lock limit was reached).
+    bool locked() const;
+
+    /// Bytes taken from the system.
+    size_t reservedSize() const;
+
+  private:
+    SecureArena() = default;
+    ~SecureArena() = default;
+
+    static constexpr size_t classCount = 9;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void* map(size_t size);
+
+    mutable std::mutex mutex;
+    FreeBlock* freeLists[classCount] = {};
+    /// Unused end of the current chunk
+    byte* chunkNext = nullptr;
+    byte* chunkEnd = nullptr;
+    size_t reserved = 0;
+    bool allLocked = true;
+};
+
+/// Allocator taking memory from the shared `SecureArena`.
+template <typename T>
+struct SecureAllocator {
+    using value_type = T;
+
+    SecureAllocator() noexcept = default;
+    template <typename U>
+    SecureAllocator(const SecureAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if (count > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(SecureArena::shared().allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept { SecureArena::shared().deallocate(pointer, count * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const SecureAllocator<T>&, const SecureAllocator<U>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const SecureAllocator<T>&, const SecureAllocator<U>&) noexcept {
+    return false;
+}
+
+/// Bytes of secret material (keys, seeds, decrypted payloads).
+using SecureData = std::vector<byte, SecureAllocator<byte>>;
+
+/// Secret text (mnemonics, passphrases).  Strings short enough for the small-string buffer live inside the object
+/// rather than in the arena; that buffer is zeroed when the string is destroyed or moved from.
+class SecureString : public std::basic_string<char, std::char_traits<char>, SecureAllocator<char>> {
+  public:
+    using Base = std::basic_string<char, std::char_traits<char>, SecureAllocator<char>>;
+    using Base::Base;
+    using Base::operator=;
+
+    SecureString() noexcept = default;
+    SecureString(const SecureString& other) = default;
+    SecureString& operator=(const SecureString& other) = default;
+    SecureString(SecureString&& other) noexcept;
+    SecureString& operator=(SecureString&& other) noexcept;
+    ~SecureString();
+
+  private:
+    void scrub() noexcept;
+};
+
+/// Copies bytes into secure memory.
+inline SecureData secureData(const byte* data, size_t size) {
+    return SecureData(data, data + size);
+}
+
+/// Copies regular data into secure memory.
+inline SecureData secureData(const Data& data) {
+    return secureData(data.data(), data.size());
+}
+
+/// Copies secure data into regular memory, for APIs taking `Data`.
+inline Data insecureData(const SecureData& data) {
+    return Data(data.begin(), data.end());
+}
+
+} // namespace TW
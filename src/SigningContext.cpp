@@ -0,0 +1,325 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SigningContext.h"
+
+#include <TrezorCrypto/ed25519-donna/ed25519-blake2b.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/nist256p1.h>
+#include <TrezorCrypto/rand.h>
+#include <TrezorCrypto/rfc6979.h>
+#include <TrezorCrypto/secp256k1.h>
+#include <TrezorCrypto/sha2.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+using namespace TW;
+
+namespace {
+
+/// Graphene canonical rule for one of r and s, see `PrivateKey::isCanonical`
+bool isCanonicalHalf(const uint8_t* half) {
+    return !(half[0] & 0x80) && !(half[0] == 0 && !(half[1] & 0x80));
+}
+
+void generateBlindingFactor(bignum256* factor, const ecdsa_curve* curve) {
+    uint8_t buffer[32];
+    do {
+        random_buffer(buffer, sizeof(buffer));
+        bn_read_be(buffer, factor);
+    } while (bn_is_zero(factor) || !bn_is_less(factor, &curve->order));
+    memzero(buffer, sizeof(buffer));
+}
+
+const ecdsa_curve* ecdsaCurve(TWCurve curve) {
+    switch (curve) {
+    case TWCurveSECP256k1:
+        return &secp256k1;
+    case TWCurveNIST256p1:
+        return &nist256p1;
+    default:
+        return nullptr;
+    }
+}
+
+TWPublicKeyType publicKeyType(TWCurve curve) {
+    switch (curve) {
+    case TWCurveSECP256k1:
+        return TWPublicKeyTypeSECP256k1;
+    case TWCurveNIST256p1:
+        return TWPublicKeyTypeNIST256p1;
+    case TWCurveED25519:
+    case TWCurveED25519HD:
+    case TWCurveCurve25519:
+        return TWPublicKeyTypeED25519;
+    case TWCurveED25519Blake2bNano:
+        return TWPublicKeyTypeED25519Blake2b;
+    case TWCurveED25519Extended:
+        return TWPublicKeyTypeED25519Extended;
+    case TWCurveNone:
+    default:
+        throw std::invalid_argument("Unsupported curve");
+    }
+}
+
+} // namespace
+
+SigningContext::SigningContext(const PrivateKey& privateKey, TWCurve curve)
+    : _privateKey(privateKey), _curve(curve), _ecdsa(ecdsaCurve(curve)) {
+    publicKeyType(curve);
+    if (!PrivateKey::isValid(privateKey.bytes, curve)) {
+        throw std::invalid_argument("Invalid private key for curve");
+    }
+    if (_ecdsa != nullptr) {
+        bn_read_be(_privateKey.bytes.data(), &_scalar);
+    }
+}
+
+SigningContext::~SigningContext() {
+    memzero(&_scalar, sizeof(_scalar));
+}
+
+const PublicKey& SigningContext::publicKey() const {
+    std::call_once(_publicKeyOnce, [this] { _publicKey = _privateKey.getPublicKey(publicKeyType(_curve)); });
+    return *_publicKey;
+}
+
+bool SigningContext::signECDSA(const Data& digest, bool canonical, uint8_t sig[64], uint8_t& recovery) const {
+    if (_ecdsa == nullptr || digest.size() < 32) {
+        return false;
+    }
+
+    // same steps as ecdsa_sign_digest, with the key scalar read once and non-canonical r rejected before s is
+    // computed
+    rfc6979_state rng;
+    init_rfc6979(_privateKey.bytes.data(), digest.data(), &rng);
+    bignum256 z;
+    bn_read_be(digest.data(), &z);
+
+    curve_point R;
+    bignum256 k, randk;
+    bignum256* s = &R.y;
+    bool success = false;
+    for (int i = 0; i < 10000; ++i) {
+        generate_k_rfc6979(&k, &rng);
+        if (bn_is_zero(&k) || !bn_is_less(&k, &_ecdsa->order)) {
+            continue;
+        }
+
+        scalar_multiply(_ecdsa, &k, &R);
+        uint8_t by = R.y.val[0] & 1;
+        if (!bn_is_less(&R.x, &_ecdsa->order)) {
+            bn_subtract(&R.x, &_ecdsa->order, &R.x);
+            by |= 2;
+        }
+        if (bn_is_zero(&R.x)) {
+            continue;
+        }
+        bn_write_be(&R.x, sig);
+        if (canonical && !isCanonicalHalf(sig)) {
+            continue;
+        }
+
+        // fresh blinding factor on every attempt, as ecdsa_sign_digest
+        generateBlindingFactor(&randk, _ecdsa);
+        bn_multiply(&randk, &k, &_ecdsa->order);  // k*rand
+        bn_inverse(&k, &_ecdsa->order);           // (k*rand)^-1
+        bn_copy(&_scalar, s);                     // priv
+        bn_multiply(&R.x, s, &_ecdsa->order);     // R.x*priv
+        bn_add(s, &z);                            // R.x*priv + z
+        bn_multiply(&k, s, &_ecdsa->order);       // (k*rand)^-1 (R.x*priv + z)
+        bn_multiply(&randk, s, &_ecdsa->order);   // k^-1 (R.x*priv + z)
+        bn_mod(s, &_ecdsa->order);
+        if (bn_is_zero(s)) {
+            continue;
+        }
+        if (bn_is_less(&_ecdsa->order_half, s)) {
+            bn_subtract(&_ecdsa->order, s, s);
+            by ^= 1;
+        }
+        bn_write_be(s, sig + 32);
+        if (canonical && !isCanonicalHalf(sig + 32)) {
+            continue;
+        }
+
+        recovery = by;
+        success = true;
+        break;
+    }
+
+    memzero(&k, sizeof(k));
+    memzero(&randk, sizeof(randk));
+    memzero(&R, sizeof(R));
+    memzero(&rng, sizeof(rng));
+    return success;
+}
+
+Data SigningContext::sign(const Data& digest) const {
+    Data result;
+    switch (_curve) {
+    case TWCurveSECP256k1:
+    case TWCurveNIST256p1: {
+        result.resize(65);
+        if (!signECDSA(digest, false, result.data(), result[64])) {
+            return {};
+        }
+    } break;
+    case TWCurveED25519HD:
+    case TWCurveED25519: {
+        result.resize(64);
+        ed25519_sign(digest.data(), digest.size(), _privateKey.bytes.data(), publicKey().bytes.data(), result.data());
+    } break;
+    case TWCurveED25519Blake2bNano: {
+        result.resize(64);
+        ed25519_sign_blake2b(digest.data(), digest.size(), _privateKey.bytes.data(), publicKey().bytes.data(),
+                             result.data());
+    } break;
+    case TWCurveED25519Extended: {
+        result.resize(64);
+        ed25519_sign_ext(digest.data(), digest.size(), _privateKey.bytes.data(), _privateKey.extensionBytes.data(),
+                         publicKey().bytes.data(), result.data());
+    } break;
+    case TWCurveCurve25519: {
+        result.resize(64);
+        ed25519_sign(digest.data(), digest.size(), _privateKey.bytes.data(), publicKey().bytes.data(), result.data());
+        const auto sign_bit = publicKey().bytes[31] & 0x80;
+        result[63] = result[63] & 127;
+        result[63] |= sign_bit;
+    } break;
+    case TWCurveNone:
+    default:
+        break;
+    }
+    return result;
+}
+
+Data SigningContext::signCanonical(const Data& digest) const {
+    Data result(65);
+    if (!signECDSA(digest, true, result.data() + 1, result[0])) {
+        return {};
+    }
+    // graphene adds 31 to the recovery id
+    result[0] += 31;
+    return result;
+}
+
+Data SigningContext::signAsDER(const Data& digest) const {
+    uint8_t sig[64];
+    uint8_t recovery = 0;
+    if (!signECDSA(digest, false, sig, recovery)) {
+        return {};
+    }
+    Data result(72);
+    const auto size = ecdsa_sig_to_der(sig, result.data());
+    result.resize(size);
+    return result;
+}
+
+Data SigningContext::signSchnorr(const Data& message) const {
+    if (_curve != TWCurveSECP256k1) {
+        return {};
+    }
+
+    // same steps as zil_schnorr_sign, with the public key computed once and k*G taken from the precomputed table
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+    sha256_Raw(message.data(), message.size(), hash);
+    rfc6979_state rng;
+    init_rfc6979(_privateKey.bytes.data(), hash, &rng);
+
+    Data sig(64);
+    bignum256 k, r, s;
+    curve_point Q;
+    bool success = false;
+    for (int i = 0; i < 10000; ++i) {
+        generate_k_rfc6979(&k, &rng);
+        if (bn_is_zero(&k) || !bn_is_less(&k, &_ecdsa->order)) {
+            continue;
+        }
+
+        // commitment Q = kG, challenge r = H(Q, pub, m)
+        scalar_multiply(_ecdsa, &k, &Q);
+        uint8_t commitment[33];
+        commitment[0] = 0x02 | (Q.y.val[0] & 1);
+        bn_write_be(&Q.x, commitment + 1);
+        SHA256_CTX context;
+        sha256_Init(&context);
+        sha256_Update(&context, commitment, sizeof(commitment));
+        sha256_Update(&context, publicKey().bytes.data(), publicKey().bytes.size());
+        sha256_Update(&context, message.data(), message.size());
+        uint8_t challenge[SHA256_DIGEST_LENGTH];
+        sha256_Final(&context, challenge);
+        bn_read_be(challenge, &r);
+        bn_mod(&r, &_ecdsa->order);
+        bn_write_be(&r, sig.data());
+
+        // s = k - r*priv
+        bn_multiply(&_scalar, &r, &_ecdsa->order);
+        bn_subtractmod(&k, &r, &s, &_ecdsa->order);
+        bn_fast_mod(&s, &_ecdsa->order);
+        bn_mod(&s, &_ecdsa->order);
+        bn_write_be(&s, sig.data() + 32);
+
+        if (bn_is_zero(&r) || bn_is_zero(&s)) {
+            continue;
+        }
+        success = true;
+        break;
+    }
+
+    memzero(&k, sizeof(k));
+    memzero(&r, sizeof(r));
+    memzero(&s, sizeof(s));
+    memzero(&rng, sizeof(rng));
+    if (!success) {
+        return {};
+    }
+    return sig;
+}
+
+std::vector<Data> SigningContext::signMany(const std::vector<Data>& digests, unsigned threads) const {
+    std::vector<Data> signatures(digests.size());
+    // compute the public key before the workers share it
+    if (_ecdsa == nullptr) {
+        publicKey();
+    }
+
+    const size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const auto workers = std::min<size_t>({threads, hardwareThreads, digests.size()});
+    if (workers <= 1) {
+        for (size_t i = 0; i < digests.size(); ++i) {
+            signatures[i] = sign(digests[i]);
+        }
+        return signatures;
+    }
+
+    std::atomic<size_t> next{0};
+    std::vector<std::exception_ptr> errors(workers);
+    std::vector<std::thread> pool;
+    for (size_t w = 0; w < workers; ++w) {
+        pool.emplace_back([&, w] {
+            try {
+                for (auto i = next++; i < digests.size(); i = next++) {
+                    signatures[i] = sign(digests[i]);
+                }
+            } catch (...) {
+                errors[w] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return signatures;
+}
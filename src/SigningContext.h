@@ -0,0 +1,73 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+
+#include <TrezorCrypto/bignum.h>
+#include <TrezorCrypto/ecdsa.h>
+#include <TrustWalletCore/TWCurve.h>
+
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace TW {
+
+/// Signing state bound to one private key and curve, for signing many digests with the same key.  The public key
+/// and the private key scalar are computed once, instead of on every call as in `PrivateKey`; the RFC6979 generator
+/// depends on the digest and is still set up per signature.  Signatures are the
+/// same as those of the matching `PrivateKey` methods.  A context can be used from several threads at once.
+class SigningContext {
+  public:
+    /// Binds a key and a curve.
+    ///
+    /// @throws std::invalid_argument if the curve is not supported or the key is not valid for it.
+    SigningContext(const PrivateKey& privateKey, TWCurve curve);
+
+    SigningContext(const SigningContext&) = delete;
+    SigningContext& operator=(const SigningContext&) = delete;
+
+    ~SigningContext();
+
+    TWCurve curve() const { return _curve; }
+
+    /// Public key used by the signing functions (compressed for ECDSA curves), computed on first use.
+    const PublicKey& publicKey() const;
+
+    /// Same as `PrivateKey::sign(digest, curve)`.
+    Data sign(const Data& digest) const;
+
+    /// Same as `PrivateKey::signCanonical(digest, curve)`; ECDSA curves only.
+    Data signCanonical(const Data& digest) const;
+
+    /// Same as `PrivateKey::signAsDER(digest, curve)`; ECDSA curves only.
+    Data signAsDER(const Data& digest) const;
+
+    /// Same as `PrivateKey::signSchnorr(message, curve)`; secp256k1 only.
+    Data signSchnorr(const Data& message) const;
+
+    /// Signs many digests as `sign`, on `threads` worker threads (at most one per hardware thread); failed
+    /// signatures are empty.
+    std::vector<Data> signMany(const std::vector<Data>& digests, unsigned threads = 1) const;
+
+  private:
+    /// ECDSA signature (r, s) and recovery id, optionally retrying until graphene canonical.
+    bool signECDSA(const Data& digest, bool canonical, uint8_t sig[64], uint8_t& recovery) const;
+
+    PrivateKey _privateKey;
+    TWCurve _curve;
+    const ecdsa_curve* _ecdsa = nullptr;
+    mutable std::once_flag _publicKeyOnce;
+    mutable std::optional<PublicKey> _publicKey;
+    /// Private key as an ECDSA scalar
+    bignum256 _scalar = {};
+};
+
+} // namespace TW
@@ -12,7 +12,11 @@
 
 #include <TrezorCrypto/ed25519-donna/ed25519-donna.h>
 
+#include <TrezorCrypto/sha2.h>
+
 #include <cassert>
+#include <cstring>
+#include <stdexcept>
 
 using namespace TW;
 using namespace TW::Solana;
@@ -30,19 +34,68 @@ Address StakeProgram::addressFromValidatorSeed(const Address& fromAddress, const
     return Address(hash);
 }
 
+namespace {
+
+const char programDerivedAddressMarker[] = "ProgramDerivedAddress";
+
+const Address& tokenProgramId() {
+    static const Address id(TOKEN_PROGRAM_ID_ADDRESS);
+    return id;
+}
+
+const Address& associatedTokenProgramId() {
+    static const Address id(ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS);
+    return id;
+}
+
+/// Complete a program address, the seeds having been hashed into `ctx` already
+void finishProgramAddress(SHA256_CTX& ctx, const Address& programId, Address& result) {
+    sha256_Update(&ctx, programId.bytes.data(), programId.bytes.size());
+    sha256_Update(&ctx, reinterpret_cast<const uint8_t*>(programDerivedAddressMarker), sizeof(programDerivedAddressMarker) - 1);
+    sha256_Final(&ctx, result.bytes.data());
+}
+
+/// find_program_address, with the seeds hashed into `seedsCtx` once, for all bump seeds
+Address findProgramAddress(const SHA256_CTX& seedsCtx, const Address& programId) {
+    Address result = programId;
+    // cycle through bump seeds for the rare case when result is on the curve
+    for (int bump = 255; bump >= 0; --bump) {
+        SHA256_CTX ctx = seedsCtx;
+        const uint8_t bumpSeed = static_cast<uint8_t>(bump);
+        sha256_Update(&ctx, &bumpSeed, 1);
+        finishProgramAddress(ctx, programId, result);
+        ge25519 point;
+        if (ge25519_unpack_negative_vartime(&point, result.bytes.data()) == 0) {
+            return result;
+        }
+        // valid public key, try next seed
+    }
+    throw std::runtime_error("Unable to find a viable program address bump seed");
+}
+
+} // namespace
+
 /*
  * Based on solana-program-library code, get_associated_token_address()
  * https://github.com/solana-labs/solana-program-library/blob/master/associated-token-account/program/src/lib.rs#L35
  * https://github.com/solana-labs/solana-program-library/blob/master/associated-token-account/program/src/lib.rs#L19
  */
 Address TokenProgram::defaultTokenAddress(const Address& mainAddress, const Address& tokenMintAddress) {
-    Address programId = Address(TOKEN_PROGRAM_ID_ADDRESS);
-    std::vector<Data> seeds = {
-        TW::data(mainAddress.bytes.data(), mainAddress.bytes.size()),
-        TW::data(programId.bytes.data(), programId.bytes.size()),
-        TW::data(tokenMintAddress.bytes.data(), tokenMintAddress.bytes.size())
-    };
-    return findProgramAddress(seeds, Address(ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS));
+    SHA256_CTX ctx;
+    sha256_Init(&ctx);
+    sha256_Update(&ctx, mainAddress.bytes.data(), mainAddress.bytes.size());
+    sha256_Update(&ctx, tokenProgramId().bytes.data(), tokenProgramId().bytes.size());
+    sha256_Update(&ctx, tokenMintAddress.bytes.data(), tokenMintAddress.bytes.size());
+    return ::findProgramAddress(ctx, associatedTokenProgramId());
+}
+
+std::vector<Address> TokenProgram::defaultTokenAddresses(const std::vector<Address>& mainAddresses, const Address& tokenMintAddress) {
+    std::vector<Address> result;
+    result.reserve(mainAddresses.size());
+    for (const auto& mainAddress: mainAddresses) {
+        result.push_back(defaultTokenAddress(mainAddress, tokenMintAddress));
+    }
+    return result;
 }
 
 /*
@@ -50,24 +103,12 @@ Address TokenProgram::defaultTokenAddress(const Address& mainAddress, const Addr
  * https://github.com/solana-labs/solana/blob/master/sdk/program/src/pubkey.rs#L193
  */
 Address TokenProgram::findProgramAddress(const std::vector<TW::Data>& seeds, const Address& programId) {
-    Address result(Data(32));
-    // cycle through seeds for the rare case when result is not valid
-    for (uint8_t seed = 255; seed >= 0; --seed) {
-        std::vector<Data> seedsCopy;
-        for (auto& s: seeds) {
-            seedsCopy.push_back(s);
-        }
-        // add extra seed
-        seedsCopy.push_back({seed});
-        Address address = createProgramAddress(seedsCopy, Address(ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS));
-        PublicKey publicKey = PublicKey(TW::data(address.bytes.data(), address.bytes.size()), TWPublicKeyTypeED25519);
-        if (!publicKey.isValidED25519()) {
-            result = address;
-            break;
-        }
-        // try next seed
+    SHA256_CTX ctx;
+    sha256_Init(&ctx);
+    for (const auto& seed: seeds) {
+        sha256_Update(&ctx, seed.data(), seed.size());
     }
-    return result;
+    return ::findProgramAddress(ctx, programId);
 }
 
 /*
@@ -75,15 +116,62 @@ Address TokenProgram::findProgramAddress(const std::vector<TW::Data>& seeds, con
  * https://github.com/solana-labs/solana/blob/master/sdk/program/src/pubkey.rs#L135
  */
 Address TokenProgram::createProgramAddress(const std::vector<TW::Data>& seeds, const Address& programId) {
-    // concatenate seeds
-    Data hashInput;
-    for (auto& seed: seeds) {
-        append(hashInput, seed);
+    // hash seeds, programId and marker, without concatenating them
+    SHA256_CTX ctx;
+    sha256_Init(&ctx);
+    for (const auto& seed: seeds) {
+        sha256_Update(&ctx, seed.data(), seed.size());
     }
-    // append programId
-    append(hashInput, TW::data(programId.bytes.data(), programId.bytes.size()));
-    append(hashInput, TW::data("ProgramDerivedAddress"));
-    // compute hash
-    Data hash = TW::Hash::sha256(hashInput.data(), hashInput.size());
-    return Address(hash);
+    Address result = programId;
+    finishProgramAddress(ctx, programId, result);
+    return result;
+}
+
+size_t TokenAddressCache::KeyHash::operator()(const Key& key) const {
+    // addresses are uniformly distributed, use some bytes of both
+    uint64_t mainPart;
+    uint64_t mintPart;
+    std::memcpy(&mainPart, key.data(), sizeof(mainPart));
+    std::memcpy(&mintPart, key.data() + Address::size, sizeof(mintPart));
+    return static_cast<size_t>(mainPart ^ (mintPart * 0x9E3779B97F4A7C15ULL));
+}
+
+Address TokenAddressCache::defaultTokenAddress(const Address& mainAddress, const Address& tokenMintAddress) {
+    Key key;
+    std::copy(mainAddress.bytes.begin(), mainAddress.bytes.end(), key.begin());
+    std::copy(tokenMintAddress.bytes.begin(), tokenMintAddress.bytes.end(), key.begin() + Address::size);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto found = index.find(key);
+        if (found != index.end()) {
+            entries.splice(entries.begin(), entries, found->second);
+            return found->second->second;
+        }
+    }
+    // derive outside of the lock
+    const auto address = TokenProgram::defaultTokenAddress(mainAddress, tokenMintAddress);
+    if (capacity == 0) {
+        return address;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index.find(key) == index.end()) {
+        entries.emplace_front(key, address);
+        index.emplace(key, entries.begin());
+        if (entries.size() > capacity) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+    return address;
+}
+
+size_t TokenAddressCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void TokenAddressCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
 }
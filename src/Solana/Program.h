@@ -8,6 +8,10 @@
 
 #include "Address.h"
 
+#include <array>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace TW::Solana {
@@ -25,6 +29,9 @@ public:
     /// Derive default token address for main address and token
     static Address defaultTokenAddress(const Address& mainAddress, const Address& tokenMintAddress);
 
+    /// Derive default token addresses for several main addresses and the same token
+    static std::vector<Address> defaultTokenAddresses(const std::vector<Address>& mainAddresses, const Address& tokenMintAddress);
+
     /// Create a new valid address, if neeed, trying several
     static Address findProgramAddress(const std::vector<TW::Data>& seeds, const Address& programId);
 
@@ -32,4 +39,30 @@ public:
     static Address createProgramAddress(const std::vector<TW::Data>& seeds, const Address& programId);
 };
 
+/// Bounded cache of default token addresses, keyed by (main address, token mint), evicting the least recently used.
+/// Thread-safe.
+class TokenAddressCache {
+public:
+    explicit TokenAddressCache(size_t capacity) : capacity(capacity) {}
+
+    /// Derive default token address for main address and token, or return it from the cache
+    Address defaultTokenAddress(const Address& mainAddress, const Address& tokenMintAddress);
+
+    size_t size() const;
+    void clear();
+
+private:
+    using Key = std::array<byte, 2 * Address::size>;
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+    using Entry = std::pair<Key, Address>;
+
+    const size_t capacity;
+    mutable std::mutex mutex;
+    /// most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+};
+
 } // namespace TW::Solana
@@ -16,10 +16,10 @@ using namespace TW;
 using namespace TW::Solana;
 
 void Signer::sign(const std::vector<PrivateKey>& privateKeys, Transaction& transaction) {
+    const auto message = transaction.messageData();
     for (auto privateKey : privateKeys) {
         auto address = Address(privateKey.getPublicKey(TWPublicKeyTypeED25519));
         auto index = transaction.getAccountIndex(address);
-        auto message = transaction.messageData();
         auto signature = Signature(privateKey.sign(message, TWCurveED25519));
         transaction.signatures[index] = signature;
     }
@@ -86,44 +86,54 @@ void Message::compileInstructions() {
     }
 }
 
-std::string Transaction::serialize() const {
-    Data buffer;
-
-    append(buffer, shortVecLength<Signature>(this->signatures));
-    for (auto signature : this->signatures) {
-        Data signature_vec(signature.bytes.begin(), signature.bytes.end());
-        append(buffer, signature_vec);
+size_t Message::serializedSize() const {
+    size_t size = 3 + shortVecLengthSize(accountKeys.size()) + accountKeys.size() * Address::size + Solana::Hash::size;
+    size += shortVecLengthSize(compiledInstructions.size());
+    for (const auto& instruction: compiledInstructions) {
+        size += 1 + shortVecLengthSize(instruction.accounts.size()) + instruction.accounts.size() +
+                shortVecLengthSize(instruction.data.size()) + instruction.data.size();
     }
-    append(buffer, this->messageData());
-
-    return Base58::bitcoin.encode(buffer);
+    return size;
 }
 
-Data Transaction::messageData() const {
-    Data buffer;
-
-    buffer.push_back(this->message.header.numRequiredSignatures);
-    buffer.push_back(this->message.header.numCreditOnlySignedAccounts);
-    buffer.push_back(this->message.header.numCreditOnlyUnsignedAccounts);
-    append(buffer, shortVecLength<Address>(this->message.accountKeys));
-    for (auto account_key : this->message.accountKeys) {
-        Data account_key_vec(account_key.bytes.begin(), account_key.bytes.end());
-        append(buffer, account_key_vec);
+void Message::serialize(Data& buffer) const {
+    buffer.push_back(header.numRequiredSignatures);
+    buffer.push_back(header.numCreditOnlySignedAccounts);
+    buffer.push_back(header.numCreditOnlyUnsignedAccounts);
+    appendShortVecLength(buffer, accountKeys.size());
+    for (const auto& accountKey: accountKeys) {
+        buffer.insert(buffer.end(), accountKey.bytes.begin(), accountKey.bytes.end());
     }
-    Data recentBlockhash(this->message.recentBlockhash.bytes.begin(),
-                         this->message.recentBlockhash.bytes.end());
-    append(buffer, recentBlockhash);
+    buffer.insert(buffer.end(), recentBlockhash.bytes.begin(), recentBlockhash.bytes.end());
 
     // apppend compiled instructions
-    append(buffer, shortVecLength<CompiledInstruction>(message.compiledInstructions));
-    for (auto instruction : message.compiledInstructions) {
+    appendShortVecLength(buffer, compiledInstructions.size());
+    for (const auto& instruction: compiledInstructions) {
         buffer.push_back(instruction.programIdIndex);
-        append(buffer, shortVecLength<uint8_t>(instruction.accounts));
+        appendShortVecLength(buffer, instruction.accounts.size());
         append(buffer, instruction.accounts);
-        append(buffer, shortVecLength<uint8_t>(instruction.data));
+        appendShortVecLength(buffer, instruction.data.size());
         append(buffer, instruction.data);
     }
+}
 
+std::string Transaction::serialize() const {
+    Data buffer;
+    buffer.reserve(shortVecLengthSize(signatures.size()) + signatures.size() * Signature::size + message.serializedSize());
+
+    appendShortVecLength(buffer, signatures.size());
+    for (const auto& signature: signatures) {
+        buffer.insert(buffer.end(), signature.bytes.begin(), signature.bytes.end());
+    }
+    message.serialize(buffer);
+
+    return Base58::bitcoin.encode(buffer);
+}
+
+Data Transaction::messageData() const {
+    Data buffer;
+    buffer.reserve(message.serializedSize());
+    message.serialize(buffer);
     return buffer;
 }
 
@@ -29,14 +29,22 @@ const std::string STAKE_CONFIG_ID_ADDRESS = "StakeConfig111111111111111111111111
 const std::string NULL_ID_ADDRESS = "11111111111111111111111111111111";
 const std::string SYSVAR_STAKE_HISTORY_ID_ADDRESS = "SysvarStakeHistory1111111111111111111111111";
 
-template <typename T>
-Data shortVecLength(std::vector<T> vec) {
-    auto bytes = Data();
-    auto remLen = vec.size();
+/// Number of bytes of a compact-u16 ("short vec") length prefix
+inline size_t shortVecLengthSize(size_t length) {
+    size_t size = 1;
+    while (length >= 0x80) {
+        length >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+/// Append a compact-u16 ("short vec") length prefix
+inline void appendShortVecLength(Data& bytes, size_t length) {
     while (true) {
-        uint8_t elem = remLen & 0x7f;
-        remLen >>= 7;
-        if (remLen == 0) {
+        uint8_t elem = length & 0x7f;
+        length >>= 7;
+        if (length == 0) {
             bytes.push_back(elem);
             break;
         } else {
@@ -44,6 +52,12 @@ Data shortVecLength(std::vector<T> vec) {
             bytes.push_back(elem);
         }
     }
+}
+
+template <typename T>
+Data shortVecLength(const std::vector<T>& vec) {
+    auto bytes = Data();
+    appendShortVecLength(bytes, vec.size());
     return bytes;
 }
 
@@ -200,6 +214,10 @@ struct CompiledInstruction {
     // Reference to the address vector
     const std::vector<Address>& addresses;
 
+    /// Create from already resolved indices into the address vector.
+    CompiledInstruction(uint8_t programIdIndex, std::vector<uint8_t> accounts, Data data, const std::vector<Address>& addresses)
+        : programIdIndex(programIdIndex), accounts(std::move(accounts)), data(std::move(data)), addresses(addresses) {}
+
     /// Supplied address vector is expected to contain all addresses and programId from the instruction; they are replaced by index into the address vector.
     CompiledInstruction(const Instruction& instruction, const std::vector<Address>& addresses): addresses(addresses) {
         programIdIndex = findAccount(instruction.programId);
@@ -289,6 +307,11 @@ class Message {
     // compile the instructions; replace instruction accounts with indices
     void compileInstructions();
 
+    // size of the serialized message
+    size_t serializedSize() const;
+    // append the serialized message to the buffer
+    void serialize(Data& buffer) const;
+
     // This constructor creates a default single-signer Transfer message
     Message(const Address& from, const Address& to, uint64_t value, Hash recentBlockhash)
         : recentBlockhash(recentBlockhash) {
@@ -0,0 +1,198 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TransactionBuilder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Solana;
+
+namespace {
+
+/// Program ids are ordered after all instruction accounts
+constexpr uint64_t programOrderBase = 1ULL << 62;
+
+/// Bucket of an account key: signed writable, signed read-only, unsigned writable, unsigned read-only
+int bucket(bool isSigner, bool isWritable) {
+    return (isSigner ? 0 : 2) + (isWritable ? 0 : 1);
+}
+
+} // namespace
+
+size_t TransactionBuilder::AddressHash::operator()(const Address& address) const {
+    // addresses are public keys or hashes, uniformly distributed
+    size_t result;
+    std::memcpy(&result, address.bytes.data(), sizeof(result));
+    return result;
+}
+
+TransactionBuilder::TransactionBuilder(const Address& feePayer, const Hash& recentBlockhash, size_t maxSize)
+    : feePayer(feePayer), recentBlockhash(recentBlockhash), maxSize(maxSize) {
+    reset();
+}
+
+size_t TransactionBuilder::transactionSize(size_t signers, size_t keyCount, size_t instructionCount, size_t instructionsSize) {
+    return shortVecLengthSize(signers) + signers * Signature::size + 3 + shortVecLengthSize(keyCount) +
+           keyCount * Address::size + Hash::size + shortVecLengthSize(instructionCount) + instructionsSize;
+}
+
+size_t TransactionBuilder::compiledSize(const Instruction& instruction) {
+    return 1 + shortVecLengthSize(instruction.accounts.size()) + instruction.accounts.size() +
+           shortVecLengthSize(instruction.data.size()) + instruction.data.size();
+}
+
+void TransactionBuilder::reset() {
+    keys.clear();
+    signerCount = 0;
+    accountOrder = 0;
+    programOrder = 0;
+    instructions.clear();
+    instructionsSize = 0;
+    addKey(feePayer, true, true, false);
+}
+
+void TransactionBuilder::addKey(const Address& address, bool isSigner, bool isWritable, bool isProgram) {
+    const auto order = isProgram ? programOrderBase + programOrder++ : accountOrder++;
+    const auto [it, inserted] = keys.emplace(address, KeyInfo{isSigner, isWritable, order});
+    if (inserted) {
+        signerCount += isSigner;
+        return;
+    }
+    auto& info = it->second;
+    if (isSigner && !info.isSigner) {
+        info.isSigner = true;
+        ++signerCount;
+    }
+    info.isWritable = info.isWritable || isWritable;
+    if (!isProgram && info.order >= programOrderBase) {
+        // seen as program id before, now also as account
+        info.order = order;
+    }
+}
+
+void TransactionBuilder::add(const Instruction& instruction) {
+    // distinct keys of the instruction, with merged signer flag
+    std::vector<std::pair<const Address*, bool>> distinct;
+    distinct.reserve(instruction.accounts.size() + 1);
+    const auto addDistinct = [&distinct](const Address& address, bool isSigner) {
+        const auto found = std::find_if(distinct.begin(), distinct.end(), [&address](const auto& d) { return *d.first == address; });
+        if (found == distinct.end()) {
+            distinct.emplace_back(&address, isSigner);
+        } else {
+            found->second = found->second || isSigner;
+        }
+    };
+    for (const auto& account: instruction.accounts) {
+        addDistinct(account.account, account.isSigner);
+    }
+    addDistinct(instruction.programId, false);
+
+    // whether the instruction fits into the current message, or into a new one (containing only the fee payer)
+    const auto fits = [&](bool inNewMessage) {
+        size_t keyCount = inNewMessage ? 1 : keys.size();
+        size_t signers = inNewMessage ? 1 : signerCount;
+        for (const auto& [address, isSigner]: distinct) {
+            if (*address == feePayer) {
+                continue;
+            }
+            if (inNewMessage) {
+                ++keyCount;
+                signers += isSigner;
+                continue;
+            }
+            const auto found = keys.find(*address);
+            keyCount += found == keys.end();
+            signers += isSigner && (found == keys.end() || !found->second.isSigner);
+        }
+        const auto count = inNewMessage ? 1 : instructions.size() + 1;
+        const auto size = (inNewMessage ? 0 : instructionsSize) + compiledSize(instruction);
+        return keyCount <= maxAccountKeys && transactionSize(signers, keyCount, count, size) <= maxSize;
+    };
+    if (!fits(false)) {
+        if (!fits(true)) {
+            throw std::invalid_argument("Instruction too large for a transaction");
+        }
+        finishMessage();
+    }
+
+    for (const auto& account: instruction.accounts) {
+        addKey(account.account, account.isSigner, !account.isReadOnly, false);
+    }
+    addKey(instruction.programId, false, false, true);
+    instructions.push_back(instruction);
+    instructionsSize += compiledSize(instruction);
+}
+
+void TransactionBuilder::addTransfer(const Address& from, const Address& to, uint64_t value) {
+    add(Instruction(std::vector<AccountMeta>{
+        AccountMeta(from, true, false),
+        AccountMeta(to, false, false),
+    }, value));
+}
+
+void TransactionBuilder::addTokenTransfer(const Address& signer, const Address& tokenMintAddress, const Address& senderTokenAddress,
+                                          const Address& recipientTokenAddress, uint64_t amount, uint8_t decimals) {
+    add(Instruction(TokenInstruction::TokenTransfer, std::vector<AccountMeta>{
+        AccountMeta(senderTokenAddress, false, false),
+        AccountMeta(tokenMintAddress, false, true),
+        AccountMeta(recipientTokenAddress, false, false),
+        AccountMeta(signer, true, false),
+    }, amount, decimals));
+}
+
+void TransactionBuilder::finishMessage() {
+    std::vector<std::pair<const Address*, const KeyInfo*>> sorted;
+    sorted.reserve(keys.size());
+    for (const auto& [address, info]: keys) {
+        sorted.emplace_back(&address, &info);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+        const auto lhsBucket = bucket(lhs.second->isSigner, lhs.second->isWritable);
+        const auto rhsBucket = bucket(rhs.second->isSigner, rhs.second->isWritable);
+        return lhsBucket != rhsBucket ? lhsBucket < rhsBucket : lhs.second->order < rhs.second->order;
+    });
+
+    messages.emplace_back();
+    auto& message = messages.back();
+    message.recentBlockhash = recentBlockhash;
+    message.accountKeys.reserve(sorted.size());
+    std::unordered_map<Address, uint8_t, AddressHash> indices;
+    indices.reserve(sorted.size());
+    for (const auto& [address, info]: sorted) {
+        indices.emplace(*address, static_cast<uint8_t>(message.accountKeys.size()));
+        message.accountKeys.push_back(*address);
+        switch (bucket(info->isSigner, info->isWritable)) {
+            case 0: ++message.header.numRequiredSignatures; break;
+            case 1: ++message.header.numRequiredSignatures; ++message.header.numCreditOnlySignedAccounts; break;
+            case 3: ++message.header.numCreditOnlyUnsignedAccounts; break;
+            default: break;
+        }
+    }
+
+    message.compiledInstructions.reserve(instructions.size());
+    for (const auto& instruction: instructions) {
+        std::vector<uint8_t> accounts;
+        accounts.reserve(instruction.accounts.size());
+        for (const auto& account: instruction.accounts) {
+            accounts.push_back(indices.at(account.account));
+        }
+        message.compiledInstructions.emplace_back(indices.at(instruction.programId), std::move(accounts), instruction.data, message.accountKeys);
+    }
+    message.instructions = std::move(instructions);
+    reset();
+}
+
+std::vector<Message> TransactionBuilder::build() {
+    if (!instructions.empty()) {
+        finishMessage();
+    }
+    auto result = std::move(messages);
+    messages.clear();
+    return result;
+}
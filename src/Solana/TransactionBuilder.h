@@ -0,0 +1,76 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Transaction.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace TW::Solana {
+
+/// Builds messages with many instructions, e.g. batched SOL and token transfers to many recipients.
+///
+/// Account keys are deduplicated through a hash index, merging their signer and writable flags, and ordered as
+/// signed writable, signed read-only, unsigned writable, unsigned read-only (program ids last within their bucket).
+/// When an instruction would make the signed transaction exceed the size limit, a new message is started.
+class TransactionBuilder {
+  public:
+    /// Maximum size of a serialized transaction (IPv6 minimum MTU minus headers)
+    static constexpr size_t maxTransactionSize = 1232;
+    /// Account indices are single bytes
+    static constexpr size_t maxAccountKeys = 256;
+
+    /// The fee payer is the first signer of every message.
+    TransactionBuilder(const Address& feePayer, const Hash& recentBlockhash, size_t maxSize = maxTransactionSize);
+
+    /// Add an instruction, to the current message if it fits, otherwise to a new one.
+    /// Throws if it does not fit into a message on its own.
+    void add(const Instruction& instruction);
+    /// Add a system transfer
+    void addTransfer(const Address& from, const Address& to, uint64_t value);
+    /// Add a token transfer (transfer_checked); see Message for the token transfer message
+    void addTokenTransfer(const Address& signer, const Address& tokenMintAddress, const Address& senderTokenAddress,
+                          const Address& recipientTokenAddress, uint64_t amount, uint8_t decimals);
+
+    /// Serialized size of the transaction of the current message, including its signatures
+    size_t transactionSize() const { return transactionSize(signerCount, keys.size(), instructions.size(), instructionsSize); }
+
+    /// Return the messages built, in order, and reset the builder
+    std::vector<Message> build();
+
+  private:
+    struct AddressHash {
+        size_t operator()(const Address& address) const;
+    };
+    struct KeyInfo {
+        bool isSigner;
+        bool isWritable;
+        /// first appearance, instruction accounts before program ids
+        uint64_t order;
+    };
+
+    static size_t transactionSize(size_t signers, size_t keyCount, size_t instructionCount, size_t instructionsSize);
+    static size_t compiledSize(const Instruction& instruction);
+    void addKey(const Address& address, bool isSigner, bool isWritable, bool isProgram);
+    void reset();
+    void finishMessage();
+
+    const Address feePayer;
+    const Hash recentBlockhash;
+    const size_t maxSize;
+
+    std::unordered_map<Address, KeyInfo, AddressHash> keys;
+    size_t signerCount = 0;
+    uint64_t accountOrder = 0;
+    uint64_t programOrder = 0;
+    std::vector<Instruction> instructions;
+    size_t instructionsSize = 0;
+    std::vector<Message> messages;
+};
+
+} // namespace TW::Solana
@@ -10,10 +10,14 @@
 
 #include <boost/crc.hpp>  // for boost::crc_32_type
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace TW::TON {
 
@@ -166,9 +170,24 @@ Data Slice::hash() const {
 }
 
 
-Cell::Cell(const Cell& from) : _cells(from._cells), _slice(from._slice) {}
+Cell::Cell(const Cell& from) : _cells(from._cells), _slice(from._slice) {
+    // the copy is not referenced by any parent, so it is not sealed
+    if (from._hashValid.load(std::memory_order_acquire)) {
+        _hash = from._hash;
+        _depth = from._depth;
+        _hashValid.store(true, std::memory_order_release);
+    }
+}
+
+void Cell::resetHash() {
+    if (_sealed.load(std::memory_order_acquire)) {
+        throw std::logic_error("Cell: cannot modify a cell hashed as part of a parent");
+    }
+    _hashValid.store(false, std::memory_order_release);
+}
 
 void Cell::setSlice(Slice const& slice) {
+    resetHash();
     _slice = slice;
 }
 
@@ -191,6 +210,7 @@ void Cell::addCell(std::shared_ptr<Cell> const& cell) {
     if (cellCount() >= max_cells) {
         throw std::runtime_error("too many cells");
     }
+    resetHash();
     _cells.push_back(cell);
 }
 
@@ -215,62 +235,168 @@ std::string Cell::toString() const {
 }
 
 Data Cell::hash() const {
+    computeHashes();
+    return Data(_hash.begin(), _hash.end());
+}
+
+uint16_t Cell::depth() const {
+    computeHashes();
+    return _depth;
+}
+
+void Cell::computeHashes() const {
+    // post-order traversal with an explicit stack; a cell is hashed once all its children are
+    std::vector<const Cell*> stack{this};
+    while (!stack.empty()) {
+        const Cell* cell = stack.back();
+        if (cell->_hashValid.load(std::memory_order_acquire)) {
+            stack.pop_back();
+            continue;
+        }
+        bool childrenReady = true;
+        for (const auto& child: cell->_cells) {
+            if (!child->_hashValid.load(std::memory_order_acquire)) {
+                stack.push_back(child.get());
+                childrenReady = false;
+            }
+        }
+        if (childrenReady) {
+            cell->computeOwnHash();
+            stack.pop_back();
+        }
+    }
+}
+
+void Cell::computeOwnHash() const {
+    // another thread may be hashing the same cell
+    std::lock_guard<std::mutex> lock(_hashMutex);
+    if (_hashValid.load(std::memory_order_acquire)) {
+        return;
+    }
     // Need to copy data together into a contiguous area
     Data hashData;
+    hashData.reserve(2 + _slice.size() + cellCount() * (2 + _hash.size()));
     // number of children
     hashData.push_back(static_cast<byte>(cellCount()));
     // number of hex digits
-    size_t bits = _slice.sizeBits(); // may be 0
-    hashData.push_back(d2(bits));
+    hashData.push_back(d2(_slice.sizeBits()));
     // data
-    if (_slice.size() > 0) {
-        append(hashData, _slice.data());
-    }
-    // children
-    if (cellCount() > 0) {
-        for (auto i = _cells.begin(), n = _cells.end(); i != n; ++i) {
-            hashData.push_back(0);
-            hashData.push_back(0);
-        }
-        for (auto i = _cells.begin(), n = _cells.end(); i != n; ++i) {
-            auto childHash = i->get()->hash();
-            append(hashData, childHash);
-        }
+    append(hashData, _slice.data());
+    // children: depths (2 bytes, big endian), then hashes
+    uint16_t depth = 0;
+    for (const auto& child: _cells) {
+        assert(child->_hashValid.load(std::memory_order_acquire));
+        hashData.push_back(static_cast<byte>(child->_depth >> 8));
+        hashData.push_back(static_cast<byte>(child->_depth & 0xFF));
+        depth = std::max(depth, static_cast<uint16_t>(child->_depth + 1));
+    }
+    for (const auto& child: _cells) {
+        hashData.insert(hashData.end(), child->_hash.begin(), child->_hash.end());
     }
     // compute hash
-    return Hash::sha256(hashData);
+    const auto hash = Hash::sha256(hashData);
+    std::copy(hash.begin(), hash.end(), _hash.begin());
+    _depth = depth;
+    // children are now part of this hash, changing them would leave it stale
+    for (const auto& child: _cells) {
+        child->_sealed.store(true, std::memory_order_release);
+    }
+    _hashValid.store(true, std::memory_order_release);
+}
+
+namespace {
+
+struct HashKeyHasher {
+    size_t operator()(const std::array<byte, 32>& hash) const {
+        // the hash is uniformly distributed already
+        size_t result;
+        std::memcpy(&result, hash.data(), sizeof(result));
+        return result;
+    }
+};
+
+/// Number of bytes needed to store values up to `value`, at least 1
+int byteSize(size_t value) {
+    int size = 1;
+    while (size < 8 && value >= (1ULL << (size * 8))) { ++size; }
+    return size;
 }
 
+void appendBigEndian(Data& data, uint64_t value, int size) {
+    for (int i = size - 1; i >= 0; --i) {
+        data.push_back(static_cast<byte>(value >> (i * 8)));
+    }
+}
+
+uint64_t readBigEndian(const Data& data, size_t& offset, int size) {
+    if (offset + size > data.size()) {
+        throw std::invalid_argument("Cell::deserialize: data too short");
+    }
+    uint64_t value = 0;
+    for (int i = 0; i < size; ++i) {
+        value = (value << 8) | data[offset++];
+    }
+    return value;
+}
+
+} // namespace
+
 Cell::SerializationInfo Cell::getSerializationInfo(SerializationMode mode) const {
     SerializationInfo info = SerializationInfo();
-    size_t rawDataSize = serializedOwnSize();
-    for (auto c: _cells) {
-        rawDataSize += c->serializedOwnSize();
-    }
-    int intRefs = (int)cellCount();
-    uint8_t refSize = 1;
-    while (cellCount() >= ((size_t)1 << (refSize * 8))) { ++refSize; }
-    assert(refSize >= 1 && refSize <= 8);
-    size_t hashes = 0;
-    size_t dataBytesAdj = rawDataSize + (size_t)intRefs * refSize + hashes;
-    size_t maxOffset = (mode & SerializationMode::WithCacheBits) ? dataBytesAdj * 2 : dataBytesAdj;
-    int offsetSize = 0;
-    while (maxOffset >= (1ULL << (offsetSize * 8))) { ++offsetSize; }
-    if (refSize > 4 || offsetSize > 8) { return info; }
+    computeHashes();
+
+    // Collect distinct cells (by hash), counting the references to each
+    std::unordered_map<std::array<byte, 32>, size_t, HashKeyHasher> indices;
+    std::vector<const Cell*> unique;
+    std::vector<size_t> inDegree;
+    std::vector<const Cell*> stack{this};
+    indices.emplace(_hash, 0);
+    unique.push_back(this);
+    inDegree.push_back(0);
+    size_t refCount = 0;
+    while (!stack.empty()) {
+        const Cell* cell = stack.back();
+        stack.pop_back();
+        refCount += cell->cellCount();
+        for (const auto& child: cell->_cells) {
+            const auto [it, inserted] = indices.emplace(child->_hash, unique.size());
+            if (inserted) {
+                unique.push_back(child.get());
+                inDegree.push_back(0);
+                stack.push_back(child.get());
+            }
+            ++inDegree[it->second];
+        }
+    }
+
+    // Topological order (Kahn), breadth first from the root, so that every cell is referenced only by earlier ones
+    info.cells.reserve(unique.size());
+    info.cells.push_back(this);
+    size_t rawDataSize = 0;
+    for (size_t i = 0; i < info.cells.size(); ++i) {
+        const Cell* cell = info.cells[i];
+        rawDataSize += cell->serializedOwnSize();
+        for (const auto& child: cell->_cells) {
+            const auto index = indices.at(child->_hash);
+            if (--inDegree[index] == 0) {
+                info.cells.push_back(unique[index]);
+            }
+        }
+    }
+    assert(info.cells.size() == unique.size());
 
-    info.refByteSize = refSize;
-    info.offsetByteSize = 1;
     info.rootCount = 1;
-    info.cellCount = info.rootCount + (int)cellCount();  // including self/roots
+    info.cellCount = (int)info.cells.size();  // including self/roots
+    info.refByteSize = byteSize(info.cells.size());
+    size_t hashes = 0;
+    size_t dataBytesAdj = rawDataSize + refCount * info.refByteSize + hashes;
+    size_t maxOffset = (mode & SerializationMode::WithCacheBits) ? dataBytesAdj * 2 : dataBytesAdj;
+    info.offsetByteSize = byteSize(maxOffset);
     info.hasCrc32c = mode & SerializationMode::WithCRC32C;
     int crcSize = info.hasCrc32c ? 4 : 0;
-    int rootCount = 0;
     unsigned long rootsOffset = 4 + 1 + 1 + 3 * info.refByteSize + info.offsetByteSize;
-    unsigned long indexOffset = rootsOffset + rootCount * info.refByteSize;
+    unsigned long indexOffset = rootsOffset + info.rootCount * info.refByteSize;
     unsigned long dataOffset = indexOffset;
-    //if (info.has_index) {
-        //info.data_offset += (long long)cell_count * info.offset_byte_size;
-    //}
     // Magic num idx 68ff65f3  idxCrc32c acc3a728  generic b5ee9c72
     info.magic = parse_hex("b5ee9c72");
     info.dataSize = dataBytesAdj;
@@ -284,43 +410,28 @@ size_t Cell::serializedOwnSize(bool withHashes) const {
 }
 
 size_t Cell::serializedSize(SerializationMode mode) const {
-    auto info = getSerializationInfo(mode);
-    size_t ss = 0;
-    ss += 4; // magic
-    ss += 5; // byte1, offsetByteSize, cellCount, rootCount, 
-    ss += info.offsetByteSize; // dataSize
-    ss += info.rootCount; // roots
-
-    ss += serializedOwnSize(false);
-    ss += cellCount(); // cell refs
-
-    // child cells
-    for(auto c: _cells) {
-        ss += c->serializedOwnSize(false);
-    }
-
-    if (mode & SerializationMode::WithCRC32C) {
-        ss += 4;
-    }
-    return ss;
+    return getSerializationInfo(mode).totalSize;
 }
 
-void Cell::serializeOwn(TW::Data& data_inout, bool withHashes) {
+void Cell::serializeOwn(TW::Data& data_inout, bool withHashes) const {
     if (withHashes) { throw std::invalid_argument("Cell::serializedOwnSize: WithHashes not supported"); }
-    //auto info = getSerializationInfo(mode);
     // slice
     data_inout.push_back((byte)cellCount());
     data_inout.push_back(d2(_slice.sizeBits()));
     append(data_inout, _slice.data());
 }
 
-void Cell::serialize(TW::Data& data_inout, SerializationMode mode) {
+void Cell::serialize(TW::Data& data_inout, SerializationMode mode) const {
     if (mode != SerializationMode::None && mode != SerializationMode::WithCRC32C) {
         throw std::invalid_argument("Cell::serialize: Mode " + std::to_string((int)mode) + " not supported");
     }
     // save current start position
     size_t startIdx = data_inout.size();
     auto info = getSerializationInfo(mode);
+    if (info.refByteSize > 4) {
+        throw std::invalid_argument("Cell::serialize: too many cells");
+    }
+    data_inout.reserve(startIdx + info.totalSize);
 
     // magic
     append(data_inout, info.magic);
@@ -330,31 +441,26 @@ void Cell::serialize(TW::Data& data_inout, SerializationMode mode) {
     if (info.hasCrc32c) { byte1 |= 1 << 6; }
     //if (info.has_cache_bits) { byte |= 1 << 5; }
     // 3, 4 - flags
-    if (info.refByteSize < 1 || info.refByteSize > 7) {
-        //cerr << info.refByteSize << endl;
-        return;
-    }
     byte1 |= static_cast<byte>(info.refByteSize);
     data_inout.push_back(byte1);
     data_inout.push_back((byte)info.offsetByteSize);
-    data_inout.push_back((byte)info.cellCount);
-    data_inout.push_back((byte)info.rootCount);
-    data_inout.push_back(0);
-    data_inout.push_back((byte)info.dataSize); // offset
-    data_inout.push_back(0); // roots
-
-    // own cell (slice)
-    serializeOwn(data_inout, false);
-    // cell refs?
-    uint8_t cidx = 0;
-    for(auto c: _cells) {
-        ++cidx;
-        data_inout.push_back(cidx);
+    appendBigEndian(data_inout, info.cellCount, info.refByteSize);
+    appendBigEndian(data_inout, info.rootCount, info.refByteSize);
+    appendBigEndian(data_inout, 0, info.refByteSize); // absent
+    appendBigEndian(data_inout, info.dataSize, info.offsetByteSize);
+    appendBigEndian(data_inout, 0, info.refByteSize); // root index
+
+    // cells, each followed by the indices of its children
+    std::unordered_map<std::array<byte, 32>, size_t, HashKeyHasher> indices;
+    indices.reserve(info.cells.size());
+    for (size_t i = 0; i < info.cells.size(); ++i) {
+        indices.emplace(info.cells[i]->_hash, i);
     }
-
-    // child cells
-    for(auto c: _cells) {
-        c->serializeOwn(data_inout, false);
+    for (const auto* cell: info.cells) {
+        cell->serializeOwn(data_inout, false);
+        for (const auto& child: cell->_cells) {
+            appendBigEndian(data_inout, indices.at(child->_hash), info.refByteSize);
+        }
     }
 
     if (mode & SerializationMode::WithCRC32C) {
@@ -367,6 +473,107 @@ void Cell::serialize(TW::Data& data_inout, SerializationMode mode) {
     }
 }
 
+std::shared_ptr<Cell> Cell::deserialize(const Data& data) {
+    size_t offset = 0;
+    if (data.size() < 6 || !std::equal(data.begin(), data.begin() + 4, parse_hex("b5ee9c72").begin())) {
+        throw std::invalid_argument("Cell::deserialize: unsupported magic");
+    }
+    offset = 4;
+    const byte byte1 = data[offset++];
+    const bool hasIndex = byte1 & (1 << 7);
+    const bool hasCrc32c = byte1 & (1 << 6);
+    const int refByteSize = byte1 & 7;
+    if ((byte1 & 0x18) != 0 || refByteSize < 1 || refByteSize > 4) {
+        throw std::invalid_argument("Cell::deserialize: invalid flags");
+    }
+    const int offsetByteSize = data[offset++];
+    if (offsetByteSize < 1 || offsetByteSize > 8) {
+        throw std::invalid_argument("Cell::deserialize: invalid offset size");
+    }
+    const auto cellCount = readBigEndian(data, offset, refByteSize);
+    const auto rootCount = readBigEndian(data, offset, refByteSize);
+    const auto absentCount = readBigEndian(data, offset, refByteSize);
+    const auto dataSize = readBigEndian(data, offset, offsetByteSize);
+    if (rootCount != 1 || absentCount != 0 || cellCount == 0) {
+        throw std::invalid_argument("Cell::deserialize: exactly one root and no absent cells supported");
+    }
+    const auto rootIndex = readBigEndian(data, offset, refByteSize);
+    if (rootIndex >= cellCount) {
+        throw std::invalid_argument("Cell::deserialize: invalid root index");
+    }
+    if (hasIndex) {
+        offset += cellCount * offsetByteSize;
+    }
+    const size_t crcSize = hasCrc32c ? 4 : 0;
+    if (offset > data.size() || data.size() - offset != dataSize + crcSize || cellCount > dataSize / 2) {
+        throw std::invalid_argument("Cell::deserialize: size mismatch");
+    }
+    if (hasCrc32c) {
+        const size_t crcOffset = data.size() - 4;
+        const uint32_t crc = data[crcOffset] | (data[crcOffset + 1] << 8) | (data[crcOffset + 2] << 16) | ((uint32_t)data[crcOffset + 3] << 24);
+        if (crc != computeCrc(data.data(), crcOffset)) {
+            throw std::invalid_argument("Cell::deserialize: CRC mismatch");
+        }
+    }
+
+    // Parse raw cells; references must point to later cells
+    struct RawCell {
+        Slice slice;
+        std::vector<size_t> refs;
+    };
+    std::vector<RawCell> raw(cellCount);
+    for (size_t i = 0; i < cellCount; ++i) {
+        const auto d1 = readBigEndian(data, offset, 1);
+        const auto d2 = readBigEndian(data, offset, 1);
+        const size_t refCount = d1 & 7;
+        if ((d1 & ~7ULL) != 0 || refCount > max_cells) {
+            throw std::invalid_argument("Cell::deserialize: exotic, higher level or hashed cells not supported");
+        }
+        const size_t size = (d2 + 1) / 2;
+        if (offset + size > data.size()) {
+            throw std::invalid_argument("Cell::deserialize: data too short");
+        }
+        Data bytes(data.begin() + offset, data.begin() + offset + size);
+        offset += size;
+        if (size > 0) {
+            size_t sizeBits = size * 8;
+            if (d2 & 1) {
+                // incomplete last byte, terminated by the highest unused bit set to 1
+                const byte last = bytes.back();
+                if ((last & 0x7F) == 0) {
+                    throw std::invalid_argument("Cell::deserialize: invalid completion tag");
+                }
+                int unused = 1;
+                while (((last >> (unused - 1)) & 1) == 0) { ++unused; }
+                sizeBits -= unused;
+            }
+            raw[i].slice = Slice::createFromBits(bytes, sizeBits);
+        }
+        for (size_t r = 0; r < refCount; ++r) {
+            const auto ref = readBigEndian(data, offset, refByteSize);
+            if (ref <= i || ref >= cellCount) {
+                throw std::invalid_argument("Cell::deserialize: invalid cell reference");
+            }
+            raw[i].refs.push_back(ref);
+        }
+    }
+    if (offset + crcSize != data.size()) {
+        throw std::invalid_argument("Cell::deserialize: size mismatch");
+    }
+
+    // Build cells last to first, so children exist before their parents
+    std::vector<std::shared_ptr<Cell>> cells(cellCount);
+    for (size_t i = cellCount; i-- > 0;) {
+        auto cell = std::make_shared<Cell>();
+        cell->_slice = raw[i].slice;
+        for (const auto ref: raw[i].refs) {
+            cell->_cells.push_back(cells[ref]);
+        }
+        cells[i] = cell;
+    }
+    return cells[rootIndex];
+}
+
 uint32_t Cell::computeCrc(const byte* data, size_t len) {
     // CRC32-C
     using crc_32c_type = boost::crc_optimal<32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true, true>;
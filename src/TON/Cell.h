@@ -8,7 +8,10 @@
 
 #include "../Data.h"
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 namespace TW::TON {
 
@@ -62,6 +65,8 @@ public:
     class SerializationInfo {
     public:
         std::vector<uint8_t> magic;
+        /// Distinct cells in serialization order, root first; cells only refer to cells after them
+        std::vector<const Cell*> cells;
         int rootCount;
         int cellCount;
         //int absent_count;
@@ -92,15 +97,24 @@ public:
     Slice const& getSlice() const { return _slice; }
     const std::vector<std::shared_ptr<Cell>>& getCells() const { return _cells; }
     std::string toString() const;
+    /// Representation hash.  Hashes and depths are cached per cell and computed once, iteratively, so shared
+    /// subtrees are not rehashed; the cache is safe to fill from several threads.  The cache of a cell is reset
+    /// when it is modified.  Once a parent has been hashed, its descendants are sealed: modifying them throws
+    /// `std::logic_error`, as the parent would keep a stale hash.
     Data hash() const;
+    /// Depth of the cell tree, 0 for a cell without children.  Cached together with the hash.
+    uint16_t depth() const;
     /// Serialized size of this cell only, without children
     size_t serializedOwnSize(bool withHashes = false) const;
     /// Serialized size, including children
     size_t serializedSize(SerializationMode mode = SerializationMode::None) const;
     /// Serialize this cell only, without children
-    void serializeOwn(TW::Data& data_inout, bool withHashes = false);
-    /// Serialize this cell, including children
-    void serialize(TW::Data& data_inout, SerializationMode mode = SerializationMode::None);
+    void serializeOwn(TW::Data& data_inout, bool withHashes = false) const;
+    /// Serialize this cell as a bag of cells, including all descendants.  Identical cells (same hash) are stored once.
+    void serialize(TW::Data& data_inout, SerializationMode mode = SerializationMode::None) const;
+    /// Parse a bag of cells with a single root, as produced by serialize.  Throws on invalid or unsupported
+    /// input (exotic cells, stored hashes).
+    static std::shared_ptr<Cell> deserialize(const Data& data);
     static const size_t max_cells = 4;
     /// second byte in length
     static byte d2(size_t bits);
@@ -109,10 +123,24 @@ private:
     static uint32_t computeCrc(const byte* data, size_t len);
     // Prepare serialization properties
     SerializationInfo getSerializationInfo(SerializationMode mode = SerializationMode::None) const;
+    /// Compute the missing hashes of this cell and its descendants, children first
+    void computeHashes() const;
+    /// Compute the hash of this cell, hashes of children must be available
+    void computeOwnHash() const;
+    /// Invalidate the cached hash before a change.  Throws if the cell is sealed.
+    void resetHash();
 
 private:
     std::vector<std::shared_ptr<Cell>> _cells;
     Slice _slice;
+    /// Guards the computation of the cached hash and depth
+    mutable std::mutex _hashMutex;
+    mutable std::array<byte, 32> _hash{};
+    mutable uint16_t _depth = 0;
+    /// Set, with release ordering, once `_hash` and `_depth` are written
+    mutable std::atomic<bool> _hashValid{false};
+    /// Set once a parent has been hashed over this cell
+    mutable std::atomic<bool> _sealed{false};
 };
 
 } // namespace TW::TON
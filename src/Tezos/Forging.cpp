@@ -4,6 +4,7 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include "Forging.h"
 #include "Address.h"
 #include "BinaryCoding.h"
 #include "../Base58.h"
@@ -19,117 +20,138 @@ using namespace TW::Tezos::Proto;
 
 // Forge the given boolean into a hex encoded string.
 Data forgeBool(bool input) {
-    unsigned char result = input ? 0xff : 0x00;
-    return Data{result};
+    Data forged;
+    forgeBool(input, forged);
+    return forged;
+}
+
+void forgeBool(bool input, Data& out) {
+    out.push_back(input ? 0xff : 0x00);
 }
 
 // Forge the given public key hash into a hex encoded string.
 // Note: This function supports tz1, tz2 and tz3 addresses.
 Data forgePublicKeyHash(const std::string& publicKeyHash) {
-    Data forged = Data();
+    Data forged;
+    forgePublicKeyHash(publicKeyHash, forged);
+    return forged;
+}
+
+void forgePublicKeyHash(const std::string& publicKeyHash, Data& out) {
     // Adjust prefix based on tz1, tz2 or tz3.
-    switch ((char)publicKeyHash[2]) {
+    byte tag;
+    switch (publicKeyHash.size() > 2 ? publicKeyHash[2] : '\0') {
     case '1':
-        forged.push_back(0x00);
+        tag = 0x00;
         break;
     case '2':
-        forged.push_back(0x01);
+        tag = 0x01;
         break;
     case '3':
-        forged.push_back(0x02);
+        tag = 0x02;
         break;
     default:
         throw std::invalid_argument("Invalid Prefix");
     }
     const auto decoded = Base58::bitcoin.decodeCheck(publicKeyHash);
     const auto prefixSize = 3;
-    forged.insert(forged.end(), decoded.begin() + prefixSize, decoded.end());
-    return forged;
+    if (decoded.size() != prefixSize + 20) {
+        throw std::invalid_argument("Invalid public key hash");
+    }
+    out.push_back(tag);
+    out.insert(out.end(), decoded.begin() + prefixSize, decoded.end());
 }
 
 // Forge the given public key into a hex encoded string.
 Data forgePublicKey(PublicKey publicKey) {
-    std::array<uint8_t, 4> prefix = {13, 15, 37, 217};
-    auto data = Data(prefix.begin(), prefix.end());
-    auto bytes = Data(publicKey.bytes.begin(), publicKey.bytes.end());
-    append(data, bytes);
-
-    auto pk = Base58::bitcoin.encodeCheck(data);
-    auto decoded = "00" + base58ToHex(pk, 4, prefix.data());
-    return parse_hex(decoded);
+    Data forged;
+    forgePublicKey(publicKey, forged);
+    return forged;
+}
+
+void forgePublicKey(const PublicKey& publicKey, Data& out) {
+    // ed25519 tag, and the key
+    out.push_back(0x00);
+    append(out, publicKey.bytes);
 }
 
 // Forge the given zarith hash into a hex encoded string.
 Data forgeZarith(uint64_t input) {
-    Data forged = Data();
+    Data forged;
+    forgeZarith(input, forged);
+    return forged;
+}
+
+void forgeZarith(uint64_t input, Data& out) {
     while (input >= 0x80) {
-        forged.push_back(static_cast<byte>((input & 0xff) | 0x80));
+        out.push_back(static_cast<byte>((input & 0xff) | 0x80));
         input >>= 7;
     }
-    forged.push_back(static_cast<byte>(input));
-    return forged;
+    out.push_back(static_cast<byte>(input));
 }
 
 // Forge the given operation.
 Data forgeOperation(const Operation& operation) {
-    auto forged = Data();
-    auto source = Address(operation.source());
-    auto forgedSource = source.forge();
-    auto forgedFee = forgeZarith(operation.fee());
-    auto forgedCounter = forgeZarith(operation.counter());
-    auto forgedGasLimit = forgeZarith(operation.gas_limit());
-    auto forgedStorageLimit = forgeZarith(operation.storage_limit());
-
-    if (operation.kind() == Operation_OperationKind_REVEAL) {
-        auto publicKey = PublicKey(data(operation.reveal_operation_data().public_key()), TWPublicKeyTypeED25519);
-        auto forgedPublicKey = forgePublicKey(publicKey);
-        
-        forged.push_back(Operation_OperationKind_REVEAL);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
-        append(forged, forgedPublicKey);
-        return forged;
-    }
+    Data forged;
+    OperationForger().forge(operation, forged);
+    return forged;
+}
 
-    if (operation.kind() == Operation_OperationKind_DELEGATION) {
-        auto delegate = operation.delegation_operation_data().delegate();
-
-        forged.push_back(Operation_OperationKind_DELEGATION);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
-        if (!delegate.empty()) {
-            auto forgedPublicKeyHash = forgePublicKeyHash(delegate);
-
-            append(forged, forgeBool(true));
-            append(forged, forgedPublicKeyHash);
-        } else {
-            append(forged, forgeBool(false));
-        }
-        return forged;
+void OperationForger::forgePublicKeyHash(const std::string& publicKeyHash, Data& out) {
+    const auto found = forgedHashes.find(publicKeyHash);
+    if (found != forgedHashes.end()) {
+        out.insert(out.end(), found->second.begin(), found->second.end());
+        return;
+    }
+    const auto start = out.size();
+    ::forgePublicKeyHash(publicKeyHash, out);
+    if (out.size() - start == forgedHashSize) {
+        std::array<byte, forgedHashSize> forged;
+        std::copy(out.begin() + start, out.end(), forged.begin());
+        forgedHashes.emplace(publicKeyHash, forged);
     }
+}
 
-    if (operation.kind() == Operation_OperationKind_TRANSACTION) {
-        auto forgedAmount = forgeZarith(operation.transaction_operation_data().amount());
-        auto forgedDestination = Address(operation.transaction_operation_data().destination()).forge();
-
-        forged.push_back(Operation_OperationKind_TRANSACTION);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
-        append(forged, forgedAmount);
-        append(forged, forgeBool(false));
-        append(forged, forgedDestination);
-        append(forged, forgeBool(false));
-        return forged;
+void OperationForger::forge(const Operation& operation, Data& out) {
+    // validate before appending anything
+    if (operation.kind() != Operation_OperationKind_REVEAL && operation.kind() != Operation_OperationKind_DELEGATION &&
+        operation.kind() != Operation_OperationKind_TRANSACTION) {
+        throw std::invalid_argument("Invalid operation kind");
     }
+    const auto start = out.size();
+    try {
+        out.push_back(static_cast<byte>(operation.kind()));
+        forgePublicKeyHash(operation.source(), out);
+        forgeZarith(operation.fee(), out);
+        forgeZarith(operation.counter(), out);
+        forgeZarith(operation.gas_limit(), out);
+        forgeZarith(operation.storage_limit(), out);
+
+        switch (operation.kind()) {
+        case Operation_OperationKind_REVEAL:
+            forgePublicKey(PublicKey(data(operation.reveal_operation_data().public_key()), TWPublicKeyTypeED25519), out);
+            break;
+
+        case Operation_OperationKind_DELEGATION: {
+            const auto& delegate = operation.delegation_operation_data().delegate();
+            if (!delegate.empty()) {
+                forgeBool(true, out);
+                forgePublicKeyHash(delegate, out);
+            } else {
+                forgeBool(false, out);
+            }
+            break;
+        }
 
-    throw std::invalid_argument("Invalid operation kind");
+        default: // Operation_OperationKind_TRANSACTION
+            forgeZarith(operation.transaction_operation_data().amount(), out);
+            forgeBool(false, out);
+            forgePublicKeyHash(operation.transaction_operation_data().destination(), out);
+            forgeBool(false, out);
+            break;
+        }
+    } catch (...) {
+        out.resize(start);
+        throw;
+    }
 }
@@ -4,10 +4,14 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#pragma once
+
 #include "../PublicKey.h"
 #include "../proto/Tezos.pb.h"
 
+#include <array>
 #include <string>
+#include <unordered_map>
 
 using namespace TW;
 using namespace TW::Tezos::Proto;
@@ -17,3 +21,28 @@ Data forgeOperation(const Operation& operation);
 Data forgePublicKeyHash(const std::string& publicKeyHash);
 Data forgePublicKey(PublicKey publicKey);
 Data forgeZarith(uint64_t input);
+
+/// Appending variants, forging directly at the end of `out`.
+void forgeBool(bool input, Data& out);
+void forgePublicKeyHash(const std::string& publicKeyHash, Data& out);
+void forgePublicKey(const PublicKey& publicKey, Data& out);
+void forgeZarith(uint64_t input, Data& out);
+
+namespace TW::Tezos {
+
+/// Forges operations, appending them to a buffer.  Forged public key hashes are cached, so sources and repeated
+/// destinations (e.g. of payouts) are Base58-decoded only once.
+class OperationForger {
+  public:
+    /// Forge the given operation, appending it to `out`.
+    void forge(const Operation& operation, Data& out);
+    /// Forge the given public key hash (tz1, tz2, tz3), appending it to `out`.
+    void forgePublicKeyHash(const std::string& publicKeyHash, Data& out);
+
+  private:
+    /// Forged size of a public key hash: tag and 20-byte hash
+    static constexpr size_t forgedHashSize = 21;
+    std::unordered_map<std::string, std::array<byte, forgedHashSize>> forgedHashes;
+};
+
+} // namespace TW::Tezos
@@ -11,6 +11,8 @@
 #include "../Base58.h"
 #include "../proto/Tezos.pb.h"
 
+#include <stdexcept>
+
 using namespace TW;
 using namespace TW::Tezos;
 using namespace TW::Tezos::Proto;
@@ -35,21 +37,61 @@ Data Tezos::OperationList::forgeBranch() const {
     return forged;
 }
 
+namespace {
+
+void forgeOperation(OperationForger& forger, const Operation& operation, const PrivateKey& privateKey, Data& out) {
+    // If it's REVEAL operation, inject the public key if not specified
+    if (operation.kind() == Operation::REVEAL && operation.has_reveal_operation_data() &&
+        operation.reveal_operation_data().public_key().empty()) {
+        auto revealOperation = operation;
+        auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+        revealOperation.mutable_reveal_operation_data()->set_public_key(publicKey.bytes.data(), publicKey.bytes.size());
+        forger.forge(revealOperation, out);
+        return;
+    }
+    forger.forge(operation, out);
+}
+
+} // namespace
+
 Data Tezos::OperationList::forge(const PrivateKey& privateKey) const {
     auto forged = forgeBranch();
+    OperationForger forger;
+    for (const auto& operation : operation_list) {
+        forgeOperation(forger, operation, privateKey, forged);
+    }
+    return forged;
+}
 
-    for (auto operation : operation_list) {
-        // If it's REVEAL operation, inject the public key if not specified
-        if (operation.kind() == Operation::REVEAL && operation.has_reveal_operation_data()) {
-            auto revealOperationData = operation.mutable_reveal_operation_data();
-            if (revealOperationData->public_key().empty()) {
-                auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
-                revealOperationData->set_public_key(publicKey.bytes.data(), publicKey.bytes.size());
-            }
+std::vector<Data> Tezos::OperationList::forgeGroups(const PrivateKey& privateKey, uint64_t maxGas, size_t maxSize) const {
+    static constexpr size_t signatureSize = 64;
+    const auto forgedBranch = forgeBranch();
+    std::vector<Data> groups;
+    OperationForger forger;
+    Data current = forgedBranch;
+    uint64_t currentGas = 0;
+    for (const auto& operation : operation_list) {
+        const auto start = current.size();
+        forgeOperation(forger, operation, privateKey, current);
+        if (currentGas + operation.gas_limit() <= maxGas && current.size() + signatureSize <= maxSize) {
+            currentGas += operation.gas_limit();
+            continue;
         }
-
-        append(forged, forgeOperation(operation));
+        // does not fit, move it to a new group
+        const auto operationSize = current.size() - start;
+        if (start == forgedBranch.size() || operation.gas_limit() > maxGas ||
+            forgedBranch.size() + operationSize + signatureSize > maxSize) {
+            throw std::invalid_argument("Operation exceeds operation group limits");
+        }
+        Data next = forgedBranch;
+        next.insert(next.end(), current.begin() + start, current.end());
+        current.resize(start);
+        groups.push_back(std::move(current));
+        current = std::move(next);
+        currentGas = operation.gas_limit();
     }
-
-    return forged;
+    if (current.size() > forgedBranch.size()) {
+        groups.push_back(std::move(current));
+    }
+    return groups;
 }
@@ -12,6 +12,11 @@ namespace TW::Tezos {
 
 class OperationList {
   public:
+    /// Maximum size of a signed operation group
+    static constexpr size_t maxOperationDataLength = 32 * 1024;
+    /// Maximum total gas limit of an operation group (hard gas limit per block)
+    static constexpr uint64_t hardGasLimitPerBlock = 5200000;
+
     std::string branch;
     std::vector<Operation> operation_list;
     OperationList(const std::string& string);
@@ -19,6 +24,11 @@ class OperationList {
     /// Returns a data representation of the operations.
     Data forge(const PrivateKey& privateKey) const;
     Data forgeBranch() const;
+    /// Forges the operations into several groups, each with the branch, keeping each group within the gas limit
+    /// and its signed size within the size limit (e.g. for large payout lists).  Operations keep their order and
+    /// counters, the groups are to be injected in order.  Throws if a single operation exceeds the limits.
+    std::vector<Data> forgeGroups(const PrivateKey& privateKey, uint64_t maxGas = hardGasLimitPerBlock,
+                                  size_t maxSize = maxOperationDataLength) const;
 };
 
 } // namespace TW::Tezos
@@ -45,15 +45,25 @@ Data Signer::signOperationList(const PrivateKey& privateKey, const OperationList
     return signData(privateKey, forged);
 }
 
+std::vector<Data> Signer::signOperationGroups(const PrivateKey& privateKey, const OperationList& operationList) {
+    auto groups = operationList.forgeGroups(privateKey);
+    for (auto& group : groups) {
+        group = signData(privateKey, group);
+    }
+    return groups;
+}
+
 Data Signer::signData(const PrivateKey& privateKey, const Data& data) {
-    Data watermarkedData = Data();
+    Data watermarkedData;
+    watermarkedData.reserve(1 + data.size());
     watermarkedData.push_back(0x03);
     append(watermarkedData, data);
 
     Data hash = Hash::blake2b(watermarkedData, 32);
     Data signature = privateKey.sign(hash, TWCurve::TWCurveED25519);
 
-    Data signedData = Data();
+    Data signedData;
+    signedData.reserve(data.size() + signature.size());
     append(signedData, data);
     append(signedData, signature);
     return signedData;
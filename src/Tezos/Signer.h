@@ -25,6 +25,8 @@ class Signer {
   public:
     /// Signs the given transaction.
     Data signOperationList(const PrivateKey& privateKey, const OperationList& operationList);
+    /// Signs the given operations, split into groups within the gas and size limits; see OperationList::forgeGroups.
+    std::vector<Data> signOperationGroups(const PrivateKey& privateKey, const OperationList& operationList);
     Data signData(const PrivateKey& privateKey, const Data& data);
 };
 
@@ -6,6 +6,7 @@
 
 #include "Serialization.h"
 #include "../HexCoding.h"
+#include "../JSONWriter.h"
 #include <sstream>
 #include <vector>
 #include <algorithm>
@@ -14,7 +15,7 @@ using namespace TW;
 using namespace TW::Tron;
 using namespace std;
 
-using json = nlohmann::json;
+using Writer = JSONWriter;
 
 string typeName(const protocol::Transaction::Contract::ContractType type) {
     return protocol::Transaction::Contract::ContractType_Name(type);
@@ -26,213 +27,192 @@ string typeUrl(const protocol::Transaction::Contract::ContractType type) {
     return stringStream.str();
 }
 
-json valueJSON(const protocol::TransferContract& contract) {
-    json valueJSON;
-    valueJSON["owner_address"] = hex(contract.owner_address());
-    valueJSON["to_address"] = hex(contract.to_address());
-    valueJSON["amount"] = contract.amount();
+// Object keys are written in sorted order, see JSONWriter.
 
-    return valueJSON;
+void valueJSON(Writer& w, const protocol::TransferContract& contract) {
+    w.beginObject();
+    w.field("amount", contract.amount());
+    w.field("owner_address", hex(contract.owner_address()));
+    w.field("to_address", hex(contract.to_address()));
+    w.endObject();
 }
 
-json valueJSON(const protocol::TransferAssetContract& contract) {
-    json valueJSON;
-    valueJSON["asset_name"] = hex(contract.asset_name());
-    valueJSON["owner_address"] = hex(contract.owner_address());
-    valueJSON["to_address"] = hex(contract.to_address());
-    valueJSON["amount"] = contract.amount();
-
-    return valueJSON;
+void valueJSON(Writer& w, const protocol::TransferAssetContract& contract) {
+    w.beginObject();
+    w.field("amount", contract.amount());
+    w.field("asset_name", hex(contract.asset_name()));
+    w.field("owner_address", hex(contract.owner_address()));
+    w.field("to_address", hex(contract.to_address()));
+    w.endObject();
 }
 
-json valueJSON(const protocol::VoteAssetContract& contract) {
-    json valueJSON;
-    
-    vector<string> vote_address;
+void valueJSON(Writer& w, const protocol::VoteAssetContract& contract) {
+    w.beginObject();
+    w.field("count", contract.count());
+    w.field("owner_address", hex(contract.owner_address()));
+    w.field("support", contract.support());
+    w.key("vote_address");
+    w.beginArray();
     for (const string& addr : contract.vote_address()) {
-        vote_address.push_back(hex(addr));
+        w.value(hex(addr));
     }
-
-    valueJSON["owner_address"] = hex(contract.owner_address());
-    valueJSON["vote_address"] = vote_address;
-    valueJSON["support"] = contract.support();
-    valueJSON["count"] = contract.count();
-    
-    return valueJSON;
+    w.endArray();
+    w.endObject();
 }
 
-json voteJSON(const protocol::VoteWitnessContract::Vote& vote) {
-    json voteJSON;
-    voteJSON["vote_address"] = hex(vote.vote_address());
-    voteJSON["vote_count"] = vote.vote_count();
-
-    return voteJSON;
+void voteJSON(Writer& w, const protocol::VoteWitnessContract::Vote& vote) {
+    w.beginObject();
+    w.field("vote_address", hex(vote.vote_address()));
+    w.field("vote_count", vote.vote_count());
+    w.endObject();
 }
 
-json valueJSON(const protocol::VoteWitnessContract& contract) {
-    json valueJSON;
-
-    vector<json> votes;
+void valueJSON(Writer& w, const protocol::VoteWitnessContract& contract) {
+    w.beginObject();
+    w.field("owner_address", hex(contract.owner_address()));
+    w.field("support", contract.support());
+    w.key("votes");
+    w.beginArray();
     for (const protocol::VoteWitnessContract::Vote& vote : contract.votes()) {
-        votes.push_back(voteJSON(vote));
+        voteJSON(w, vote);
     }
-
-    valueJSON["owner_address"] = hex(contract.owner_address());
-    valueJSON["votes"] = votes;
-    valueJSON["support"] = contract.support();
-
-    return valueJSON;
+    w.endArray();
+    w.endObject();
 }
 
-json valueJSON(const protocol::FreezeBalanceContract& contract) {
-    json valueJSON;
-    valueJSON["owner_address"] = hex(contract.owner_address());
-    valueJSON["frozen_balance"] = contract.frozen_balance();
-    valueJSON["frozen_duration"] = contract.frozen_duration();
-    valueJSON["resource"] = protocol::ResourceCode_Name(contract.resource());
-    valueJSON["receiver_address"] = hex(contract.receiver_address());
-
-    return valueJSON;
+void valueJSON(Writer& w, const protocol::FreezeBalanceContract& contract) {
+    w.beginObject();
+    w.field("frozen_balance", contract.frozen_balance());
+    w.field("frozen_duration", contract.frozen_duration());
+    w.field("owner_address", hex(contract.owner_address()));
+    w.field("receiver_address", hex(contract.receiver_address()));
+    w.field("resource", protocol::ResourceCode_Name(contract.resource()));
+    w.endObject();
 }
 
-json valueJSON(const protocol::UnfreezeBalanceContract& contract) {
-    json valueJSON;
-    valueJSON["owner_address"] = hex(contract.owner_address());
-    valueJSON["resource"] = protocol::ResourceCode_Name(contract.resource());
-    valueJSON["receiver_address"] = hex(contract.receiver_address());
-
-    return valueJSON;
+void valueJSON(Writer& w, const protocol::UnfreezeBalanceContract& contract) {
+    w.beginObject();
+    w.field("owner_address", hex(contract.owner_address()));
+    w.field("receiver_address", hex(contract.receiver_address()));
+    w.field("resource", protocol::ResourceCode_Name(contract.resource()));
+    w.endObject();
 }
 
-json valueJSON(const protocol::WithdrawBalanceContract& contract) {
-    json valueJSON;
-    valueJSON["owner_address"] = hex(contract.owner_address());
-
-    return valueJSON;
+void valueJSON(Writer& w, const protocol::WithdrawBalanceContract& contract) {
+    w.beginObject();
+    w.field("owner_address", hex(contract.owner_address()));
+    w.endObject();
 }
 
-json valueJSON(const protocol::UnfreezeAssetContract& contract) {
-    json valueJSON;
-    valueJSON["owner_address"] = hex(contract.owner_address());
-
-    return valueJSON;
+void valueJSON(Writer& w, const protocol::UnfreezeAssetContract& contract) {
+    w.beginObject();
+    w.field("owner_address", hex(contract.owner_address()));
+    w.endObject();
 }
 
-json valueJSON(const protocol::TriggerSmartContract& contract) {
-    json valueJSON;
-    valueJSON["owner_address"] = hex(contract.owner_address());
-    valueJSON["contract_address"] = hex(contract.contract_address());
-    valueJSON["data"] = hex(contract.data());
-    if (contract.call_value() > 0) {
-        valueJSON["call_value"] = contract.call_value();
-    }
+void valueJSON(Writer& w, const protocol::TriggerSmartContract& contract) {
+    w.beginObject();
     if (contract.call_token_value() > 0) {
-        valueJSON["call_token_value"] = contract.call_token_value();
+        w.field("call_token_value", contract.call_token_value());
     }
+    if (contract.call_value() > 0) {
+        w.field("call_value", contract.call_value());
+    }
+    w.field("contract_address", hex(contract.contract_address()));
+    w.field("data", hex(contract.data()));
+    w.field("owner_address", hex(contract.owner_address()));
     if (contract.token_id() > 0) {
-        valueJSON["token_id"] = contract.token_id();
+        w.field("token_id", contract.token_id());
     }
+    w.endObject();
+}
 
-    return valueJSON;
+template <typename Contract>
+void unpackedValueJSON(Writer& w, const google::protobuf::Any &parameter) {
+    Contract contract;
+    parameter.UnpackTo(&contract);
+    w.key("value");
+    valueJSON(w, contract);
 }
 
-json parameterJSON(const google::protobuf::Any &parameter, const protocol::Transaction::Contract::ContractType type) {
-    json paramJSON;
-    paramJSON["type_url"] = typeUrl(type);
+void parameterJSON(Writer& w, const google::protobuf::Any &parameter, const protocol::Transaction::Contract::ContractType type) {
+    w.beginObject();
+    w.field("type_url", typeUrl(type));
 
     switch (type) {
-        case protocol::Transaction::Contract::TransferContract: {
-            protocol::TransferContract contract;
-            parameter.UnpackTo(&contract);
-            paramJSON["value"] = valueJSON(contract);
+        case protocol::Transaction::Contract::TransferContract:
+            unpackedValueJSON<protocol::TransferContract>(w, parameter);
             break;
-        }
-        case protocol::Transaction::Contract::TransferAssetContract: {
-            protocol::TransferAssetContract contract;
-            parameter.UnpackTo(&contract);
-            paramJSON["value"] = valueJSON(contract);
+        case protocol::Transaction::Contract::TransferAssetContract:
+            unpackedValueJSON<protocol::TransferAssetContract>(w, parameter);
             break;
-        }
-        case protocol::Transaction::Contract::VoteAssetContract: {
-            protocol::VoteAssetContract contract;
-            parameter.UnpackTo(&contract);
-            paramJSON["value"] = valueJSON(contract);
+        case protocol::Transaction::Contract::VoteAssetContract:
+            unpackedValueJSON<protocol::VoteAssetContract>(w, parameter);
             break;
-        }
-        case protocol::Transaction::Contract::VoteWitnessContract: {
-            protocol::VoteWitnessContract contract;
-            parameter.UnpackTo(&contract);
-            paramJSON["value"] = valueJSON(contract);
+        case protocol::Transaction::Contract::VoteWitnessContract:
+            unpackedValueJSON<protocol::VoteWitnessContract>(w, parameter);
             break;
-        }
-        case protocol::Transaction::Contract::FreezeBalanceContract: {
-            protocol::FreezeBalanceContract contract;
-            parameter.UnpackTo(&contract);
-            paramJSON["value"] = valueJSON(contract);
+        case protocol::Transaction::Contract::FreezeBalanceContract:
+            unpackedValueJSON<protocol::FreezeBalanceContract>(w, parameter);
             break;
-        }
-        case protocol::Transaction::Contract::UnfreezeBalanceContract: {
-            protocol::UnfreezeBalanceContract contract;
-            parameter.UnpackTo(&contract);
-            paramJSON["value"] = valueJSON(contract);
+        case protocol::Transaction::Contract::UnfreezeBalanceContract:
+            unpackedValueJSON<protocol::UnfreezeBalanceContract>(w, parameter);
             break;
-        }
-        case protocol::Transaction::Contract::WithdrawBalanceContract: {
-            protocol::WithdrawBalanceContract contract;
-            parameter.UnpackTo(&contract);
-            paramJSON["value"] = valueJSON(contract);
+        case protocol::Transaction::Contract::WithdrawBalanceContract:
+            unpackedValueJSON<protocol::WithdrawBalanceContract>(w, parameter);
             break;
-        }
-        case protocol::Transaction::Contract::UnfreezeAssetContract: {
-            protocol::UnfreezeAssetContract contract;
-            parameter.UnpackTo(&contract);
-            paramJSON["value"] = valueJSON(contract);
+        case protocol::Transaction::Contract::UnfreezeAssetContract:
+            unpackedValueJSON<protocol::UnfreezeAssetContract>(w, parameter);
             break;
-        }
-        case protocol::Transaction::Contract::TriggerSmartContract: {
-            protocol::TriggerSmartContract contract;
-            parameter.UnpackTo(&contract);
-            paramJSON["value"] = valueJSON(contract);
+        case protocol::Transaction::Contract::TriggerSmartContract:
+            unpackedValueJSON<protocol::TriggerSmartContract>(w, parameter);
             break;
-        }
         case protocol::Transaction::Contract::AccountCreateContract:
         default:
             break;
     }
 
-    return paramJSON;
+    w.endObject();
 }
 
-json contractJSON(const protocol::Transaction::Contract &contract) {
-    json contractJSON;
-    contractJSON["type"] = typeName(contract.type());
-    contractJSON["parameter"] = parameterJSON(contract.parameter(), contract.type());
-    return contractJSON;
+void contractJSON(Writer& w, const protocol::Transaction::Contract &contract) {
+    w.beginObject();
+    w.key("parameter");
+    parameterJSON(w, contract.parameter(), contract.type());
+    w.field("type", typeName(contract.type()));
+    w.endObject();
 }
 
-json raw_dataJSON(const protocol::Transaction::raw &raw) {
-    json raw_dataJSON;
-
-    raw_dataJSON["ref_block_bytes"] = hex(raw.ref_block_bytes());
-    raw_dataJSON["ref_block_hash"] = hex(raw.ref_block_hash());
-    if (raw.ref_block_num() > 0) {
-        raw_dataJSON["ref_block_num"] = raw.ref_block_num();
-    }
+void raw_dataJSON(Writer& w, const protocol::Transaction::raw &raw) {
+    w.beginObject();
+    w.key("contract");
+    w.beginArray();
+    contractJSON(w, raw.contract(0));
+    w.endArray();
+    w.field("expiration", raw.expiration());
     if (raw.fee_limit() > 0) {
-        raw_dataJSON["fee_limit"] = raw.fee_limit();
+        w.field("fee_limit", raw.fee_limit());
     }
-    raw_dataJSON["timestamp"] = raw.timestamp();
-    raw_dataJSON["expiration"] = raw.expiration();
-    raw_dataJSON["contract"] = json::array({ contractJSON(raw.contract(0)) });
-
-    return raw_dataJSON;
-}
-
-json TW::Tron::transactionJSON(const protocol::Transaction& transaction, const TW::Data& txID, const TW::Data& signature) {
-    json transactionJSON;
-    transactionJSON["raw_data"] = raw_dataJSON(transaction.raw_data());
-    transactionJSON["txID"] = hex(txID);
-    transactionJSON["signature"] = json::array({ hex(signature) });
-
-    return transactionJSON;
+    w.field("ref_block_bytes", hex(raw.ref_block_bytes()));
+    w.field("ref_block_hash", hex(raw.ref_block_hash()));
+    if (raw.ref_block_num() > 0) {
+        w.field("ref_block_num", raw.ref_block_num());
+    }
+    w.field("timestamp", raw.timestamp());
+    w.endObject();
+}
+
+string TW::Tron::transactionJSON(const protocol::Transaction& transaction, const TW::Data& txID, const TW::Data& signature) {
+    string buffer;
+    Writer w(buffer);
+    w.beginObject();
+    w.key("raw_data");
+    raw_dataJSON(w, transaction.raw_data());
+    w.key("signature");
+    w.beginArray();
+    w.value(hex(signature));
+    w.endArray();
+    w.field("txID", hex(txID));
+    w.endObject();
+    return buffer;
 }
@@ -8,10 +8,12 @@
 
 #include "./Protobuf/TronInternal.pb.h"
 #include "../Data.h"
-#include <nlohmann/json.hpp>
+
+#include <string>
 
 namespace TW::Tron {
 
-nlohmann::json transactionJSON(const protocol::Transaction& transaction, const TW::Data& txID, const TW::Data& signature);
+/// Transaction JSON with sorted keys, in compact form.
+std::string transactionJSON(const protocol::Transaction& transaction, const TW::Data& txID, const TW::Data& signature);
 
 }
@@ -317,7 +317,7 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
     const auto signature = key.sign(hash, TWCurveSECP256k1);
 
-    const auto json = transactionJSON(internal, hash, signature).dump();
+    const auto json = transactionJSON(internal, hash, signature);
 
     output.set_id(hash.data(), hash.size());
     output.set_signature(signature.data(), signature.size());
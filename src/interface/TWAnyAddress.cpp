@@ -25,6 +25,7 @@
 
 #include "../Coin.h"
 #include "../HexCoding.h"
+#include "../proto/Common.pb.h"
 
 using namespace TW;
 
@@ -42,6 +43,27 @@ bool TWAnyAddressIsValid(TWString* _Nonnull string, enum TWCoinType coin) {
     return TW::validateAddress(coin, address);
 }
 
+TWData* _Nonnull TWAnyAddressValidateBatch(TWData* _Nonnull input) {
+    const auto& inputData = *reinterpret_cast<const Data*>(input);
+    auto batch = Common::Proto::AddressValidationInput();
+    batch.ParseFromArray(inputData.data(), static_cast<int>(inputData.size()));
+
+    std::vector<std::pair<TWCoinType, std::string>> addresses;
+    addresses.reserve(batch.items_size());
+    for (const auto& item : batch.items()) {
+        addresses.emplace_back(static_cast<TWCoinType>(item.coin()), item.address());
+    }
+    const auto valid = TW::validateAddresses(addresses, batch.threads());
+
+    Data bitmap((valid.size() + 7) / 8, 0);
+    for (size_t i = 0; i < valid.size(); ++i) {
+        if (valid[i]) {
+            bitmap[i / 8] |= static_cast<byte>(1 << (i % 8));
+        }
+    }
+    return TWDataCreateWithBytes(bitmap.data(), bitmap.size());
+}
+
 struct TWAnyAddress* _Nullable TWAnyAddressCreateWithString(TWString* _Nonnull string,
                                                             enum TWCoinType coin) {
     const auto& address = *reinterpret_cast<const std::string*>(string);
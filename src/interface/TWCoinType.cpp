@@ -34,7 +34,7 @@ bool TWCoinTypeValidate(enum TWCoinType coin, TWString *_Nonnull address) {
 }
 
 TWString *_Nonnull TWCoinTypeDerivationPath(enum TWCoinType coin) {
-    const auto path = TW::derivationPath(coin);
+    const auto& path = TW::derivationPath(coin);
     const auto string = path.string();
     return TWStringCreateWithUTF8Bytes(string.c_str());
 }
@@ -10,6 +10,7 @@
 #include "Data.h"
 #include "Ethereum/ABI.h"
 #include "Ethereum/ContractCall.h"
+#include "Ethereum/ABI/TypedData.h"
 #include "HexCoding.h"
 #include "uint256.h"
 
@@ -61,3 +62,38 @@ TWString* _Nullable TWEthereumAbiDecodeCall(TWData* _Nonnull callData, TWString*
         return nullptr;
     }
 }
+
+TWData* _Nonnull TWEthereumAbiEncodeTyped(TWString* _Nonnull messageJson) {
+    const auto& jsonString = *reinterpret_cast<const std::string*>(messageJson);
+    try {
+        const auto hash = TypedData::hashMessage(nlohmann::json::parse(jsonString));
+        return TWDataCreateWithBytes(hash.data(), hash.size());
+    } catch (...) {
+        return TWDataCreateWithSize(0);
+    }
+}
+
+TWData* _Nonnull TWEthereumAbiEncodeTypedMany(TWString* _Nonnull schemaJson, TWString* _Nonnull messagesJson) {
+    const auto& schemaString = *reinterpret_cast<const std::string*>(schemaJson);
+    const auto& messagesString = *reinterpret_cast<const std::string*>(messagesJson);
+    try {
+        const auto schema = nlohmann::json::parse(schemaString);
+        const auto messages = nlohmann::json::parse(messagesString);
+        if (!schema.is_object() || !schema.contains("types") || !schema.contains("domain") ||
+            !schema.contains("primaryType") || !messages.is_array()) {
+            return TWDataCreateWithSize(0);
+        }
+        const TypedData typedData(schema["types"], schema["primaryType"].get<std::string>());
+        const auto domainSeparator = typedData.domainSeparator(schema["domain"]);
+        const auto hashes = typedData.signingHashes(domainSeparator, messages.get<std::vector<nlohmann::json>>());
+
+        Data result;
+        result.reserve(hashes.size() * domainSeparator.size());
+        for (const auto& hash : hashes) {
+            result.insert(result.end(), hash.begin(), hash.end());
+        }
+        return TWDataCreateWithData(&result);
+    } catch (...) {
+        return TWDataCreateWithSize(0);
+    }
+}
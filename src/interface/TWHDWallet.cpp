@@ -9,6 +9,7 @@
 #include "../Coin.h"
 #include "../HDWallet.h"
 #include "../Mnemonic.h"
+#include "../proto/Common.pb.h"
 
 using namespace TW;
 
@@ -46,20 +47,40 @@ struct TWPrivateKey *_Nonnull TWHDWalletGetMasterKey(struct TWHDWallet *_Nonnull
 }
 
 struct TWPrivateKey *_Nonnull TWHDWalletGetKeyForCoin(struct TWHDWallet *wallet, TWCoinType coin) {
-    auto derivationPath = TW::derivationPath(coin);
+    const auto& derivationPath = TW::derivationPath(coin);
     return new TWPrivateKey{ wallet->impl.getKey(coin, derivationPath) };
 }
 
 TWString *_Nonnull TWHDWalletGetAddressForCoin(struct TWHDWallet *wallet, TWCoinType coin) {
-    auto derivationPath = TW::derivationPath(coin);
+    const auto& derivationPath = TW::derivationPath(coin);
     PrivateKey privateKey = wallet->impl.getKey(coin, derivationPath);
     std::string address = deriveAddress(coin, privateKey);
     return TWStringCreateWithUTF8Bytes(address.c_str());
 }
 
+TWData *_Nonnull TWHDWalletGetAddressesForCoins(struct TWHDWallet *_Nonnull wallet, TWData *_Nonnull input) {
+    const auto& inputData = *reinterpret_cast<const Data*>(input);
+    auto request = Common::Proto::AddressDerivationInput();
+    request.ParseFromArray(inputData.data(), static_cast<int>(inputData.size()));
+
+    std::vector<TWCoinType> coins;
+    coins.reserve(request.coins_size());
+    for (const auto coin : request.coins()) {
+        coins.push_back(static_cast<TWCoinType>(coin));
+    }
+    const auto addresses = wallet->impl.deriveAddresses(coins, request.threads());
+
+    auto output = Common::Proto::AddressDerivationOutput();
+    for (const auto& address : addresses) {
+        output.add_addresses(address);
+    }
+    const auto serialized = output.SerializeAsString();
+    return TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size());
+}
+
 struct TWPrivateKey *_Nonnull TWHDWalletGetKey(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin, TWString *_Nonnull derivationPath) {
     auto& s = *reinterpret_cast<const std::string*>(derivationPath);
-    const auto path = DerivationPath(s);
+    const auto path = cachedDerivationPath(s);
     return new TWPrivateKey{ wallet->impl.getKey(coin, path) };
 }
 
@@ -77,7 +98,7 @@ TWString *_Nonnull TWHDWalletGetExtendedPublicKey(struct TWHDWallet *wallet, TWP
 }
 
 TWPublicKey *TWHDWalletGetPublicKeyFromExtended(TWString *_Nonnull extended, enum TWCoinType coin, TWString *_Nonnull derivationPath) {
-    const auto derivationPathObject = DerivationPath(*reinterpret_cast<const std::string*>(derivationPath));
+    const auto derivationPathObject = cachedDerivationPath(*reinterpret_cast<const std::string*>(derivationPath));
     auto publicKey = HDWallet::getPublicKeyFromExtended(*reinterpret_cast<const std::string*>(extended), coin, derivationPathObject);
     if (!publicKey) {
         return nullptr;
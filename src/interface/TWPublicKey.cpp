@@ -8,6 +8,7 @@
 
 #include "../HexCoding.h"
 #include "../PublicKey.h"
+#include "../proto/Common.pb.h"
 
 #include <TrezorCrypto/ecdsa.h>
 #include <TrezorCrypto/secp256k1.h>
@@ -77,3 +78,24 @@ struct TWPublicKey *_Nullable TWPublicKeyRecover(TWData *_Nonnull signature, TWD
         return nullptr;
     }
 }
+
+TWData *_Nonnull TWPublicKeyRecoverAddresses(TWData *_Nonnull input) {
+    const auto& inputData = *reinterpret_cast<const TW::Data*>(input);
+    auto request = TW::Common::Proto::RecoveryInput();
+    request.ParseFromArray(inputData.data(), static_cast<int>(inputData.size()));
+
+    std::vector<std::pair<TW::Data, TW::Data>> items;
+    items.reserve(request.items_size());
+    for (const auto& item : request.items()) {
+        items.emplace_back(TW::Data(item.signature().begin(), item.signature().end()),
+                           TW::Data(item.digest().begin(), item.digest().end()));
+    }
+    const auto addresses = PublicKey::recoverAddresses(items, request.threads());
+
+    auto output = TW::Common::Proto::RecoveryOutput();
+    for (const auto& address : addresses) {
+        output.add_addresses(address.data(), address.size());
+    }
+    const auto serialized = output.SerializeAsString();
+    return TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size());
+}
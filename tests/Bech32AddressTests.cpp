@@ -172,3 +172,19 @@ TEST(Bech32Address, Prefixes) {
     const auto address3 = Bech32Address("hrpthree", HASHER_SHA2_RIPEMD, publicKey);
     ASSERT_EQ("hrpthree186zwn9h0z9fyvwfqs4jl92cw3kexusm4wuqkvd", address3.string());
 }
+
+TEST(Bech32Address, IsValidBatch) {
+    const std::vector<std::string> addrs = {
+        "cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02",
+        "cosmos1xsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02",
+        "COSMOS1HSK6JRYYQJFHP5DHC55TC9JTCKYGX0EPH6DD02",
+        "bnb1grpf0955h0ykzq3ar5nmum7y6gdfl6lxfn46h2",
+        "",
+    };
+    const auto valid = Bech32Address::isValidBatch(addrs, "cosmos");
+    ASSERT_EQ(addrs.size(), valid.size());
+    for (size_t i = 0; i < addrs.size(); ++i) {
+        EXPECT_EQ(Bech32Address::isValid(addrs[i], "cosmos"), valid[i]) << addrs[i];
+    }
+    EXPECT_EQ(std::vector<bool>({true, false, true, false, false}), valid);
+}
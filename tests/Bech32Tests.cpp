@@ -0,0 +1,91 @@
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bech32.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+using namespace TW;
+
+TEST(Bech32, DecodeValidBip173) {
+    for (const auto& str : {"A12UEL5L", "a12uel5l", "abcdef1qpzry9x8gf2tvdw0s3jn54khce6mua7lmqqqxw",
+                            "split1checkupstagehandshakeupstreamerranterredcaperred2y9e3w"}) {
+        Bech32::View view;
+        ASSERT_TRUE(Bech32::decode(str, strlen(str), view)) << str;
+        EXPECT_EQ(Bech32::ChecksumVariant::Bech32, view.variant);
+        EXPECT_FALSE(Bech32::decode(str).first.empty());
+    }
+}
+
+TEST(Bech32, DecodeValidBip350) {
+    for (const auto& str : {"A1LQFN3A", "a1lqfn3a", "abcdef1l7aum6echk45nj3s0wdvt2fg8x9yrzpqzd3ryx",
+                            "split1checkupstagehandshakeupstreamerranterredcaperredlc445v"}) {
+        Bech32::View view;
+        ASSERT_TRUE(Bech32::decode(str, strlen(str), view)) << str;
+        EXPECT_EQ(Bech32::ChecksumVariant::Bech32M, view.variant);
+        // the string API only accepts Bech32
+        EXPECT_TRUE(Bech32::decode(str).first.empty());
+    }
+}
+
+TEST(Bech32, DecodeInvalid) {
+    for (const auto& str : {"", "1nwldj5", "pzry9x0s0muk", "1pzry9x0s0muk", "x1b4n0q5v", "li1dgmt3",
+                            "A1G7SGD8", "10a06t8", "1qzzfhee", "a12UEL5L"}) {
+        Bech32::View view;
+        EXPECT_FALSE(Bech32::decode(str, strlen(str), view)) << str;
+    }
+}
+
+TEST(Bech32, View) {
+    const std::string str = "SPLIT1CHECKUPSTAGEHANDSHAKEUPSTREAMERRANTERREDCAPERRED2Y9E3W";
+    Bech32::View view;
+    ASSERT_TRUE(Bech32::decode(str.data(), str.size(), view));
+    EXPECT_EQ("split", view.hrpString());
+    EXPECT_TRUE(view.hrpHasPrefix("spl"));
+    EXPECT_FALSE(view.hrpHasPrefix("splits"));
+
+    std::array<uint8_t, Bech32::maxLength> values;
+    view.copyValues(values.data());
+    const auto dec = Bech32::decode(str);
+    ASSERT_EQ(dec.second.size(), view.valuesLength);
+    EXPECT_TRUE(std::equal(dec.second.begin(), dec.second.end(), values.begin()));
+}
+
+TEST(Bech32, EncodeFixedBuffer) {
+    const auto values = Data{0, 14, 20, 15, 7, 13, 26, 0, 25, 18, 6, 11, 13, 8, 21, 4, 20, 3, 17, 2, 29, 3, 12, 29, 3, 4, 15, 24, 20, 6, 14, 30, 22};
+    const std::string hrp = "bc";
+
+    std::array<char, Bech32::encodedLength(2, 33)> out;
+    const auto written = Bech32::encode(out.data(), hrp.data(), hrp.size(), values.data(), values.size());
+    ASSERT_EQ(out.size(), written);
+    EXPECT_EQ("bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4", std::string(out.begin(), out.end()));
+    EXPECT_EQ(Bech32::encode(hrp, values), std::string(out.begin(), out.end()));
+
+    Bech32::View view;
+    Bech32::encode(out.data(), hrp.data(), hrp.size(), values.data(), values.size(), Bech32::ChecksumVariant::Bech32M);
+    ASSERT_TRUE(Bech32::decode(out.data(), out.size(), view));
+    EXPECT_EQ(Bech32::ChecksumVariant::Bech32M, view.variant);
+}
+
+TEST(Bech32, ConvertBitsIterators) {
+    const auto bytes = parse_hex("751e76e8199196d454941c45d1b3a323f1433bd6");
+    std::array<uint8_t, Bech32::convertedLength<8, 5, true>(20)> values;
+    auto out = values.begin();
+    ASSERT_TRUE((Bech32::convertBits<8, 5, true>(out, bytes.begin(), bytes.end())));
+    EXPECT_EQ(values.end(), out);
+
+    Data expected;
+    ASSERT_TRUE((Bech32::convertBits<8, 5, true>(expected, bytes)));
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), values.begin(), values.end()));
+
+    std::array<uint8_t, Bech32::convertedLength<5, 8, false>(32)> back;
+    auto backOut = back.begin();
+    ASSERT_TRUE((Bech32::convertBits<5, 8, false>(backOut, values.begin(), values.end())));
+    EXPECT_EQ(hex(bytes), hex(Data(back.begin(), backOut)));
+}
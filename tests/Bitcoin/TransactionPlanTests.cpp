@@ -11,6 +11,9 @@
 #include "Bitcoin/TransactionBuilder.h"
 #include "Bitcoin/FeeCalculator.h"
 #include "proto/Bitcoin.pb.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
 #include <TrustWalletCore/TWCoinType.h>
 
 #include <gtest/gtest.h>
@@ -569,3 +572,83 @@ TEST(TransactionPlan, LotsofUtxosMax) {
     EXPECT_EQ(filteredValueSum, 50'039'500);
     EXPECT_TRUE(verifyPlan(txPlan, filteredValues, 48'579'780, 1'459'720));
 }
+
+namespace {
+
+Proto::UnspentTransaction buildUTXO(int64_t amount, const Script& script, uint32_t index) {
+    auto utxo = buildTestUTXO(amount);
+    utxo.mutable_out_point()->set_index(index);
+    utxo.set_script(script.bytes.data(), script.bytes.size());
+    return utxo;
+}
+
+void addScript(Proto::SigningInput& input, const Script& script) {
+    const auto hash = Hash::ripemd(Hash::sha256(script.bytes));
+    (*input.mutable_scripts())[hex(hash)] = std::string(script.bytes.begin(), script.bytes.end());
+}
+
+} // namespace
+
+TEST(TransactionPlan, VirtualSizeEstimateMatchesSigning) {
+    const auto publicKey = PrivateKey(parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9")).getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto otherKey = PrivateKey(parse_hex("ed00a0841cd53aedf89b0c616742d1d2a930f8ae2b0fb514765a17bb62c7521a")).getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto keyHash = Hash::ripemd(Hash::sha256(publicKey.bytes));
+
+    // 2-of-3 multisig, 1-of-1 P2PK and P2PKH witness scripts
+    Data multisig = {OP_2};
+    for (const auto& key : {publicKey, otherKey, publicKey}) {
+        multisig.push_back(static_cast<TW::byte>(key.bytes.size()));
+        append(multisig, key.bytes);
+    }
+    append(multisig, Data{OP_3, OP_CHECKMULTISIG});
+    Data payToPublicKey = {static_cast<TW::byte>(publicKey.bytes.size())};
+    append(payToPublicKey, publicKey.bytes);
+    payToPublicKey.push_back(OP_CHECKSIG);
+    const std::vector<Script> witnessScripts = {Script(multisig), Script(payToPublicKey), Script::buildPayToPublicKeyHash(keyHash)};
+
+    std::vector<Script> scripts = {
+        Script::buildPayToPublicKeyHash(keyHash),
+        Script::buildPayToWitnessPublicKeyHash(keyHash),
+    };
+    const auto nestedWitnessKeyHash = Script::buildPayToWitnessPublicKeyHash(keyHash);
+    scripts.push_back(Script::buildPayToScriptHash(Hash::ripemd(Hash::sha256(nestedWitnessKeyHash.bytes))));
+    std::vector<Script> redeemScripts = {nestedWitnessKeyHash};
+    for (const auto& witnessScript : witnessScripts) {
+        const auto witnessScriptHash = Script::buildPayToWitnessScriptHash(Hash::sha256(witnessScript.bytes));
+        scripts.push_back(witnessScriptHash);
+        scripts.push_back(Script::buildPayToScriptHash(Hash::ripemd(Hash::sha256(witnessScriptHash.bytes))));
+        redeemScripts.push_back(witnessScript);
+        redeemScripts.push_back(witnessScriptHash);
+    }
+
+    for (const auto& hashType : {TWBitcoinSigHashTypeAll, TWBitcoinSigHashTypeSingle}) {
+        for (size_t first = 0; first < scripts.size(); ++first) {
+            for (const size_t count : {1, 3}) {
+                std::vector<Proto::UnspentTransaction> utxos;
+                for (size_t i = 0; i < count; ++i) {
+                    utxos.push_back(buildUTXO(100'000 + 1'000 * i, scripts[(first + i) % scripts.size()], i));
+                }
+                for (const auto maxAmount : {false, true}) {
+                    auto input = buildSigningInput(150'000, 10, utxos, maxAmount, TWCoinTypeBitcoin);
+                    input.set_hash_type(hashType);
+                    for (const auto& script : redeemScripts) {
+                        addScript(input, script);
+                    }
+                    TransactionPlan plan;
+                    ASSERT_NO_THROW(plan = TransactionBuilder::plan(input, true)) << first << " " << count;
+                    ASSERT_FALSE(plan.utxos.empty());
+                    const auto estimate = TransactionBuilder::estimateVirtualSize(plan, input);
+                    ASSERT_TRUE(estimate.has_value());
+                    EXPECT_EQ(estimate, TransactionBuilder::signedVirtualSize(plan, input));
+                    EXPECT_EQ(plan.fee, 10 * static_cast<int64_t>(*estimate));
+                }
+            }
+        }
+    }
+
+    // other script types are left to trial signing
+    auto input = buildSigningInput(50'000, 1, {buildUTXO(100'000, Script(payToPublicKey), 0)}, false, TWCoinTypeBitcoin);
+    const auto plan = TransactionBuilder::plan(input);
+    EXPECT_FALSE(TransactionBuilder::estimateVirtualSize(plan, input).has_value());
+    EXPECT_EQ(plan.fee, static_cast<int64_t>(*TransactionBuilder::signedVirtualSize(plan, input)));
+}
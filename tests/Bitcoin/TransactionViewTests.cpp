@@ -0,0 +1,174 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bitcoin/TransactionView.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+std::string displayHash(Data hash) {
+    std::reverse(hash.begin(), hash.end());
+    return hex(hash);
+}
+
+// https://blockchair.com/litecoin/transaction/a85fd6a9a7f2f54cacb57e83dfd408e51c0a5fc82885e3fa06be8692962bc407
+const auto litecoinSegwit = parse_hex("01000000000101b5fd8e818ad98a3f4570383954c1c41513797ec6f9f0ab44a801941818cd51700900000000feffffff017e813b00000000001600147b59c096c20fd9a273e240846b23276c69d358150247"
+    "3044022029153096af176f9cca0ba9b827e947689a8bb8d11dda570c880f9108bc590b3002202410c78b666722ade1ef4547ad85a128ddcbd4695c40f942457bea3d043b9bb30121036739829f2cfec79cfe6aaf1c22ecb7d4867dfd8ab4deb7121b36a00ab646caed00000000");
+
+// https://blockbook.groestlcoin.org/tx/74a0dd12bc178cfcc1e0982a2a5b2c01a50e41abbb63beb031bcd21b3e28eac0
+const auto groestlcoinLegacy = parse_hex("01000000019568b09e6c6d940302ec555a877c9e5f799de8ee473e18d3a19ae14478cc4e8f000000006a47304402202163ab98b028aa13563f0de00b785d6df81df5eac0b7c91d23f5be7ea674aa3702202bf6cd7055c6f8f697ce045b1a4f9b997cf6e5761a661d27696ac34064479d19012103b85cc59b67c35851eb5060cfc3a759a482254553c5857075c9e247d74d412c91ffffffff02c4090000000000001600147557920fbc32a1ef4ef26bae5e8ce3f95abf09cee20800000000000017a9140055b0c94df477ee6b9f75185dfc9aa8ce2e52e48700000000");
+
+// https://blockbook.groestlcoin.org/tx/40b539c578934c9863a93c966e278fbeb3e67b0da4eb9e3030092c1b717e7a64
+const auto groestlcoinSegwit = parse_hex("010000000001019568b09e6c6d940302ec555a877c9e5f799de8ee473e18d3a19ae14478cc4e8f0100000000ffffffff02c40900000000000017a9140055b0c94df477ee6b9f75185dfc9aa8ce2e52e48700080000000000001976a91498af0aaca388a7e1024f505c033626d908e3b54a88ac024830450221009bbd0228dcb7343828633ded99d216555d587b74db40c4a46f560187eca222dd022032364cf6dbf9c0213076beb6b4a20935d4e9c827a551c3f6f8cbb22d8b464467012102e9c9b9b76e982ad8fa9a7f48470eafbeeba9bf6d287579318c517db5157d936e00000000");
+
+// https://explorer.zcha.in/transactions/ec9033381c1cc53ada837ef9981c03ead1c7c41700ff3a954389cfaddc949256
+const auto zcashSapling = parse_hex("0400008085202f890153685b8809efc50dd7d5cb0906b307a1b8aa5157baa5fc1bd6fe2d0344dd193a000000006b483045022100ca0be9f37a4975432a52bb65b25e483f6f93d577955290bb7fb0060a93bfc92002203e0627dff004d3c72a957dc9f8e4e0e696e69d125e4d8e275d119001924d3b48012103b243171fae5516d1dc15f9178cfcc5fdc67b0a883055c117b01ba8af29b953f6ffffffff0140720700000000001976a91449964a736f3713d64283fd0018626ba50091c7e988ac00000000000000000000000000000000000000");
+
+const auto decredFull = parse_hex("0100000001fdbfe9dd703f306794a467f175be5bd9748a7925033ea1cf9889d7cf4dd1155000000000000000000002809698000000000000001976a914989b1aecabf1c24e213cc0f2d8a22ffee25dd4e188ac40b6c6010000000000001976a9142a194fc92e27fef9cc2b057bc9060c580cbb484888ac000000000000000001000000000000000000000000ffffffff6a47304402206ee887c9239e5fff0048674bdfff2a8cfbeec6cd4a3ccebcc12fac44b24cc5ac0220718f7c760818fde18bc5ba8457d43d5a145cc4cf13d2a5557cba9107e9f4558d0121026cc34b92cefb3a4537b3edb0b6044c04af27c01583c577823ecc69a9a21119b6");
+
+} // namespace
+
+TEST(BitcoinTransactionView, Segwit) {
+    TransactionView view;
+    ASSERT_EQ(view.parse(litecoinSegwit.data(), litecoinSegwit.size(), TransactionFormat::Bitcoin), litecoinSegwit.size());
+    EXPECT_EQ(view.version, 1);
+    EXPECT_TRUE(view.hasWitness());
+    ASSERT_EQ(view.inputs.size(), 1);
+    EXPECT_EQ(displayHash(view.inputs[0].previousHash.toData()), "7051cd18189401a844abf0f9c67e791315c4c154393870453f8ad98a818efdb5");
+    EXPECT_EQ(view.inputs[0].previousIndex, 9);
+    EXPECT_EQ(view.inputs[0].sequence, UINT32_MAX - 1);
+    EXPECT_EQ(view.inputs[0].script.size, 0);
+    const auto stack = view.inputs[0].witnessStack();
+    ASSERT_EQ(stack.size(), 2);
+    EXPECT_EQ(stack[0].size, 71);
+    EXPECT_EQ(hex(stack[1].toData()), "036739829f2cfec79cfe6aaf1c22ecb7d4867dfd8ab4deb7121b36a00ab646caed");
+    ASSERT_EQ(view.outputs.size(), 1);
+    EXPECT_EQ(view.outputs[0].value, 3'899'774);
+    EXPECT_EQ(hex(view.outputs[0].script.toData()), "00147b59c096c20fd9a273e240846b23276c69d35815");
+    EXPECT_EQ(view.lockTime, 0);
+
+    EXPECT_EQ(displayHash(view.txid()), "a85fd6a9a7f2f54cacb57e83dfd408e51c0a5fc82885e3fa06be8692962bc407");
+    EXPECT_EQ(view.wtxid(), Hash::sha256d(litecoinSegwit.data(), litecoinSegwit.size()));
+}
+
+TEST(BitcoinTransactionView, Groestlcoin) {
+    TransactionView view;
+    view.parse(groestlcoinLegacy.data(), groestlcoinLegacy.size(), TransactionFormat::Groestlcoin);
+    EXPECT_FALSE(view.hasWitness());
+    EXPECT_EQ(view.inputs[0].script.size, 0x6a);
+    EXPECT_TRUE(view.inputs[0].witnessStack().empty());
+    EXPECT_EQ(view.outputs.size(), 2);
+    EXPECT_EQ(displayHash(view.txid()), "74a0dd12bc178cfcc1e0982a2a5b2c01a50e41abbb63beb031bcd21b3e28eac0");
+    EXPECT_EQ(view.wtxid(), view.txid());
+
+    view.parse(groestlcoinSegwit.data(), groestlcoinSegwit.size(), TransactionFormat::Groestlcoin);
+    EXPECT_TRUE(view.hasWitness());
+    EXPECT_EQ(view.outputs[1].value, 0x800);
+    EXPECT_EQ(displayHash(view.txid()), "40b539c578934c9863a93c966e278fbeb3e67b0da4eb9e3030092c1b717e7a64");
+}
+
+TEST(BitcoinTransactionView, Zcash) {
+    TransactionView view;
+    ASSERT_EQ(view.parse(zcashSapling.data(), zcashSapling.size(), TransactionFormat::Zcash), zcashSapling.size());
+    EXPECT_TRUE(view.overwintered);
+    EXPECT_EQ(view.version, 4);
+    EXPECT_EQ(view.versionGroupId, 0x892F2085);
+    EXPECT_EQ(view.inputs.size(), 1);
+    EXPECT_EQ(view.outputs[0].value, 488'000);
+    EXPECT_EQ(view.expiry, 0);
+    EXPECT_EQ(displayHash(view.txid()), "ec9033381c1cc53ada837ef9981c03ead1c7c41700ff3a954389cfaddc949256");
+
+    // not overwintered, shielded spends
+    auto legacy = zcashSapling;
+    legacy[3] = 0;
+    EXPECT_THROW(view.parse(legacy.data(), legacy.size(), TransactionFormat::Zcash), std::invalid_argument);
+    auto shielded = zcashSapling;
+    shielded[shielded.size() - 3] = 1;
+    EXPECT_THROW(view.parse(shielded.data(), shielded.size(), TransactionFormat::Zcash), std::invalid_argument);
+}
+
+TEST(BitcoinTransactionView, Decred) {
+    TransactionView view;
+    ASSERT_EQ(view.parse(decredFull.data(), decredFull.size(), TransactionFormat::Decred), decredFull.size());
+    EXPECT_EQ(view.version, 1);
+    EXPECT_EQ(view.serializeType, 0);
+    EXPECT_TRUE(view.hasWitness());
+    ASSERT_EQ(view.inputs.size(), 1);
+    EXPECT_EQ(view.inputs[0].tree, 0);
+    EXPECT_EQ(view.inputs[0].sequence, 0);
+    EXPECT_EQ(view.inputs[0].valueIn, 0);
+    EXPECT_EQ(view.inputs[0].blockIndex, UINT32_MAX);
+    EXPECT_EQ(view.inputs[0].script.size, 0x6a);
+    ASSERT_EQ(view.outputs.size(), 2);
+    EXPECT_EQ(view.outputs[0].value, 10'000'000);
+    EXPECT_EQ(view.outputs[0].scriptVersion, 0);
+
+    // prefix: 4-byte version word, inputs, outputs, lock time and expiry
+    const size_t prefixEnd = 4 + 1 + 41 + 1 + 2 * 36 + 8;
+    auto prefix = Data(decredFull.begin(), decredFull.begin() + prefixEnd);
+    prefix[2] = 1; // no witness
+    EXPECT_EQ(view.txid(), Hash::blake256(prefix));
+    auto witness = Data(decredFull.begin() + prefixEnd, decredFull.end());
+    witness.insert(witness.begin(), {1, 0, 2, 0}); // witness only
+    auto hashes = Hash::blake256(prefix);
+    append(hashes, Hash::blake256(witness));
+    EXPECT_EQ(view.wtxid(), Hash::blake256(hashes));
+
+    // same prefix, serialized alone
+    TransactionView prefixView;
+    ASSERT_EQ(prefixView.parse(prefix.data(), prefix.size(), TransactionFormat::Decred), prefix.size());
+    EXPECT_FALSE(prefixView.hasWitness());
+    EXPECT_EQ(prefixView.txid(), view.txid());
+    EXPECT_THROW(prefixView.wtxid(), std::logic_error);
+
+    TransactionView witnessView;
+    ASSERT_EQ(witnessView.parse(witness.data(), witness.size(), TransactionFormat::Decred), witness.size());
+    EXPECT_EQ(witnessView.inputs.size(), 1);
+    EXPECT_EQ(witnessView.inputs[0].script.size, 0x6a);
+    EXPECT_THROW(witnessView.txid(), std::logic_error);
+}
+
+TEST(BitcoinTransactionView, Invalid) {
+    TransactionView view;
+    for (size_t size = 0; size < litecoinSegwit.size(); ++size) {
+        EXPECT_THROW(view.parse(litecoinSegwit.data(), size, TransactionFormat::Bitcoin), std::invalid_argument) << size;
+    }
+    // unknown segwit flag
+    auto flag = litecoinSegwit;
+    flag[5] = 2;
+    EXPECT_THROW(view.parse(flag.data(), flag.size(), TransactionFormat::Bitcoin), std::invalid_argument);
+    // huge input count
+    auto count = parse_hex("01000000ffffffffffffffffff");
+    EXPECT_THROW(view.parse(count.data(), count.size(), TransactionFormat::Bitcoin), std::invalid_argument);
+}
+
+TEST(BitcoinTransactionView, Scan) {
+    Data stream;
+    for (int i = 0; i < 100; ++i) {
+        append(stream, i % 2 == 0 ? groestlcoinLegacy : groestlcoinSegwit);
+    }
+    size_t witnesses = 0;
+    const auto count = scanTransactions(stream.data(), stream.size(), TransactionFormat::Groestlcoin,
+                                        [&witnesses](const TransactionView& view) { witnesses += view.hasWitness(); });
+    EXPECT_EQ(count, 100);
+    EXPECT_EQ(witnesses, 50);
+
+    const auto ids = transactionIds(stream.data(), stream.size(), TransactionFormat::Groestlcoin);
+    ASSERT_EQ(ids.size(), 100);
+    EXPECT_EQ(displayHash(ids[98]), "74a0dd12bc178cfcc1e0982a2a5b2c01a50e41abbb63beb031bcd21b3e28eac0");
+    EXPECT_EQ(displayHash(ids[99]), "40b539c578934c9863a93c966e278fbeb3e67b0da4eb9e3030092c1b717e7a64");
+
+    stream.pop_back();
+    EXPECT_THROW(transactionIds(stream.data(), stream.size(), TransactionFormat::Groestlcoin), std::invalid_argument);
+}
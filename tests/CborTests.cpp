@@ -511,3 +511,90 @@ TEST(Cbor, GetTagElementNotTag) {
     }
     FAIL() << "Expected exception";
 }
+
+TEST(Cbor, WriterMatchesEncode) {
+    const auto expected = Encode::array({
+        Encode::uint(5),
+        Encode::map({
+            make_pair(Encode::string("x"), Encode::uint(100)),
+            make_pair(Encode::string("y"), Encode::negInt(50)),
+        }),
+        Encode::tag(24, Encode::bytes(parse_hex("0102"))),
+        Encode::negInt(0),
+        Encode::uint(0xffffffffffffffff),
+        Encode::indefArray().addIndefArrayElem(Encode::uint(1)).closeIndefArray(),
+        Encode::fromRaw(parse_hex("a0")),
+    }).encoded();
+
+    Data buffer;
+    Writer(buffer)
+        .array(7)
+        .uint(5)
+        .map(2).string("x").uint(100).string("y").negInt(50)
+        .tag(24).bytes(parse_hex("0102"))
+        .negInt(0)
+        .uint(0xffffffffffffffff)
+        .indefArray().uint(1).closeIndef()
+        .raw(parse_hex("a0"));
+    EXPECT_EQ(hex(expected), hex(buffer));
+}
+
+TEST(Cbor, ReaderWalk) {
+    const auto data = parse_hex("8205a26178186461793831");
+    Reader reader(data);
+    EXPECT_EQ(Decode::MT_array, reader.peekType());
+    ASSERT_EQ(2, reader.readArray());
+    EXPECT_EQ(5, reader.readUint());
+    ASSERT_EQ(2, reader.readMap());
+    EXPECT_EQ("x", reader.readString());
+    EXPECT_EQ(100, reader.readUint());
+    EXPECT_EQ("y", reader.readString());
+    EXPECT_EQ(Decode::MT_negint, reader.peekType());
+    EXPECT_EQ(49, reader.readValue());
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_THROW(reader.readUint(), invalid_argument);
+}
+
+TEST(Cbor, ReaderBytesNoCopy) {
+    const auto data = parse_hex("d818430102036161");
+    Reader reader(data);
+    EXPECT_EQ(24, reader.readTag());
+    const auto bytes = reader.readBytes();
+    EXPECT_EQ(data.data() + 3, bytes.data);
+    EXPECT_EQ("010203", hex(bytes.toData()));
+    EXPECT_THROW(reader.readBytes(), invalid_argument); // string, not bytes
+    EXPECT_EQ(7, reader.position());
+}
+
+TEST(Cbor, ReaderSkip) {
+    // nested definite and indefinite arrays, maps, tags
+    const auto data = parse_hex("839f018202039f04ffff" "bf6161d8180561629f06ffff" "5f4101ff" "07");
+    Reader reader(data);
+    ASSERT_EQ(3, reader.readArray());
+    EXPECT_EQ("9f018202039f04ffff", hex(reader.readEncoded().toData()));
+    EXPECT_EQ("bf6161d8180561629f06ffff", hex(reader.readEncoded().toData()));
+    reader.skip(); // indefinite-length bytes
+    EXPECT_EQ(7, reader.readUint());
+    EXPECT_TRUE(reader.atEnd());
+
+    const auto indefData = parse_hex("9f0102ff");
+    Reader indef(indefData);
+    EXPECT_EQ(Reader::indefinite, indef.readArray());
+    EXPECT_EQ(1, indef.readUint());
+    EXPECT_FALSE(indef.isBreak());
+    EXPECT_EQ(2, indef.readUint());
+    EXPECT_TRUE(indef.isBreak());
+    indef.readBreak();
+    EXPECT_TRUE(indef.atEnd());
+}
+
+TEST(Cbor, ReaderSkipInvalid) {
+    for (const auto& invalid: {"9f0102", "83010203ff" "ff", "830102", "1c", "5a00000010", "9bffffffffffffffff00", "ff", "1f"}) {
+        const auto data = parse_hex(invalid);
+        Reader reader(data);
+        EXPECT_THROW({
+            reader.skip();
+            reader.skip();
+        }, invalid_argument) << invalid;
+    }
+}
@@ -392,5 +392,47 @@ TEST(Coin, ValidateAddressOasis) {
     EXPECT_FALSE(validateAddress(TWCoinTypeOasis, "oasi1qp0cnmkjl22gky6p6qeghjytt4v7dkxsrsmueweh"));
 }
 
+TEST(Coin, ValidateAddresses) {
+    const std::vector<std::pair<TWCoinType, std::string>> addresses = {
+        {TWCoinTypeEthereum, "0xeDe8F58dADa22c3A49dB60D4f82BAD428ab65F89"},
+        {TWCoinTypeBitcoin, "bc1q2ddhp55sq2l4xnqhpdv0xazg02v9dr7uu8c2p2"},
+        {TWCoinTypeEthereum, "ede8f58dada22a49db60d4f82bad428ab65f89"},
+        {TWCoinTypeOasis, "oasis1qp0cnmkjl22gky6p6qeghjytt4v7dkxsrsmueweh"},
+        {TWCoinTypeBitcoin, "MPmoY6RX3Y3HFjGEnFxyuLPCQdjvHwMEny"},
+        {TWCoinTypeZilliqa, ""},
+    };
+    const auto expected = std::vector<bool>({true, true, false, true, false, false});
+    EXPECT_EQ(expected, validateAddresses(addresses));
+
+    // enough items to be split across threads
+    std::vector<std::pair<TWCoinType, std::string>> many;
+    std::vector<bool> manyExpected;
+    for (auto i = 0; i < 200; ++i) {
+        many.insert(many.end(), addresses.begin(), addresses.end());
+        manyExpected.insert(manyExpected.end(), expected.begin(), expected.end());
+    }
+    EXPECT_EQ(manyExpected, validateAddresses(many, 4));
+    // clamped to the hardware thread count
+    EXPECT_EQ(manyExpected, validateAddresses(many, 1'000'000));
+}
+
+TEST(Coin, ValidateAddressesUnknownCoin) {
+    const auto unknown = static_cast<TWCoinType>(123456789);
+    const std::vector<std::pair<TWCoinType, std::string>> addresses = {
+        {unknown, "0xeDe8F58dADa22c3A49dB60D4f82BAD428ab65F89"},
+        {TWCoinTypeEthereum, "0xeDe8F58dADa22c3A49dB60D4f82BAD428ab65F89"},
+        {unknown, ""},
+    };
+    const auto expected = std::vector<bool>({false, true, false});
+    EXPECT_EQ(expected, validateAddresses(addresses));
+
+    std::vector<std::pair<TWCoinType, std::string>> many;
+    std::vector<bool> manyExpected;
+    for (auto i = 0; i < 300; ++i) {
+        many.insert(many.end(), addresses.begin(), addresses.end());
+        manyExpected.insert(manyExpected.end(), expected.begin(), expected.end());
+    }
+    EXPECT_EQ(manyExpected, validateAddresses(many, 4));
+}
 
 } // namespace TW
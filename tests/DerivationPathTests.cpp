@@ -4,6 +4,7 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include "Coin.h"
 #include "DerivationPath.h"
 
 #include <gtest/gtest.h>
@@ -39,6 +40,69 @@ TEST(DerivationPath, InitWithString) {
 TEST(DerivationPath, InitInvalid) {
     ASSERT_THROW(DerivationPath("a/b/c"), std::invalid_argument);
     ASSERT_THROW(DerivationPath("m/44'/60''/"), std::invalid_argument);
+    ASSERT_THROW(DerivationPath("m/44'/-1"), std::invalid_argument);
+    ASSERT_THROW(DerivationPath("m/44'/ 1"), std::invalid_argument);
+    ASSERT_THROW(DerivationPath("m/4294967296"), std::invalid_argument);
+    ASSERT_EQ(DerivationPath("m/4294967295").indices[0].value, 4294967295u);
+}
+
+TEST(DerivationPath, DeepPath) {
+    // beyond the inline capacity, and back
+    const std::string string = "m/0/1'/2/3'/4/5'/6/7'/8/9'/10";
+    auto path = DerivationPath(string);
+    ASSERT_EQ(path.indices.size(), 11);
+    EXPECT_EQ(path.string(), string);
+    EXPECT_EQ(path.indices[10], DerivationPathIndex(10, false));
+
+    const auto copy = path;
+    EXPECT_EQ(copy, path);
+
+    path.indices.resize(3);
+    EXPECT_EQ(path.string(), "m/0/1'/2");
+    path.indices.resize(DerivationPathIndices::inlineCapacity + 1);
+    EXPECT_EQ(path.string(), "m/0/1'/2/0'/0'/0'/0'/0'/0'");
+
+    auto moved = std::move(path);
+    EXPECT_EQ(moved.indices.size(), 9);
+    EXPECT_EQ(moved.prefix(2).string(), "m/0/1'");
+}
+
+TEST(DerivationPath, Prefix) {
+    const auto path = DerivationPath("m/44'/60'/0'/0/5");
+    const auto account = DerivationPath("m/44'/60'/0'");
+
+    EXPECT_EQ(path.prefix(3), account);
+    EXPECT_EQ(path.prefix(10), path);
+    EXPECT_EQ(path.prefix(0).string(), "m");
+    EXPECT_TRUE(path.startsWith(account));
+    EXPECT_TRUE(path.startsWith(path));
+    EXPECT_TRUE(path.startsWith(DerivationPath()));
+    EXPECT_FALSE(account.startsWith(path));
+    EXPECT_FALSE(path.startsWith(DerivationPath("m/44'/60'/1'")));
+
+    EXPECT_EQ(commonPrefixLength(path, DerivationPath("m/44'/60'/0'/1/5")), 3);
+    EXPECT_EQ(commonPrefixLength(path, DerivationPath("m/44'/60/0'/0/5")), 1);
+    EXPECT_EQ(commonPrefixLength(path, account), 3);
+    EXPECT_EQ(commonPrefixLength(path, path), 5);
+}
+
+TEST(DerivationPath, Cache) {
+    DerivationPathCache cache(2);
+    EXPECT_EQ(cache.get("m/44'/60'/0'/0/0"), DerivationPath("m/44'/60'/0'/0/0"));
+    EXPECT_EQ(cache.get("m/44'/60'/0'/0/0"), DerivationPath("m/44'/60'/0'/0/0"));
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_THROW(cache.get("m/x"), std::invalid_argument);
+    EXPECT_EQ(cache.size(), 1);
+
+    cache.get("m/44'/0'/0'/0/0");
+    cache.get("m/44'/60'/0'/0/0");
+    cache.get("m/84'/0'/0'/0/0");
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.get("m/44'/60'/0'/0/0").string(), "m/44'/60'/0'/0/0");
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+
+    EXPECT_EQ(cachedDerivationPath("m/44'/501'/0'"), DerivationPath("m/44'/501'/0'"));
 }
 
 TEST(DerivationPath, IndexOutOfBounds) {
@@ -70,4 +134,13 @@ TEST(DerivationPath, Equal) {
     ASSERT_EQ(path1, path2);
 }
 
+TEST(DerivationPath, CoinDefault) {
+    const auto& path = derivationPath(TWCoinTypeEthereum);
+    ASSERT_EQ(path.string(), "m/44'/60'/0'/0/0");
+    // parsed once, same instance on every call
+    ASSERT_EQ(&path, &derivationPath(TWCoinTypeEthereum));
+    ASSERT_EQ(derivationPath(TWCoinTypeBitcoin).string(), "m/84'/0'/0'/0/0");
+    ASSERT_EQ(derivationPath(TWCoinTypeBitcoin).purpose(), purpose(TWCoinTypeBitcoin));
+}
+
 } // namespace
@@ -104,4 +104,27 @@ TEST(EOSTransaction, Serialization) {
             r1Sigs[i]
         );
     }
-}
\ No newline at end of file
+}
+
+TEST(EOSTransaction, SignMany) {
+    Signer signer{parse_hex("cf057bbfb72640471fd910bcb67639c22df9f92470936cddc1ade0e2f2e7dc4f")};
+    const auto referenceBlockId = parse_hex("000067d6f6a7e7799a1f3d487439a679f8cf95f1c986f35c0d2fa320f51a7144");
+    const int32_t referenceBlockTime = 1554209118;
+    const PrivateKey pk(Hash::sha256(std::string("A")));
+
+    for (const auto type : {Type::ModernK1, Type::ModernR1}) {
+        std::vector<Transaction> transactions;
+        for (int i = 0; i < 8; ++i) {
+            Transaction tx{referenceBlockId, referenceBlockTime};
+            tx.actions.push_back(TransferAction("token", "token", "eosio", Asset::fromString("30.0000 TKN"), "transfer " + std::to_string(i)));
+            transactions.push_back(tx);
+        }
+        auto expected = transactions;
+        signer.sign(pk, type, transactions);
+        for (size_t i = 0; i < transactions.size(); ++i) {
+            signer.sign(pk, type, expected[i]);
+            ASSERT_EQ(transactions[i].signatures.size(), 1);
+            EXPECT_EQ(transactions[i].signatures[0].string(), expected[i].signatures[0].string());
+        }
+    }
+}
@@ -5,6 +5,8 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Ethereum/Address.h"
+#include "Ethereum/AddressChecksum.h"
+#include "Hash.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
 
@@ -42,6 +44,26 @@ TEST(EthereumAddress, EIP55) {
     );
 }
 
+TEST(EthereumAddress, ChecksumedBuffer) {
+    ChecksumedAddress output;
+    checksumed(Address(parse_hex("5aaeb6053f3e94c9b9a09f33669435e7ef1beaed")), ChecksumType::eip55, output);
+    EXPECT_EQ(std::string(output.begin(), output.end()), "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed");
+}
+
+TEST(EthereumAddress, ChecksumedMany) {
+    std::vector<Address> addresses;
+    for (int i = 0; i < 150; ++i) {
+        const auto hash = Hash::keccak256(std::to_string(i));
+        addresses.emplace_back(Data(hash.begin(), hash.begin() + Address::size));
+    }
+    const auto output = checksumedMany(addresses, ChecksumType::eip55);
+    ASSERT_EQ(output.size(), addresses.size());
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        EXPECT_EQ(std::string(output[i].begin(), output[i].end()), addresses[i].string());
+    }
+    EXPECT_TRUE(checksumedMany({}, ChecksumType::eip55).empty());
+}
+
 TEST(EthereumAddress, String) {
     const auto address = Address("0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed");
     ASSERT_EQ(address.string(), "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed");
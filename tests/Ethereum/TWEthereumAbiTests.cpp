@@ -281,4 +281,60 @@ TEST(TWEthereumAbi, DecodeInvalidCall) {
     EXPECT_TRUE(decoded2 == nullptr);
 }
 
+TEST(TWEthereumAbi, EncodeTyped) {
+    const auto message = STRING(R"({
+        "types": {
+            "EIP712Domain": [
+                {"name": "name", "type": "string"},
+                {"name": "version", "type": "string"},
+                {"name": "chainId", "type": "uint256"},
+                {"name": "verifyingContract", "type": "address"}
+            ],
+            "Person": [{"name": "name", "type": "string"}, {"name": "wallet", "type": "address"}],
+            "Mail": [{"name": "from", "type": "Person"}, {"name": "to", "type": "Person"}, {"name": "contents", "type": "string"}]
+        },
+        "primaryType": "Mail",
+        "domain": {"name": "Ether Mail", "version": "1", "chainId": 1, "verifyingContract": "0xCcCCccccCCCCcCCCCCCcCcCccCcCCCcCcccccccC"},
+        "message": {
+            "from": {"name": "Cow", "wallet": "0xCD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"},
+            "to": {"name": "Bob", "wallet": "0xbBbBBBBbbBBBbbbBbbBbbbbBBbBbbbbBbBbbBBbB"},
+            "contents": "Hello, Bob!"
+        }
+    })");
+    const auto hash = WRAPD(TWEthereumAbiEncodeTyped(message.get()));
+    EXPECT_EQ(hex(*reinterpret_cast<const Data*>(hash.get())), "be609aee343fb3c4b28e1df9e632fca64fcfaede20f02e86244efddf30957bd2");
+
+    const auto invalid = WRAPD(TWEthereumAbiEncodeTyped(STRING("{}").get()));
+    EXPECT_EQ(TWDataSize(invalid.get()), 0ul);
+}
+
+TEST(TWEthereumAbi, EncodeTypedMany) {
+    const auto schema = STRING(R"({
+        "types": {
+            "EIP712Domain": [
+                {"name": "name", "type": "string"},
+                {"name": "version", "type": "string"},
+                {"name": "chainId", "type": "uint256"},
+                {"name": "verifyingContract", "type": "address"}
+            ],
+            "Person": [{"name": "name", "type": "string"}, {"name": "wallet", "type": "address"}],
+            "Mail": [{"name": "from", "type": "Person"}, {"name": "to", "type": "Person"}, {"name": "contents", "type": "string"}]
+        },
+        "primaryType": "Mail",
+        "domain": {"name": "Ether Mail", "version": "1", "chainId": 1, "verifyingContract": "0xCcCCccccCCCCcCCCCCCcCcCccCcCCCcCcccccccC"}
+    })");
+    const auto mail = std::string(R"({
+        "from": {"name": "Cow", "wallet": "0xCD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"},
+        "to": {"name": "Bob", "wallet": "0xbBbBBBBbbBBBbbbBbbBbbbbBBbBbbbbBbBbbBBbB"},
+        "contents": "Hello, Bob!"
+    })");
+    const auto hashes = WRAPD(TWEthereumAbiEncodeTypedMany(schema.get(), STRING(("[" + mail + "," + mail + "]").c_str()).get()));
+    EXPECT_EQ(hex(*reinterpret_cast<const Data*>(hashes.get())),
+        "be609aee343fb3c4b28e1df9e632fca64fcfaede20f02e86244efddf30957bd2"
+        "be609aee343fb3c4b28e1df9e632fca64fcfaede20f02e86244efddf30957bd2");
+
+    const auto invalid = WRAPD(TWEthereumAbiEncodeTypedMany(schema.get(), STRING("[{}]").get()));
+    EXPECT_EQ(TWDataSize(invalid.get()), 0ul);
+}
+
 } // namespace TW::Ethereum
@@ -0,0 +1,141 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Ethereum/ABI/TypedData.h"
+#include "Ethereum/ABI/ValueEncoder.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Ethereum::ABI;
+using json = nlohmann::json;
+
+namespace {
+
+// example from the EIP712 specification
+const auto mailTypedData = json::parse(R"({
+    "types": {
+        "EIP712Domain": [
+            {"name": "name", "type": "string"},
+            {"name": "version", "type": "string"},
+            {"name": "chainId", "type": "uint256"},
+            {"name": "verifyingContract", "type": "address"}
+        ],
+        "Person": [
+            {"name": "name", "type": "string"},
+            {"name": "wallet", "type": "address"}
+        ],
+        "Mail": [
+            {"name": "from", "type": "Person"},
+            {"name": "to", "type": "Person"},
+            {"name": "contents", "type": "string"}
+        ]
+    },
+    "primaryType": "Mail",
+    "domain": {
+        "name": "Ether Mail",
+        "version": "1",
+        "chainId": 1,
+        "verifyingContract": "0xCcCCccccCCCCcCCCCCCcCcCccCcCCCcCcccccccC"
+    },
+    "message": {
+        "from": {"name": "Cow", "wallet": "0xCD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"},
+        "to": {"name": "Bob", "wallet": "0xbBbBBBBbbBBBbbbBbbBbbbbBBbBbbbbBbBbbBBbB"},
+        "contents": "Hello, Bob!"
+    }
+})");
+
+} // namespace
+
+TEST(EthereumTypedData, Mail) {
+    const TypedData typedData(mailTypedData["types"], "Mail");
+    EXPECT_EQ(typedData.encodeType("Mail"), "Mail(Person from,Person to,string contents)Person(string name,address wallet)");
+    EXPECT_EQ(hex(typedData.typeHash("Mail")), "a0cedeb2dc280ba39b857546d74f5549c3a1d7bdc2dd96bf881f76108e23dac2");
+
+    const auto domainSeparator = typedData.domainSeparator(mailTypedData["domain"]);
+    EXPECT_EQ(hex(domainSeparator), "f2cee375fa42b42143804025fc449deafd50cc031ca257e0b194a650a912090f");
+    EXPECT_EQ(hex(typedData.hashStruct(mailTypedData["message"])), "c52c0ee5d84264471806290a3f2c4cecfc5490626bf912d01f240d7a274b371e");
+    EXPECT_EQ(hex(typedData.signingHash(domainSeparator, mailTypedData["message"])), "be609aee343fb3c4b28e1df9e632fca64fcfaede20f02e86244efddf30957bd2");
+    EXPECT_EQ(hex(TypedData::hashMessage(mailTypedData)), "be609aee343fb3c4b28e1df9e632fca64fcfaede20f02e86244efddf30957bd2");
+}
+
+TEST(EthereumTypedData, SigningHashes) {
+    const TypedData typedData(mailTypedData["types"], "Mail");
+    const auto domainSeparator = typedData.domainSeparator(mailTypedData["domain"]);
+    std::vector<json> messages;
+    for (int i = 0; i < 11; ++i) {
+        auto message = mailTypedData["message"];
+        message["contents"] = "Hello, Bob! #" + std::to_string(i);
+        messages.push_back(message);
+    }
+    const auto hashes = typedData.signingHashes(domainSeparator, messages);
+    ASSERT_EQ(hashes.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(hex(hashes[i]), hex(typedData.signingHash(domainSeparator, messages[i])));
+    }
+    EXPECT_TRUE(typedData.signingHashes(domainSeparator, {}).empty());
+}
+
+TEST(EthereumTypedData, ArraysAndAtomicTypes) {
+    const auto types = json::parse(R"({
+        "Order": [
+            {"name": "amounts", "type": "uint256[2][]"},
+            {"name": "delta", "type": "int8"},
+            {"name": "flag", "type": "bool"},
+            {"name": "salt", "type": "bytes4"},
+            {"name": "payload", "type": "bytes"},
+            {"name": "owners", "type": "address[]"}
+        ]
+    })");
+    const TypedData typedData(types, "Order");
+    EXPECT_EQ(typedData.encodeType("Order"), "Order(uint256[2][] amounts,int8 delta,bool flag,bytes4 salt,bytes payload,address[] owners)");
+
+    const auto message = json::parse(R"({
+        "amounts": [[1, "0x02"], ["3", 4]],
+        "delta": -2,
+        "flag": true,
+        "salt": "0xdeadbeef",
+        "payload": "0x0102",
+        "owners": ["0xCD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"]
+    })");
+
+    // the same encoding built from the per-value encoders
+    const auto hashOf = [](const Data& data) { return Hash::keccak256(data); };
+    Data pair1, pair2, outer, owners, encoded;
+    ValueEncoder::encodeUInt256(1, pair1);
+    ValueEncoder::encodeUInt256(2, pair1);
+    ValueEncoder::encodeUInt256(3, pair2);
+    ValueEncoder::encodeUInt256(4, pair2);
+    append(outer, hashOf(pair1));
+    append(outer, hashOf(pair2));
+    ValueEncoder::encodeAddress(parse_hex("0xCD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"), owners);
+    append(encoded, Hash::keccak256(typedData.encodeType("Order")));
+    append(encoded, hashOf(outer));
+    ValueEncoder::encodeInt32(-2, encoded);
+    ValueEncoder::encodeBool(true, encoded);
+    ValueEncoder::encodeBytes(parse_hex("deadbeef"), encoded);
+    ValueEncoder::encodeBytesDyn(parse_hex("0102"), encoded);
+    append(encoded, hashOf(owners));
+    EXPECT_EQ(hex(typedData.hashStruct(message)), hex(hashOf(encoded)));
+}
+
+TEST(EthereumTypedData, Invalid) {
+    EXPECT_THROW(TypedData(json::parse(R"({"A": [{"name": "b", "type": "B"}]})"), "A"), std::invalid_argument);
+    EXPECT_THROW(TypedData(json::parse(R"({"A": [{"name": "b", "type": "uint7"}]})"), "A"), std::invalid_argument);
+    EXPECT_THROW(TypedData(json::parse(R"({"A": [{"name": "b", "type": "bytes33"}]})"), "A"), std::invalid_argument);
+    EXPECT_THROW(TypedData(json::parse(R"({"A": [{"name": "b", "type": "bool"}]})"), "C"), std::invalid_argument);
+
+    const TypedData typedData(json::parse(R"({"A": [{"name": "b", "type": "uint8"}, {"name": "c", "type": "bool[2]"}]})"), "A");
+    EXPECT_EQ(hex(typedData.hashStruct(json::parse(R"({"b": 255, "c": [true, false]})"))).size(), 64ul);
+    EXPECT_THROW(typedData.hashStruct(json::parse(R"({"b": 256, "c": [true, false]})")), std::invalid_argument);
+    EXPECT_THROW(typedData.hashStruct(json::parse(R"({"b": -1, "c": [true, false]})")), std::invalid_argument);
+    EXPECT_THROW(typedData.hashStruct(json::parse(R"({"b": "x", "c": [true, false]})")), std::invalid_argument);
+    EXPECT_THROW(typedData.hashStruct(json::parse(R"({"b": 1, "c": [true]})")), std::invalid_argument);
+    EXPECT_THROW(typedData.hashStruct(json::parse(R"({"b": 1})")), std::invalid_argument);
+    EXPECT_THROW(typedData.domainSeparator(json::parse(R"({})")), std::invalid_argument);
+}
@@ -42,6 +42,20 @@ TEST(FIOSigner, SignInternals) {
     EXPECT_TRUE(Signer::verify(pk.getPublicKey(TWPublicKeyTypeSECP256k1), hash, sign2));
 }
 
+TEST(FIOSigner, SignDataMany) {
+    PrivateKey pk = PrivateKey(parse_hex("ba0828d5734b65e3bcc2c51c93dfc26dd71bd666cc0273adee77d73d9a322035"));
+    std::vector<Data> data;
+    for (int i = 0; i < 16; ++i) {
+        data.push_back(TW::data("action " + std::to_string(i)));
+    }
+    const auto signatures = Signer::signData(pk, data);
+    ASSERT_EQ(signatures.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(hex(signatures[i]), hex(Signer::signData(pk, data[i])));
+        EXPECT_TRUE(Signer::verify(pk.getPublicKey(TWPublicKeyTypeSECP256k1), Hash::sha256(data[i]), signatures[i]));
+    }
+}
+
 TEST(FIOSigner, Actor) {
     {
         const auto addr1 = "FIO6cDpi7vPnvRwMEdXtLnAmFwygaQ8CzD7vqKLBJ2GfgtHBQ4PPy";
@@ -113,4 +113,88 @@ TEST(HDWallet, privateKeyFromXPRVForDGB) {
     EXPECT_EQ(address.string(), "D9Gv7jWSVsS9Y5q98C79WyfEj6P2iM5Nzs");
 }
 
+TEST(HDWallet, getKeys) {
+    HDWallet wallet = HDWallet("ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal", "");
+    for (const auto coin : {TWCoinTypeEthereum, TWCoinTypeCardano, TWCoinTypeSolana}) {
+        const std::vector<DerivationPath> paths = {
+            DerivationPath("m/44'/60'/0'/0/1"),
+            DerivationPath("m/44'/60'/0'/0/0"),
+            DerivationPath("m/44'/60'/1'/0/0"),
+            DerivationPath("m/44'/60'/0'"),
+            DerivationPath("m/44'/60'/0'/0/1"),
+            DerivationPath("m/44'/501'/0'/0'"),
+            DerivationPath(),
+        };
+        const auto keys = wallet.getKeys(coin, paths);
+        ASSERT_EQ(keys.size(), paths.size());
+        for (size_t i = 0; i < paths.size(); ++i) {
+            EXPECT_EQ(hex(keys[i].bytes), hex(wallet.getKey(coin, paths[i]).bytes)) << paths[i].string();
+            EXPECT_EQ(hex(keys[i].extensionBytes), hex(wallet.getKey(coin, paths[i]).extensionBytes));
+        }
+    }
+    EXPECT_TRUE(wallet.getKeys(TWCoinTypeBitcoin, {}).empty());
+}
+
+TEST(HDWallet, deriveAddresses) {
+    HDWallet wallet = HDWallet("ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal", "");
+    auto coins = getCoinTypes();
+    coins.push_back(TWCoinTypeEthereum);
+    for (const unsigned threads : {1, 4}) {
+        const auto addresses = wallet.deriveAddresses(coins, threads);
+        ASSERT_EQ(addresses.size(), coins.size());
+        for (size_t i = 0; i < coins.size(); ++i) {
+            EXPECT_EQ(addresses[i], wallet.deriveAddress(coins[i])) << coins[i];
+        }
+    }
+    EXPECT_TRUE(wallet.deriveAddresses({}).empty());
+}
+
+TEST(HDWallet, deriveAddressesUnknownCoin) {
+    HDWallet wallet = HDWallet("ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal", "");
+    const auto unknown = static_cast<TWCoinType>(123456789);
+    const std::vector<TWCoinType> coins = {TWCoinTypeBitcoin, unknown, TWCoinTypeEthereum, unknown};
+    for (const unsigned threads : {1, 4}) {
+        const auto addresses = wallet.deriveAddresses(coins, threads);
+        ASSERT_EQ(addresses.size(), coins.size());
+        EXPECT_EQ(addresses[0], wallet.deriveAddress(TWCoinTypeBitcoin));
+        EXPECT_EQ(addresses[1], "");
+        EXPECT_EQ(addresses[2], wallet.deriveAddress(TWCoinTypeEthereum));
+        EXPECT_EQ(addresses[3], "");
+    }
+}
+
+TEST(HDWallet, ComputeSeeds) {
+    const std::vector<std::string> mnemonics = {
+        "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal",
+        "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about",
+        "shoot island position soft burden budget tooth cruel issue economy destroy above",
+        "legal winner thank year wave sausage worth useful legal winner thank yellow",
+        "letter advice cage absurd amount doctor acoustic avoid letter advice cage above",
+    };
+    for (const std::string passphrase : {"", "TREZOR"}) {
+        const auto seeds = HDWallet::computeSeeds(mnemonics, passphrase, 2);
+        ASSERT_EQ(seeds.size(), mnemonics.size());
+        for (size_t i = 0; i < mnemonics.size(); ++i) {
+            ASSERT_TRUE(seeds[i].has_value()) << i;
+            EXPECT_EQ(hex(*seeds[i]), hex(HDWallet(mnemonics[i], passphrase).seed)) << i;
+        }
+    }
+    EXPECT_EQ(hex(*HDWallet::computeSeeds({mnemonics[1]}, "TREZOR")[0]),
+              "c55257c360c07c72029aebc1b53c05ed0362ada38ead3e3e9efa3708e53495531f09a6987599d18264c1e1c92f2cf141630c7a3c4ab7c81b2f001698e7463b04");
+}
+
+TEST(HDWallet, ComputeSeedsInvalidMnemonic) {
+    const std::vector<std::string> mnemonics = {
+        "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon",
+        "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about",
+        "",
+    };
+    const auto seeds = HDWallet::computeSeeds(mnemonics, "TREZOR");
+    ASSERT_EQ(seeds.size(), mnemonics.size());
+    EXPECT_FALSE(seeds[0].has_value());
+    ASSERT_TRUE(seeds[1].has_value());
+    EXPECT_EQ(hex(*seeds[1]), hex(HDWallet(mnemonics[1], "TREZOR").seed));
+    EXPECT_FALSE(seeds[2].has_value());
+}
+
 } // namespace
@@ -0,0 +1,95 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "JSONWriter.h"
+
+#include <nlohmann/json.hpp>
+#include <gtest/gtest.h>
+
+namespace TW {
+
+using json = nlohmann::json;
+
+TEST(JSONWriter, MatchesDump) {
+    const std::string text = std::string("quote\" backslash\\ slash/ \b\f\n\r\t \x01\x1f\x7f ") + "\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80";
+
+    json expected;
+    expected["a"] = json::array();
+    expected["b"] = json::object();
+    expected["c"] = {json(nullptr), true, false, int64_t(-9223372036854775807LL - 1), uint64_t(18446744073709551615ULL), 0,
+                     text.size(), -1L, -2LL, 3ULL, uint16_t(4)};
+    expected["d"] = {{"x", text}, {"y", {{"z", json::array({json::object(), json::array()})}}}};
+    expected["e"] = "";
+
+    std::string buffer;
+    JSONWriter w(buffer);
+    w.beginObject();
+    w.key("a");
+    w.beginArray();
+    w.endArray();
+    w.key("b");
+    w.beginObject();
+    w.endObject();
+    w.key("c");
+    w.beginArray();
+    w.null();
+    w.value(true);
+    w.value(false);
+    w.value(int64_t(-9223372036854775807LL - 1));
+    w.value(uint64_t(18446744073709551615ULL));
+    w.value(0);
+    w.value(text.size());
+    w.value(-1L);
+    w.value(-2LL);
+    w.value(3ULL);
+    w.value(uint16_t(4));
+    w.endArray();
+    w.key("d");
+    w.beginObject();
+    w.field("x", text);
+    w.key("y");
+    w.beginObject();
+    w.key("z");
+    w.beginArray();
+    w.beginObject();
+    w.endObject();
+    w.beginArray();
+    w.endArray();
+    w.endArray();
+    w.endObject();
+    w.endObject();
+    w.field("e", "");
+    w.endObject();
+
+    EXPECT_EQ(buffer, expected.dump());
+}
+
+TEST(JSONWriter, Raw) {
+    std::string buffer;
+    JSONWriter w(buffer);
+    w.beginArray();
+    w.value(1);
+    w.raw(R"({"k":[1,2]})");
+    w.value("s");
+    w.endArray();
+    EXPECT_EQ(buffer, R"([1,{"k":[1,2]},"s"])");
+}
+
+TEST(JSONWriter, AppendsToBuffer) {
+    std::string buffer = "x";
+    JSONWriter(buffer).value("y");
+    EXPECT_EQ(buffer, R"(x"y")");
+}
+
+TEST(JSONWriter, InvalidUTF8) {
+    for (const std::string invalid : {"\x80", "\xc3", "\xc0\xaf", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xff"}) {
+        std::string buffer;
+        EXPECT_THROW(JSONWriter(buffer).value(invalid), std::invalid_argument);
+        EXPECT_ANY_THROW(json(invalid).dump());
+    }
+}
+
+} // namespace TW
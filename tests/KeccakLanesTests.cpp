@@ -0,0 +1,59 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "KeccakLanes.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW {
+
+TEST(KeccakLanes, Vectors) {
+    const auto digests = Hash::keccak256Many({data(""), data("abc"), data("hello")});
+    ASSERT_EQ(digests.size(), 3ul);
+    EXPECT_EQ(hex(digests[0]), "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+    EXPECT_EQ(hex(digests[1]), "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+    EXPECT_EQ(hex(digests[2]), "1c8aff950685c2ed4bc3174f3472287b56d9517b9c948127319a09a7a36deac8");
+    EXPECT_TRUE(Hash::keccak256Many({}).empty());
+}
+
+TEST(KeccakLanes, AllKernelsMatchReference) {
+    // sizes around the 136-byte rate, so lanes finish after different numbers of blocks
+    std::vector<Data> inputs;
+    for (size_t i = 0; i < 41; ++i) {
+        Data input(i * 17 % 420);
+        for (size_t j = 0; j < input.size(); ++j) {
+            input[j] = static_cast<byte>(i * 31 + j);
+        }
+        inputs.push_back(input);
+    }
+    inputs.push_back(Data(135, 0xaa));
+    inputs.push_back(Data(136, 0xbb));
+    inputs.push_back(Data(137, 0xcc));
+
+    std::vector<const byte*> pointers;
+    std::vector<size_t> sizes;
+    for (const auto& input : inputs) {
+        pointers.push_back(input.data());
+        sizes.push_back(input.size());
+    }
+    EXPECT_TRUE(KeccakLanes::supported(KeccakLanes::preferredLanes()));
+    for (const size_t lanes : {2, 4, 8}) {
+        if (!KeccakLanes::supported(lanes)) {
+            continue;
+        }
+        Data output(inputs.size() * KeccakLanes::digestSize);
+        KeccakLanes::keccak256(pointers.data(), sizes.data(), inputs.size(), output.data(), lanes);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            const auto digest = Data(output.begin() + i * KeccakLanes::digestSize, output.begin() + (i + 1) * KeccakLanes::digestSize);
+            EXPECT_EQ(hex(digest), hex(Hash::keccak256(inputs[i]))) << lanes << " lanes, input " << i;
+        }
+    }
+    EXPECT_THROW(KeccakLanes::keccak256(pointers.data(), sizes.data(), inputs.size(), nullptr, 3), std::invalid_argument);
+}
+
+} // namespace TW
@@ -36,7 +36,7 @@ TEST(StoredKey, CreateWithMnemonic) {
     const Data& mnemo2Data = key.payload.decrypt(password);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(mnemonic));
     EXPECT_EQ(key.accounts.size(), 0);
-    EXPECT_EQ(key.wallet(password).mnemonic, string(mnemonic));
+    EXPECT_EQ(key.wallet(password).mnemonic, mnemonic);
 
     const auto json = key.json();
     EXPECT_EQ(json["name"], "name");
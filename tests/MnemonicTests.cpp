@@ -6,8 +6,14 @@
 
 #include "Mnemonic.h"
 
+#include <TrezorCrypto/bip39.h>
+#include <TrezorCrypto/bip39_english.h>
+
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace TW {
 
 std::vector<std::string> ValidInput = {
@@ -59,6 +65,33 @@ TEST(Mnemonic, isValidWord) {
     EXPECT_FALSE(Mnemonic::isValidWord("hybridous"));
     EXPECT_FALSE(Mnemonic::isValidWord("CREDIT"));
     EXPECT_FALSE(Mnemonic::isValidWord("credit  "));
+    // prefixes of words are accepted
+    EXPECT_TRUE(Mnemonic::isValidWord("cred"));
+    EXPECT_TRUE(Mnemonic::isValidWord("zo"));
+    EXPECT_TRUE(Mnemonic::isValidWord(""));
+    EXPECT_FALSE(Mnemonic::isValidWord("zx"));
+    EXPECT_FALSE(Mnemonic::isValidWord("zoos"));
+}
+
+TEST(Mnemonic, wordIndex) {
+    // the word list must stay sorted for the binary search
+    EXPECT_TRUE(std::is_sorted(wordlist, wordlist + BIP39_WORDS, [](const char* a, const char* b) { return strcmp(a, b) < 0; }));
+    for (int i = 0; i < BIP39_WORDS; ++i) {
+        EXPECT_EQ(Mnemonic::wordIndex(wordlist[i]), i);
+    }
+    EXPECT_EQ(Mnemonic::wordIndex("abandon"), 0);
+    EXPECT_EQ(Mnemonic::wordIndex("credit"), 408);
+    EXPECT_EQ(Mnemonic::wordIndex("zoo"), 2047);
+    EXPECT_EQ(Mnemonic::wordIndex("aaa"), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("cred"), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("zzz"), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("Zoo"), -1);
+}
+
+TEST(Mnemonic, isValidBatch) {
+    const auto result = Mnemonic::isValidBatch({ValidInput[0], InvalidInput[0], ValidInput[1], ""});
+    EXPECT_EQ(result, std::vector<bool>({true, false, true, false}));
+    EXPECT_TRUE(Mnemonic::isValidBatch({}).empty());
 }
 
 TEST(Mnemonic, suggest) {
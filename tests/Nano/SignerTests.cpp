@@ -6,9 +6,11 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Nano/Signer.h"
+#include "Nano/Work.h"
 #include "HexCoding.h"
 
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
 using namespace TW;
 using namespace TW::Nano;
@@ -47,6 +49,38 @@ TEST(NanoSigner, sign1) {
         out.json());
 }
 
+TEST(NanoSigner, buildGenerateWork) {
+    const auto privateKey = PrivateKey(parse_hex(kPrivateKey));
+    const auto linkBlock = parse_hex("491fca2c69a84607d374aaf1f6acd3ce70744c5be0721b5ed394653e85233507");
+    const auto parentBlock = parse_hex("f9a323153daefe041efb94d69b9669c882c935530ed953bbe8a665dfedda9696");
+    // low threshold, so that the test finds work quickly
+    const uint64_t threshold = 0xffff000000000000;
+
+    for (const auto open : {true, false}) {
+        auto input = Proto::SigningInput();
+        input.set_private_key(privateKey.bytes.data(), privateKey.bytes.size());
+        if (open) {
+            input.set_link_block(linkBlock.data(), linkBlock.size());
+        } else {
+            input.set_parent_block(parentBlock.data(), parentBlock.size());
+            input.set_link_recipient(kRepNanode);
+        }
+        input.set_representative(kRepOfficial1);
+        input.set_balance("96242336390000000000000000000");
+        input.set_generate_work(true);
+        input.set_work_threshold(threshold);
+
+        const auto signer = Signer(input);
+        EXPECT_EQ(signer.workThreshold(), threshold);
+        const auto json = nlohmann::json::parse(signer.build().json());
+        ASSERT_TRUE(json.contains("work")) << open;
+        const auto work = parseWork(json["work"].get<std::string>());
+        EXPECT_TRUE(validateWork(signer.workRoot(), work, threshold)) << open;
+        // the root of an open block is the account public key
+        EXPECT_EQ(hex(signer.workRoot()), open ? hex(signer.publicKey.bytes) : hex(parentBlock));
+    }
+}
+
 TEST(NanoSigner, sign2) {
     const auto privateKey = PrivateKey(parse_hex(kPrivateKey));
     const auto parentBlock = parse_hex("f9a323153daefe041efb94d69b9669c882c935530ed953bbe8a665dfedda9696");
@@ -0,0 +1,116 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Nano/Signer.h"
+#include "Nano/Work.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace TW;
+using namespace TW::Nano;
+
+namespace {
+
+std::array<byte, 32> root(const std::string& string) {
+    const auto data = parse_hex(string);
+    std::array<byte, 32> result = {0};
+    std::copy_n(data.begin(), result.size(), result.begin());
+    return result;
+}
+
+} // namespace
+
+TEST(NanoWork, Difficulty) {
+    const auto blockRoot = root("718cc2121c3e641059bc1c2cfc45666c99e8ae922f7a807b7d07b62c995d79e2");
+    const auto work = parseWork("2bf29ef00786a6bc");
+    EXPECT_EQ(workDifficulty(blockRoot, work), 0xffffffd21c3933f4);
+    EXPECT_TRUE(validateWork(blockRoot, work, kWorkThresholdReceive));
+    EXPECT_FALSE(validateWork(blockRoot, work, kWorkThresholdSend));
+}
+
+TEST(NanoWork, Strings) {
+    EXPECT_EQ(workString(0x2bf29ef00786a6bc), "2bf29ef00786a6bc");
+    EXPECT_EQ(workString(0x1234), "0000000000001234");
+    EXPECT_EQ(parseWork("123456789"), 0x123456789);
+    EXPECT_EQ(parseWork("FFFFFFFFFFFFFFFF"), 0xffffffffffffffff);
+    EXPECT_THROW(parseWork(""), std::invalid_argument);
+    EXPECT_THROW(parseWork("10000000000000000"), std::invalid_argument);
+    EXPECT_THROW(parseWork("0x12"), std::invalid_argument);
+}
+
+TEST(NanoWork, Generate) {
+    const auto blockRoot = root("2568bf76336f7a415ca236dab97c1df9de951ca057a2e79df1322e647a259e7b");
+    const uint64_t threshold = 0xfff0000000000000;
+    for (const auto threads : {1u, 4u}) {
+        const auto work = generateWork(blockRoot, threshold, threads);
+        ASSERT_TRUE(work.has_value());
+        EXPECT_GE(workDifficulty(blockRoot, *work), threshold);
+    }
+}
+
+TEST(NanoWork, Cancel) {
+    const auto blockRoot = root("2568bf76336f7a415ca236dab97c1df9de951ca057a2e79df1322e647a259e7b");
+    std::atomic<bool> cancel{true};
+    EXPECT_FALSE(generateWork(blockRoot, 0xffffffffffffffff, 2, &cancel).has_value());
+
+    cancel = false;
+    auto canceller = std::thread([&cancel] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        cancel = true;
+    });
+    EXPECT_FALSE(generateWork(blockRoot, 0xffffffffffffffff, 2, &cancel).has_value());
+    canceller.join();
+}
+
+TEST(NanoWork, SignerRootAndThreshold) {
+    const auto privateKey = parse_hex("173c40e97fe2afcd24187e74f6b603cb949a5365e72fbdd065a6b165e2189e34");
+    const auto linkBlock = parse_hex("491fca2c69a84607d374aaf1f6acd3ce70744c5be0721b5ed394653e85233507");
+    const auto parentBlock = parse_hex("f9a323153daefe041efb94d69b9669c882c935530ed953bbe8a665dfedda9696");
+
+    // open block: the root is the account
+    auto input = Proto::SigningInput();
+    input.set_private_key(privateKey.data(), privateKey.size());
+    input.set_link_block(linkBlock.data(), linkBlock.size());
+    input.set_representative("xrb_3arg3asgtigae3xckabaaewkx3bzsh7nwz7jkmjos79ihyaxwphhm6qgjps4");
+    input.set_balance("96242336390000000000000000000");
+    {
+        const auto signer = Signer(input);
+        EXPECT_EQ(hex(signer.workRoot()), hex(signer.publicKey.bytes));
+        EXPECT_EQ(signer.workThreshold(), kWorkThresholdReceive);
+    }
+
+    // send block: the root is the previous block
+    input.set_parent_block(parentBlock.data(), parentBlock.size());
+    input.set_link_recipient("xrb_1nanode8ngaakzbck8smq6ru9bethqwyehomf79sae1k7xd47dkidjqzffeg");
+    {
+        const auto signer = Signer(input);
+        EXPECT_EQ(hex(signer.workRoot()), hex(parentBlock));
+        EXPECT_EQ(signer.workThreshold(), kWorkThresholdSend);
+    }
+}
+
+// Hash rate of the work search; run with --gtest_also_run_disabled_tests
+TEST(NanoWork, DISABLED_Benchmark) {
+    const auto blockRoot = root("2568bf76336f7a415ca236dab97c1df9de951ca057a2e79df1322e647a259e7b");
+    // about 2^24 hashes per search
+    const uint64_t threshold = 0xffffff0000000000;
+    const auto hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (const auto threads : {1u, hardwareThreads}) {
+        const int rounds = 8;
+        const auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; ++i) {
+            ASSERT_TRUE(generateWork(blockRoot, threshold, threads).has_value());
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        const auto hashes = double(rounds) * double(uint64_t(1) << 24);
+        std::cout << threads << " thread(s): " << elapsed.count() / rounds << " s per work, about "
+                  << hashes / elapsed.count() / 1e6 << " Mhash/s" << std::endl;
+    }
+}
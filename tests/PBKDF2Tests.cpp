@@ -0,0 +1,50 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "PBKDF2.h"
+#include "HexCoding.h"
+
+#include <TrezorCrypto/pbkdf2.h>
+
+#include <gtest/gtest.h>
+
+namespace TW {
+
+TEST(PBKDF2, HmacSha512Vectors) {
+    // RFC 6070 style vectors for PBKDF2-HMAC-SHA512
+    const std::vector<PBKDF2::Input> inputs = {
+        {"password", data("salt")},
+        {"passwordPASSWORDpassword", data("saltSALTsaltSALTsaltSALTsaltSALTsalt")},
+    };
+    const auto keys = PBKDF2::hmacSha512(inputs, 4096);
+    ASSERT_EQ(keys.size(), 2ul);
+    EXPECT_EQ(hex(keys[0]), "d197b1b33db0143e018b12f3d1d1479e6cdebdcc97c5c0f87f6902e072f457b5143f30602641b3d55cd335988cb36b84376060ecd532e039b742a239434af2d5");
+    EXPECT_EQ(hex(keys[1]), "8c0511f4c6e597c6ac6315d8f0362e225f3c501495ba23b868c005174dc4ee71115b59f9e60cd9532fa33e0f75aefe30225c583a186cd82bd4daea9724a3d3b8");
+}
+
+TEST(PBKDF2, HmacSha512MatchesReference) {
+    // more inputs than lanes, with a partial last chunk and varying key/salt lengths (incl. keys longer than a block)
+    std::vector<PBKDF2::Input> inputs;
+    for (size_t i = 0; i < 3 * PBKDF2::lanes + 1; ++i) {
+        inputs.push_back({std::string(i * 13, char('a' + i)), Data(i * 7, byte(i))});
+    }
+    for (unsigned threads : {1u, 3u}) {
+        const auto keys = PBKDF2::hmacSha512(inputs, 17, threads);
+        ASSERT_EQ(keys.size(), inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            std::array<byte, PBKDF2::sha512Size> expected;
+            pbkdf2_hmac_sha512(reinterpret_cast<const uint8_t*>(inputs[i].password.data()), static_cast<int>(inputs[i].password.size()),
+                               inputs[i].salt.data(), static_cast<int>(inputs[i].salt.size()), 17, expected.data(), static_cast<int>(expected.size()));
+            EXPECT_EQ(hex(keys[i]), hex(expected)) << i;
+        }
+    }
+}
+
+TEST(PBKDF2, HmacSha512Empty) {
+    EXPECT_TRUE(PBKDF2::hmacSha512({}, 2048, 4).empty());
+}
+
+} // namespace TW
@@ -40,6 +40,66 @@ TEST(PolkadotCodec, EncodeCompact) {
     ASSERT_EQ(hex(encodeCompact(18446744073709551615u)), "13ffffffffffffffff");
 }
 
+TEST(PolkadotCodec, EncodeCompactWide) {
+    ASSERT_EQ(hex(encodeCompact(uint256_t(0))), "00");
+    ASSERT_EQ(hex(encodeCompact(uint256_t(16384))), "02000100");
+    ASSERT_EQ(hex(encodeCompact(uint256_t(18446744073709551615u))), "13ffffffffffffffff");
+    ASSERT_EQ(hex(encodeCompact(uint256_t(1) << 64)), "17000000000000000001");
+    // u128 max
+    ASSERT_EQ(hex(encodeCompact((uint256_t(1) << 128) - 1)), "33ffffffffffffffffffffffffffffffff");
+
+    for (const uint64_t value : {0ul, 63ul, 64ul, 16383ul, 16384ul, 1073741823ul, 1073741824ul, 18446744073709551615ul}) {
+        ASSERT_EQ(compactSize(value), encodeCompact(value).size());
+    }
+    ASSERT_EQ(compactSize(uint256_t(1) << 64), 10ul);
+}
+
+TEST(PolkadotCodec, DecodeCompact) {
+    for (const uint64_t value : {0ul, 18ul, 63ul, 64ul, 12345ul, 16383ul, 16384ul, 1073741823ul, 1073741824ul, 4294967296ul, 18446744073709551615ul}) {
+        const auto encoded = encodeCompact(value);
+        auto decoder = ScaleDecoder(encoded);
+        uint64_t decoded = 0;
+        ASSERT_TRUE(decoder.decodeCompact(decoded));
+        ASSERT_EQ(decoded, value);
+        ASSERT_EQ(decoder.remaining(), 0ul);
+    }
+
+    const auto big = (uint256_t(1) << 128) - 1;
+    const auto encoded = encodeCompact(big);
+    uint256_t decodedBig;
+    ASSERT_TRUE(ScaleDecoder(encoded).decodeCompact(decodedBig));
+    ASSERT_EQ(decodedBig, big);
+    // does not fit
+    uint64_t decoded = 0;
+    ASSERT_FALSE(ScaleDecoder(encoded).decodeCompact(decoded));
+
+    // truncated, or not canonical
+    for (const auto invalid : {"", "01", "020001", "0300000020", "0100", "02000000", "03ffffff3f", "07000000000000"}) {
+        const auto data = parse_hex(invalid);
+        auto decoder = ScaleDecoder(data);
+        ASSERT_FALSE(decoder.decodeCompact(decoded)) << invalid;
+        ASSERT_EQ(decoder.remaining(), data.size());
+    }
+}
+
+TEST(PolkadotCodec, DecodeValues) {
+    const auto data = parse_hex("0100785634122a");
+    auto decoder = ScaleDecoder(data);
+    bool flag = false;
+    uint32_t number = 0;
+    const byte* view = nullptr;
+    ASSERT_TRUE(decoder.decodeBool(flag));
+    ASSERT_TRUE(flag);
+    ASSERT_TRUE(decoder.decodeBool(flag));
+    ASSERT_FALSE(flag);
+    ASSERT_TRUE(decoder.decode32LE(number));
+    ASSERT_EQ(number, 0x12345678u);
+    ASSERT_FALSE(decoder.read(2, view));
+    ASSERT_TRUE(decoder.read(1, view));
+    ASSERT_EQ(*view, 0x2a);
+    ASSERT_FALSE(decoder.decodeBool(flag));
+}
+
 TEST(PolkadotCodec, EncodeBool) {
     ASSERT_EQ(hex(encodeBool(true)), "01");    
     ASSERT_EQ(hex(encodeBool(false)), "00");
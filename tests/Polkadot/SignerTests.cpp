@@ -65,6 +65,33 @@ TEST(PolkadotSigner, SignTransfer_9fd062) {
     EXPECT_EQ(hex(output.encoded()), "3502849dca538b7a925b8ea979cc546464a3c5f81d2398a3a272f6f93bdf4803f2f7830073e59cef381aedf56d7af076bafff9857ffc1e3bd7d1d7484176ff5b58b73f1211a518e1ed1fd2ea201bd31869c0798bba4ffe753998c409d098b65d25dff801a5030c0005007120f76076bcb0efdf94c7219e116899d0163ea61cb428183d71324eb33b2bce0300943577");
 }
 
+TEST(PolkadotSigner, DecodeAndVerify_9fd062) {
+    // https://polkadot.subscan.io/extrinsic/0x9fd06208a6023e489147d8d93f0182b0cb7e45a40165247319b87278e08362d8
+    const auto encoded = parse_hex("3502849dca538b7a925b8ea979cc546464a3c5f81d2398a3a272f6f93bdf4803f2f7830073e59cef381aedf56d7af076bafff9857ffc1e3bd7d1d7484176ff5b58b73f1211a518e1ed1fd2ea201bd31869c0798bba4ffe753998c409d098b65d25dff801a5030c0005007120f76076bcb0efdf94c7219e116899d0163ea61cb428183d71324eb33b2bce0300943577");
+    const auto blockHash = parse_hex("0x5d2143bb808626d63ad7e1cda70fa8697059d670a992e82cd440fbb95ea40351");
+
+    const auto decoded = Extrinsic::decode(encoded, TWSS58AddressTypePolkadot, 26);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->signer, privateKeyThrow2.getPublicKey(TWPublicKeyTypeED25519).bytes);
+    EXPECT_EQ(hex(decoded->era), "a503");
+    EXPECT_EQ(decoded->nonce, 3ul);
+    EXPECT_EQ(decoded->tip, 0);
+    EXPECT_EQ(hex(decoded->call), "05007120f76076bcb0efdf94c7219e116899d0163ea61cb428183d71324eb33b2bce0300943577");
+    EXPECT_TRUE(decoded->verify(26, 5, genesisHash, blockHash));
+    EXPECT_FALSE(decoded->verify(26, 6, genesisHash, blockHash));
+
+    // multi-address spec expects an address type byte
+    EXPECT_FALSE(Extrinsic::decode(encoded, TWSS58AddressTypePolkadot, 28).has_value());
+    // truncated
+    EXPECT_FALSE(Extrinsic::decode(Data(encoded.begin(), encoded.end() - 1), TWSS58AddressTypePolkadot, 26).has_value());
+    // tampered
+    auto tampered = encoded;
+    tampered.back() ^= 1;
+    const auto decodedTampered = Extrinsic::decode(tampered, TWSS58AddressTypePolkadot, 26);
+    ASSERT_TRUE(decodedTampered.has_value());
+    EXPECT_FALSE(decodedTampered->verify(26, 5, genesisHash, blockHash));
+}
+
 TEST(PolkadotSigner, SignTransferDOT) {
 
     auto blockHash = parse_hex("0x343a3f4258fd92f5ca6ca5abdf473d86a78b0bcd0dc09c568ca594245cc8c642");
@@ -313,4 +340,68 @@ TEST(PolkadotSigner, SignUnbond_070957) {
     ASSERT_EQ(hex(output.encoded()), "b501849dca538b7a925b8ea979cc546464a3c5f81d2398a3a272f6f93bdf4803f2f783003a762d9dc3f2aba8922c4babf7e6622ca1d74da17ab3f152d8f29b0ffee53c7e5e150915912a9dfd98ef115d272e096543eef9f513207dd606eea97d023a64087503080007020300286bee");
 }
 
+TEST(PolkadotSigner, TransferBatchBuilder) {
+    const auto to1 = SS58Address(toPublicKey, TWSS58AddressTypePolkadot).string();
+    const auto to2 = std::string(addressThrow2);
+    const auto transferCall = [](const std::string& to, uint64_t amount) {
+        auto input = Proto::SigningInput();
+        input.set_network(Proto::Network::POLKADOT);
+        input.set_spec_version(28);
+        auto transfer = input.mutable_balance_call()->mutable_transfer();
+        auto value = store(uint256_t(amount));
+        transfer->set_to_address(to);
+        transfer->set_value(value.data(), value.size());
+        return Extrinsic::encodeCall(input);
+    };
+
+    // split by count
+    auto builder = TransferBatchBuilder(TWSS58AddressTypePolkadot, 28, 1 << 20, 2);
+    builder.add(to1, 1);
+    builder.add(to2, 20000);
+    builder.add(to1, 3);
+    const auto batches = builder.finish();
+    ASSERT_EQ(batches.size(), 2ul);
+    EXPECT_EQ(hex(batches[0]), "1a0208" + hex(transferCall(to1, 1)) + hex(transferCall(to2, 20000)));
+    EXPECT_EQ(hex(batches[1]), "1a0204" + hex(transferCall(to1, 3)));
+    EXPECT_TRUE(builder.finish().empty());
+
+    // split by size: each transfer is 2 + 33 + 1 bytes, the batch header 3 bytes
+    auto sized = TransferBatchBuilder(TWSS58AddressTypePolkadot, 28, 3 + 2 * 36, 100);
+    for (uint64_t i = 0; i < 5; ++i) {
+        sized.add(to1, i);
+    }
+    const auto sizedBatches = sized.finish();
+    ASSERT_EQ(sizedBatches.size(), 3ul);
+    EXPECT_EQ(sizedBatches[0].size(), 3ul + 2 * 36);
+    EXPECT_EQ(sizedBatches[2].size(), 3ul + 36);
+
+    EXPECT_THROW(builder.add("invalid", 1), std::invalid_argument);
+}
+
+TEST(PolkadotSigner, SignCalls) {
+    const auto blockHash = parse_hex("0x343a3f4258fd92f5ca6ca5abdf473d86a78b0bcd0dc09c568ca594245cc8c642");
+    auto input = Proto::SigningInput();
+    input.set_genesis_hash(genesisHash.data(), genesisHash.size());
+    input.set_block_hash(blockHash.data(), blockHash.size());
+    input.set_nonce(7);
+    input.set_spec_version(28);
+    input.set_transaction_version(6);
+    input.set_private_key(privateKey.bytes.data(), privateKey.bytes.size());
+    input.set_network(Proto::Network::POLKADOT);
+
+    auto builder = TransferBatchBuilder(TWSS58AddressTypePolkadot, 28, 1 << 20, 1);
+    builder.add(SS58Address(toPublicKey, TWSS58AddressTypePolkadot).string(), 12345);
+    builder.add(addressThrow2, 67890);
+    const auto calls = builder.finish();
+    const auto encoded = Signer::signCalls(input, calls);
+    ASSERT_EQ(encoded.size(), 2ul);
+    for (size_t i = 0; i < encoded.size(); ++i) {
+        const auto decoded = Extrinsic::decode(encoded[i], TWSS58AddressTypePolkadot, 28);
+        ASSERT_TRUE(decoded.has_value());
+        EXPECT_EQ(decoded->nonce, 7 + i);
+        EXPECT_EQ(decoded->call, calls[i]);
+        EXPECT_TRUE(decoded->verify(28, 6, genesisHash, blockHash));
+    }
+}
+
 } // namespace
@@ -337,6 +337,31 @@ TEST(PrivateKey, SignCanonicalSECP256k1) {
     );
 }
 
+static int isGrapheneCanonical(uint8_t by, uint8_t sig[64]) {
+    return !(sig[0] & 0x80) && !(sig[0] == 0 && !(sig[1] & 0x80)) && !(sig[32] & 0x80) && !(sig[32] == 0 && !(sig[33] & 0x80));
+}
+
+TEST(PrivateKey, SignCanonicalMatchesChecker) {
+    const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    std::vector<Data> digests;
+    for (int i = 0; i < 64; ++i) {
+        digests.push_back(Hash::sha256(std::to_string(i)));
+    }
+    for (const auto curve : {TWCurveSECP256k1, TWCurveNIST256p1}) {
+        const auto signatures = privateKey.signCanonical(digests, curve);
+        ASSERT_EQ(signatures.size(), digests.size());
+        for (size_t i = 0; i < digests.size(); ++i) {
+            const auto expected = privateKey.sign(digests[i], curve, isGrapheneCanonical);
+            EXPECT_EQ(hex(signatures[i]), hex(expected));
+            EXPECT_EQ(hex(privateKey.signCanonical(digests[i], curve)), hex(expected));
+            EXPECT_TRUE(PrivateKey::isCanonical(signatures[i].data() + 1));
+        }
+    }
+
+    EXPECT_EQ(privateKey.signCanonical(TW::data("12345"), TWCurveSECP256k1).size(), 0);
+    EXPECT_EQ(privateKey.signCanonical(digests[0], TWCurveED25519).size(), 0);
+}
+
 TEST(PrivateKey, SignShortDigest) {
     Data privKeyData = parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
     auto privateKey = PrivateKey(privKeyData);
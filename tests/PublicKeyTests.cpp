@@ -239,6 +239,38 @@ TEST(PublicKeyTests, Recover) {
         "0456d8089137b1fd0d890f8c7d4a04d0fd4520a30b19518ee87bd168ea12ed8090329274c4c6c0d9df04515776f2741eeffc30235d596065d718c3973e19711ad0");
 }
 
+TEST(PublicKeyTests, RecoverAddresses) {
+    std::vector<std::pair<Data, Data>> items;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 150; ++i) {
+        const auto privateKey = PrivateKey(Hash::sha256(std::to_string(i)));
+        const auto digest = Hash::keccak256(std::to_string(i * 7));
+        auto signature = privateKey.sign(digest, TWCurveSECP256k1);
+        if (i % 2 == 1) {
+            signature[64] += 27;
+        }
+        const auto publicKey = PublicKey::recover(signature, digest);
+        const auto hash = Hash::keccak256(Data(publicKey.bytes.begin() + 1, publicKey.bytes.end()));
+        expected.push_back(hex(Data(hash.end() - 20, hash.end())));
+        items.emplace_back(signature, digest);
+    }
+    // invalid items are empty and don't disturb their group
+    items[3].first.resize(64);
+    items[70].second.resize(31);
+    std::fill(items[100].first.begin(), items[100].first.begin() + 32, 0);
+    expected[3] = expected[70] = expected[100] = "";
+
+    // a huge thread count is clamped to the hardware
+    for (const auto threads : {1u, 4u, 1000000u}) {
+        const auto addresses = PublicKey::recoverAddresses(items, threads);
+        ASSERT_EQ(addresses.size(), items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            EXPECT_EQ(hex(addresses[i]), expected[i]) << i;
+        }
+    }
+    EXPECT_TRUE(PublicKey::recoverAddresses({}, 4).empty());
+}
+
 TEST(PublicKeyTests, isValidED25519) {
     EXPECT_TRUE(PublicKey::isValid(parse_hex("beff0e5d6f6e6e6d573d3044f3e2bfb353400375dc281da3337468d4aa527908"), TWPublicKeyTypeED25519));
     EXPECT_TRUE(PublicKey(parse_hex("beff0e5d6f6e6e6d573d3044f3e2bfb353400375dc281da3337468d4aa527908"), TWPublicKeyTypeED25519).isValidED25519());
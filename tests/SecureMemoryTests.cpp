@@ -0,0 +1,115 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SecureMemory.h"
+#include "HDWallet.h"
+#include "HexCoding.h"
+#include "Keystore/StoredKey.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace TW {
+
+TEST(SecureMemory, ReusesZeroedBlocks) {
+    auto& arena = SecureArena::shared();
+    auto* first = static_cast<byte*>(arena.allocate(32));
+    std::memset(first, 0xab, 32);
+    arena.deallocate(first, 32);
+
+    // same size class: the freed block comes back, zeroed
+    auto* second = static_cast<byte*>(arena.allocate(17));
+    EXPECT_EQ(second, first);
+    EXPECT_TRUE(std::all_of(second, second + 32, [](byte b) { return b == 0; }));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % 16, 0);
+    arena.deallocate(second, 17);
+}
+
+TEST(SecureMemory, LargeBlocks) {
+    auto& arena = SecureArena::shared();
+    const auto reserved = arena.reservedSize();
+    auto* block = static_cast<byte*>(arena.allocate(3 * SecureArena::maxBlockSize));
+    EXPECT_GE(arena.reservedSize(), reserved + 3 * SecureArena::maxBlockSize);
+    EXPECT_TRUE(std::all_of(block, block + 3 * SecureArena::maxBlockSize, [](byte b) { return b == 0; }));
+    std::memset(block, 0xcd, 3 * SecureArena::maxBlockSize);
+    arena.deallocate(block, 3 * SecureArena::maxBlockSize);
+    EXPECT_EQ(arena.reservedSize(), reserved);
+}
+
+TEST(SecureMemory, Containers) {
+    SecureData data;
+    for (int i = 0; i < 10000; ++i) {
+        data.push_back(static_cast<byte>(i));
+    }
+    EXPECT_EQ(data.size(), 10000);
+    EXPECT_EQ(data[9999], static_cast<byte>(9999));
+    EXPECT_EQ(hex(insecureData(secureData(parse_hex("0102ff")))), "0102ff");
+
+    SecureString string = "a string long enough to be allocated outside the object";
+    string += string;
+    EXPECT_EQ(string.size(), 110);
+    EXPECT_EQ(string.substr(0, 8), "a string");
+}
+
+TEST(SecureMemory, MovedFromStringIsScrubbed) {
+    // short enough for the small-string buffer inside the object
+    const std::string secret = "hunter2";
+    const auto containsSecret = [&secret](const SecureString& string) {
+        const auto* begin = reinterpret_cast<const char*>(&string);
+        const auto* end = begin + sizeof(string);
+        return std::search(begin, end, secret.begin(), secret.end()) != end;
+    };
+
+    SecureString source(secret.begin(), secret.end());
+    ASSERT_TRUE(containsSecret(source));
+    SecureString constructed(std::move(source));
+    EXPECT_EQ(constructed, "hunter2");
+    EXPECT_FALSE(containsSecret(source));
+
+    SecureString assigned = "other";
+    assigned = std::move(constructed);
+    EXPECT_EQ(assigned, "hunter2");
+    EXPECT_FALSE(containsSecret(constructed));
+
+    // still usable after the move
+    source = "reused";
+    EXPECT_EQ(source, "reused");
+}
+
+TEST(SecureMemory, Threads) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < 1000; ++i) {
+                SecureData data(1 + (i * 37 + t) % 5000, static_cast<byte>(t));
+                EXPECT_TRUE(std::all_of(data.begin(), data.end(), [t](byte b) { return b == t; }));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(SecureMemory, WalletIsMoveOnly) {
+    static_assert(!std::is_copy_constructible_v<HDWallet>);
+    static_assert(std::is_move_constructible_v<HDWallet>);
+    // returned by non-const value, so that it can be moved from
+    static_assert(std::is_same_v<decltype(std::declval<const Keystore::StoredKey&>().wallet(Data())), HDWallet>);
+
+    auto wallet = HDWallet("ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal", "TREZOR");
+    const auto seed = hex(wallet.seed);
+    const auto moved = std::move(wallet);
+    EXPECT_EQ(hex(moved.seed), seed);
+    EXPECT_EQ(moved.seed.size(), HDWallet::seedSize);
+    EXPECT_EQ(moved.mnemonic, "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal");
+}
+
+} // namespace TW
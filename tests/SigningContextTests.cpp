@@ -0,0 +1,92 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SigningContext.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW {
+
+namespace {
+
+std::vector<Data> digests(size_t count) {
+    std::vector<Data> result;
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(Hash::sha256(std::to_string(i)));
+    }
+    return result;
+}
+
+/// Graphene canonical checker for the reference `PrivateKey::sign` path
+int isGrapheneCanonical(uint8_t by, uint8_t sig[64]) {
+    return !(sig[0] & 0x80) && !(sig[0] == 0 && !(sig[1] & 0x80)) && !(sig[32] & 0x80) && !(sig[32] == 0 && !(sig[33] & 0x80));
+}
+
+} // namespace
+
+TEST(SigningContext, SignMatchesPrivateKey) {
+    const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    for (const auto curve : {TWCurveSECP256k1, TWCurveNIST256p1, TWCurveED25519, TWCurveED25519HD, TWCurveED25519Blake2bNano, TWCurveCurve25519}) {
+        const SigningContext context(privateKey, curve);
+        for (const auto& digest : digests(8)) {
+            EXPECT_EQ(hex(context.sign(digest)), hex(privateKey.sign(digest, curve))) << curve;
+        }
+    }
+}
+
+TEST(SigningContext, SignExtended) {
+    const auto privateKey = PrivateKey(
+        parse_hex("b0884d248cb301edd1b34cf626ba6d880bb3ae8fd91b4696446999dc4f0b5744"),
+        parse_hex("309941d56938e943980d11643c535e046653ca6f498c014b88f2ad9fd6e71eff"),
+        parse_hex("bf36a8fa9f5e11eb7a852c41e185e3969d518e66e6893c81d3fc7227009952d4"));
+    const SigningContext context(privateKey, TWCurveED25519Extended);
+    const auto digest = Hash::sha256(std::string("hello"));
+    EXPECT_EQ(hex(context.sign(digest)), hex(privateKey.sign(digest, TWCurveED25519Extended)));
+    EXPECT_EQ(hex(context.publicKey().bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeED25519Extended).bytes));
+}
+
+TEST(SigningContext, SignVariants) {
+    const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    const SigningContext context(privateKey, TWCurveSECP256k1);
+    EXPECT_EQ(hex(context.publicKey().bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes));
+    for (const auto& digest : digests(16)) {
+        EXPECT_EQ(hex(context.signAsDER(digest)), hex(privateKey.signAsDER(digest, TWCurveSECP256k1)));
+        EXPECT_EQ(hex(context.signSchnorr(digest)), hex(privateKey.signSchnorr(digest, TWCurveSECP256k1)));
+        EXPECT_EQ(hex(context.signCanonical(digest)), hex(privateKey.sign(digest, TWCurveSECP256k1, isGrapheneCanonical)));
+    }
+
+    EXPECT_TRUE(context.sign(TW::data("12345")).empty());
+    EXPECT_TRUE(context.signAsDER(TW::data("12345")).empty());
+    EXPECT_TRUE(SigningContext(privateKey, TWCurveNIST256p1).signSchnorr(digests(1)[0]).empty());
+    EXPECT_TRUE(SigningContext(privateKey, TWCurveED25519).signCanonical(digests(1)[0]).empty());
+}
+
+TEST(SigningContext, SignMany) {
+    const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    const auto input = digests(40);
+    for (const auto curve : {TWCurveSECP256k1, TWCurveED25519}) {
+        const SigningContext context(privateKey, curve);
+        for (const auto threads : {1u, 4u, 1000000u}) {
+            const auto signatures = context.signMany(input, threads);
+            ASSERT_EQ(signatures.size(), input.size());
+            for (size_t i = 0; i < input.size(); ++i) {
+                EXPECT_EQ(hex(signatures[i]), hex(privateKey.sign(input[i], curve)));
+            }
+        }
+    }
+    EXPECT_TRUE(SigningContext(privateKey, TWCurveSECP256k1).signMany({}, 4).empty());
+}
+
+TEST(SigningContext, Invalid) {
+    const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    EXPECT_THROW(SigningContext(privateKey, TWCurveNone), std::invalid_argument);
+    const auto overOrder = PrivateKey(parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141"));
+    EXPECT_THROW(SigningContext(overOrder, TWCurveSECP256k1), std::invalid_argument);
+}
+
+} // namespace TW
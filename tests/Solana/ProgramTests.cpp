@@ -67,3 +67,55 @@ TEST(SolanaTokenProgram, createProgramAddress) {
         EXPECT_EQ(address.string(), "GUs5qLUfsEHkcMB9T38vjr18ypEhRuNWiePW2LoK4E3K");
     }
 }
+
+TEST(SolanaTokenProgram, defaultTokenAddresses) {
+    const Address serumToken = Address("SRMuApVNdxXokk5GT7XD5cUUgXMBCoAz2LHeuAoKWRt");
+    const auto addresses = TokenProgram::defaultTokenAddresses({
+        Address("HBYC51YrGFAZ8rM7Sj8e9uqKggpSrDYrinQDZzvMtqQp"),
+        Address("B1iGmDJdvmxyUiYM8UEo2Uw2D58EmUrw4KyLYMmrhf8V"),
+        Address("Eg5jqooyG6ySaXKbQUu4Lpvu2SqUPZrNkM4zXs9iUDLJ"),
+    }, serumToken);
+    ASSERT_EQ(addresses.size(), 3);
+    EXPECT_EQ(addresses[0].string(), "6X4X1Ae24mkoWeCEpktevySVG9jzeCufut5vtUW3wFrD");
+    EXPECT_EQ(addresses[1].string(), "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP");
+    EXPECT_EQ(addresses[2].string(), "ANVCrmRw7Ww7rTFfMbrjApSPXEEcZpBa6YEiBdf98pAf");
+    EXPECT_TRUE(TokenProgram::defaultTokenAddresses({}, serumToken).empty());
+}
+
+TEST(SolanaTokenProgram, findProgramAddressOtherProgram) {
+    // https://github.com/solana-labs/solana/blob/f25c969ad87e64e6d1fd07d2d37096ac71cf8d06/sdk/program/src/pubkey.rs#L353-L435
+    const auto programId = Address("BPFLoader1111111111111111111111111111111111");
+    const auto address = TokenProgram::findProgramAddress({TW::data("Lil'"), TW::data("Bits")}, programId);
+    // the bump seed found gives back the same address
+    bool found = false;
+    for (int bump = 255; bump >= 0 && !found; --bump) {
+        found = TokenProgram::createProgramAddress({TW::data("Lil'"), TW::data("Bits"), {static_cast<TW::byte>(bump)}}, programId) == address;
+    }
+    EXPECT_TRUE(found);
+    EXPECT_FALSE(PublicKey(Data(address.bytes.begin(), address.bytes.end()), TWPublicKeyTypeED25519).isValidED25519());
+}
+
+TEST(SolanaTokenProgram, TokenAddressCache) {
+    const Address serumToken = Address("SRMuApVNdxXokk5GT7XD5cUUgXMBCoAz2LHeuAoKWRt");
+    const Address main1 = Address("HBYC51YrGFAZ8rM7Sj8e9uqKggpSrDYrinQDZzvMtqQp");
+    const Address main2 = Address("B1iGmDJdvmxyUiYM8UEo2Uw2D58EmUrw4KyLYMmrhf8V");
+    const Address main3 = Address("Eg5jqooyG6ySaXKbQUu4Lpvu2SqUPZrNkM4zXs9iUDLJ");
+
+    TokenAddressCache cache(2);
+    EXPECT_EQ(cache.defaultTokenAddress(main1, serumToken).string(), "6X4X1Ae24mkoWeCEpktevySVG9jzeCufut5vtUW3wFrD");
+    EXPECT_EQ(cache.defaultTokenAddress(main2, serumToken).string(), "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP");
+    EXPECT_EQ(cache.defaultTokenAddress(main1, serumToken).string(), "6X4X1Ae24mkoWeCEpktevySVG9jzeCufut5vtUW3wFrD");
+    EXPECT_EQ(cache.size(), 2);
+    // evicts main2, the least recently used
+    EXPECT_EQ(cache.defaultTokenAddress(main3, serumToken).string(), "ANVCrmRw7Ww7rTFfMbrjApSPXEEcZpBa6YEiBdf98pAf");
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.defaultTokenAddress(main2, serumToken).string(), "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP");
+    // different mint, different entry
+    EXPECT_NE(cache.defaultTokenAddress(main2, main1).string(), "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP");
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+
+    TokenAddressCache disabled(0);
+    EXPECT_EQ(disabled.defaultTokenAddress(main1, serumToken).string(), "6X4X1Ae24mkoWeCEpktevySVG9jzeCufut5vtUW3wFrD");
+    EXPECT_EQ(disabled.size(), 0);
+}
@@ -0,0 +1,131 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Solana/TransactionBuilder.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Solana;
+
+namespace {
+
+Address testAddress(uint8_t n) {
+    return Address(Data(32, n));
+}
+
+size_t signedSize(const Message& message) {
+    return 1 + message.header.numRequiredSignatures * Signature::size + Transaction(message).messageData().size();
+}
+
+} // namespace
+
+TEST(SolanaTransactionBuilder, SingleTransfer) {
+    auto from = Address("6eoo7i1khGhVm8tLBMAdq4ax2FxkKP4G7mCcfHyr3STN");
+    auto to = Address("56B334QvCDMSirsmtEJGfanZm8GqeQarrSjdAb2MbeNM");
+    Solana::Hash recentBlockhash("11111111111111111111111111111111");
+    TransactionBuilder builder(from, recentBlockhash);
+    builder.addTransfer(from, to, 42);
+    EXPECT_EQ(builder.transactionSize(), 1 + 64 + 150);
+    const auto messages = builder.build();
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(hex(Transaction(messages[0]).messageData()), hex(Transaction(from, to, 42, recentBlockhash).messageData()));
+    EXPECT_TRUE(builder.build().empty());
+}
+
+TEST(SolanaTransactionBuilder, TokenTransfer) {
+    auto signer = Address("B1iGmDJdvmxyUiYM8UEo2Uw2D58EmUrw4KyLYMmrhf8V");
+    auto token = Address("SRMuApVNdxXokk5GT7XD5cUUgXMBCoAz2LHeuAoKWRt");
+    auto senderTokenAddress = Address("EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP");
+    auto recipientTokenAddress = Address("3WUX9wASxyScbA7brDipioKfXS1XEYkQ4vo3Kej9bKei");
+    Solana::Hash recentBlockhash("CNaHfvqePgGYMvtYi9RuUdVxDYttr1zs4TWrTXYabxZi");
+    TransactionBuilder builder(signer, recentBlockhash);
+    builder.addTokenTransfer(signer, token, senderTokenAddress, recipientTokenAddress, 4000, 6);
+    auto messages = builder.build();
+    ASSERT_EQ(messages.size(), 1);
+
+    auto transaction = Transaction(messages[0]);
+    transaction.signatures.clear();
+    transaction.signatures.push_back(Signature("3vZ67CGoRYkuT76TtpP2VrtTPBfnvG2xj6mUTvvux46qbnpThgQDgm27nC3yQVUZrABFjT9Qo7vA74tCjtV5P9Xg"));
+    // same as TransferTokenTransaction in TransactionTests.cpp
+    EXPECT_EQ(transaction.serialize(),
+        "PGfKqEaH2zZXDMZLcU6LUKdBSzU1GJWJ1CJXtRYCxaCH7k8uok38WSadZfrZw3TGejiau7nSpan2GvbK26hQim24jRe2AupmcYJFrgsdaCt1Aqs5kpGjPqzgj9krgxTZwwob3xgC1NdHK5BcNwhxwRtrCphGEH7zUFpGFrFrHzgpf2KY8FvPiPELQyxzTBuyNtjLjMMreehSKShEjD9Xzp1QeC1pEF8JL6vUKzxMXuveoEYem8q8JiWszYzmTMfDk13JPgv7pXFGMqDV3yNGCLsWccBeSFKN4UKECre6x2QbUEiKGkHkMc4zQwwyD8tGmEMBAGm339qdANssEMNpDeJp2LxLDStSoWShHnotcrH7pUa94xCVvCPPaomF");
+}
+
+TEST(SolanaTransactionBuilder, SplitsBySize) {
+    const auto feePayer = testAddress(0xff);
+    TransactionBuilder builder(feePayer, Solana::Hash("11111111111111111111111111111111"));
+    for (int i = 0; i < 100; ++i) {
+        builder.addTransfer(feePayer, testAddress(static_cast<uint8_t>(i + 1)), 1000 + i);
+    }
+    const auto messages = builder.build();
+    ASSERT_EQ(messages.size(), 5);
+    size_t transfers = 0;
+    for (const auto& message: messages) {
+        EXPECT_LE(signedSize(message), TransactionBuilder::maxTransactionSize);
+        EXPECT_EQ(message.accountKeys[0], feePayer);
+        EXPECT_EQ(message.accountKeys.back(), Address(SYSTEM_PROGRAM_ID_ADDRESS));
+        EXPECT_EQ(message.header.numRequiredSignatures, 1);
+        EXPECT_EQ(message.header.numCreditOnlyUnsignedAccounts, 1);
+        transfers += message.instructions.size();
+    }
+    EXPECT_EQ(transfers, 100);
+    // full: one more transfer (32-byte key, 17-byte instruction) would not fit
+    EXPECT_GT(signedSize(messages[0]) + 32 + 17, TransactionBuilder::maxTransactionSize);
+    // recipients in order
+    EXPECT_EQ(messages[1].accountKeys[1], testAddress(static_cast<uint8_t>(messages[0].instructions.size() + 1)));
+}
+
+TEST(SolanaTransactionBuilder, AccountOrder) {
+    const auto feePayer = testAddress(1);
+    const auto program = testAddress(2);
+    const auto readOnlySigner = testAddress(3);
+    const auto promoted = testAddress(4);
+    const auto readOnly = testAddress(5);
+    const auto writable = testAddress(6);
+    TransactionBuilder builder(feePayer, Solana::Hash("11111111111111111111111111111111"));
+    builder.add(Instruction(program, {
+        AccountMeta(readOnly, false, true),
+        AccountMeta(promoted, false, true),
+        AccountMeta(readOnlySigner, true, true),
+    }, Data{1}));
+    builder.add(Instruction(program, {
+        AccountMeta(writable, false, false),
+        AccountMeta(promoted, false, false),
+        AccountMeta(readOnly, false, true),
+        AccountMeta(program, false, true),
+    }, Data{2}));
+    const auto messages = builder.build();
+    ASSERT_EQ(messages.size(), 1);
+    const auto& message = messages[0];
+    EXPECT_EQ(message.header.numRequiredSignatures, 2);
+    EXPECT_EQ(message.header.numCreditOnlySignedAccounts, 1);
+    EXPECT_EQ(message.header.numCreditOnlyUnsignedAccounts, 2);
+    ASSERT_EQ(message.accountKeys.size(), 6);
+    EXPECT_EQ(message.accountKeys[0], feePayer);
+    EXPECT_EQ(message.accountKeys[1], readOnlySigner);
+    EXPECT_EQ(message.accountKeys[2], promoted);
+    EXPECT_EQ(message.accountKeys[3], writable);
+    EXPECT_EQ(message.accountKeys[4], readOnly);
+    EXPECT_EQ(message.accountKeys[5], program);
+    ASSERT_EQ(message.compiledInstructions.size(), 2);
+    EXPECT_EQ(message.compiledInstructions[0].programIdIndex, 5);
+    EXPECT_EQ(hex(message.compiledInstructions[0].accounts), "040201");
+    EXPECT_EQ(hex(message.compiledInstructions[1].accounts), "03020405");
+}
+
+TEST(SolanaTransactionBuilder, InstructionTooLarge) {
+    const auto feePayer = testAddress(1);
+    TransactionBuilder builder(feePayer, Solana::Hash("11111111111111111111111111111111"));
+    builder.addTransfer(feePayer, testAddress(2), 1);
+    EXPECT_THROW(builder.add(Instruction(testAddress(3), {}, Data(1200))), std::invalid_argument);
+    // builder still usable, earlier instruction kept
+    builder.addTransfer(feePayer, testAddress(4), 1);
+    const auto messages = builder.build();
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0].instructions.size(), 2);
+}
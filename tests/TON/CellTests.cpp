@@ -9,6 +9,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 using namespace std;
 using namespace TW;
 using namespace TW::TON;
@@ -256,4 +258,146 @@ TEST(TONCell, CellStateInit2)
         EXPECT_EQ("b5ee9c7241010301007e00020134010200a2ff0020dd2082014c97ba9730ed44d0d70b1fe0a4f260810200d71820d70b1fed44d0d31fd3ffd15112baf2a122f901541044f910f2a2f80001d31f3120d74a96d307d402fb00ded1a4c8cb1fcbffc9ed5400480000000037f14c50f6435b11b9326e1218524f7f072d0a5ea8221cca71682e7d6ed6421381c553bd",
             hex(ser));
     }
-}
\ No newline at end of file
+}
+
+TEST(TONCell, SerializeDeduplicatesCells)
+{
+    auto c1 = std::make_shared<Cell>();
+    c1->setSliceBytesStr("123456");
+    auto c1copy = std::make_shared<Cell>();
+    c1copy->setSliceBytesStr("123456");
+
+    Cell shared;
+    shared.addCell(c1);
+    shared.addCell(c1);
+    Cell copied;
+    copied.addCell(c1);
+    copied.addCell(c1copy);
+    EXPECT_EQ(hex(shared.hash()), hex(copied.hash()));
+    EXPECT_EQ(1, shared.depth());
+
+    Data ser;
+    shared.serialize(ser, Cell::SerializationMode::WithCRC32C);
+    // 2 cells only, the root refers twice to cell 1
+    EXPECT_EQ("b5ee9c7241010201000900020001010006123456a3ca13cb", hex(ser));
+    EXPECT_EQ(ser.size(), shared.serializedSize(Cell::SerializationMode::WithCRC32C));
+    Data ser2;
+    copied.serialize(ser2, Cell::SerializationMode::WithCRC32C);
+    EXPECT_EQ(hex(ser), hex(ser2));
+}
+
+TEST(TONCell, SerializeDeepTree)
+{
+    // chain of cells with a shared leaf at the bottom, more than 255 bytes and cells
+    auto leaf = std::make_shared<Cell>();
+    leaf->setSliceBytesStr("abcd");
+    auto cell = std::make_shared<Cell>();
+    cell->setSliceBitsStr("30", 5);
+    cell->addCell(leaf);
+    for (int i = 0; i < 300; ++i) {
+        auto parent = std::make_shared<Cell>();
+        parent->setSliceBytes(TW::Data(1, static_cast<TW::byte>(i)));
+        parent->addCell(cell);
+        parent->addCell(leaf);
+        cell = parent;
+    }
+    EXPECT_EQ(301, cell->depth());
+
+    Data ser;
+    cell->serialize(ser, Cell::SerializationMode::WithCRC32C);
+    EXPECT_EQ(ser.size(), cell->serializedSize(Cell::SerializationMode::WithCRC32C));
+    // 302 cells: 2-byte references and offsets
+    EXPECT_EQ("b5ee9c724202", hex(Data(ser.begin(), ser.begin() + 6)));
+    EXPECT_EQ("012e", hex(Data(ser.begin() + 6, ser.begin() + 8)));
+
+    const auto parsed = Cell::deserialize(ser);
+    EXPECT_EQ(hex(cell->hash()), hex(parsed->hash()));
+    EXPECT_EQ(301, parsed->depth());
+    Data reser;
+    parsed->serialize(reser, Cell::SerializationMode::WithCRC32C);
+    EXPECT_EQ(hex(ser), hex(reser));
+}
+
+TEST(TONCell, ChildSealedAfterParentHash)
+{
+    auto child = std::make_shared<Cell>();
+    child->setSliceBytesStr("123456");
+    Cell c;
+    c.addCell(child);
+    // not hashed yet, the child can still change
+    child->setSliceBytesStr("FEDCBA");
+    EXPECT_EQ("53a96fa8e030c2c8be0f32cba5a929ca89b5650b699c3c305150a9b8d9669176", hex(child->hash()));
+    const auto hash = hex(c.hash());
+    EXPECT_THROW(child->setSliceBytesStr("123456"), std::logic_error);
+    EXPECT_THROW(child->addCell(std::make_shared<Cell>()), std::logic_error);
+    EXPECT_EQ(hash, hex(c.hash()));
+    // the parent itself is not sealed
+    c.setSliceBytesStr("123456");
+    EXPECT_EQ("45d4770b7e9816f062cb8e3f5c58e8ed16443b2387a1c6f59b777dfb005822fa", hex(c.hash()));
+    // neither is a copy of a sealed cell
+    Cell copy(*child);
+    EXPECT_NO_THROW(copy.setSliceBytesStr("123456"));
+}
+
+TEST(TONCell, ConcurrentHash)
+{
+    // a shared tree, hashed from several threads at once
+    auto leaf = std::make_shared<Cell>();
+    leaf->setSliceBytesStr("abcd");
+    auto cell = std::make_shared<Cell>();
+    cell->addCell(leaf);
+    for (int i = 0; i < 200; ++i) {
+        auto parent = std::make_shared<Cell>();
+        parent->setSliceBytes(TW::Data(1, static_cast<TW::byte>(i)));
+        parent->addCell(cell);
+        parent->addCell(leaf);
+        cell = parent;
+    }
+    const Cell reference(*cell);
+    std::vector<std::string> hashes(8);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < hashes.size(); ++t) {
+        threads.emplace_back([&, t] { hashes[t] = hex(cell->hash()); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& hash : hashes) {
+        EXPECT_EQ(hex(reference.hash()), hash);
+    }
+    EXPECT_EQ(201, cell->depth());
+}
+
+TEST(TONCell, Deserialize)
+{
+    const auto ser = parse_hex("b5ee9c72410103010073000201340102008cff0020dda4f260810200d71820d70b1fed44d0d7091fd709ffd15112baf2a122f901541044f910f2a2f80001d7091f3120d74a97d70907d402fb00ded1a4c8cb1fcbffc9ed54004800000000f61cf0bc8e891ad7636e0cd35229d579323aa2da827eb85d8071407464dc2fa3984101af");
+    const auto cell = Cell::deserialize(ser);
+    EXPECT_EQ(5, cell->getSlice().sizeBits());
+    EXPECT_EQ("34", cell->getSlice().asBytesStr());
+    ASSERT_EQ(2, cell->cellCount());
+    EXPECT_EQ(36, cell->getCells()[1]->getSlice().size());
+    EXPECT_EQ("60c04141c6a7b96d68615e7a91d265ad0f3a9a922e9ae9c901d4fa83f5d3c0d0", hex(cell->hash()));
+
+    // without CRC
+    const auto noCrc = parse_hex("b5ee9c7201010201000b000106123456010006fedcba");
+    EXPECT_EQ("45d4770b7e9816f062cb8e3f5c58e8ed16443b2387a1c6f59b777dfb005822fa", hex(Cell::deserialize(noCrc)->hash()));
+}
+
+TEST(TONCell, DeserializeError)
+{
+    const auto valid = parse_hex("b5ee9c7241010201000b000106123456010006fedcba7dc78a01");
+    EXPECT_NO_THROW(Cell::deserialize(valid));
+
+    auto badMagic = valid;
+    badMagic[0] = 0x68;
+    EXPECT_THROW(Cell::deserialize(badMagic), std::invalid_argument);
+    auto badCrc = valid;
+    badCrc[12] ^= 1;
+    EXPECT_THROW(Cell::deserialize(badCrc), std::invalid_argument);
+    EXPECT_THROW(Cell::deserialize(Data(valid.begin(), valid.end() - 1)), std::invalid_argument);
+    EXPECT_THROW(Cell::deserialize(Data(valid.begin(), valid.begin() + 8)), std::invalid_argument);
+    // backward reference
+    EXPECT_THROW(Cell::deserialize(parse_hex("b5ee9c7201010201000b000106123456000006fedcba")), std::invalid_argument);
+    // exotic cell
+    EXPECT_THROW(Cell::deserialize(parse_hex("b5ee9c7201010201000b000906123456010006fedcba")), std::invalid_argument);
+}
@@ -190,4 +190,33 @@ TEST(TezosTransaction, forgeUndelegate) {
     auto serialized = forgeOperation(delegateOperation);
 
     ASSERT_EQ(hex(serialized.begin(), serialized.end()), expected);
-}
\ No newline at end of file
+}
+
+TEST(TezosTransaction, operationForgerAppends) {
+    auto transactionOperationData = new TW::Tezos::Proto::TransactionOperationData();
+    transactionOperationData->set_amount(1);
+    transactionOperationData->set_destination("tz1Yju7jmmsaUiG9qQLoYv35v5pHgnWoLWbt");
+
+    auto transactionOperation = TW::Tezos::Proto::Operation();
+    transactionOperation.set_source("tz1XVJ8bZUXs7r5NV8dHvuiBhzECvLRLR3jW");
+    transactionOperation.set_fee(1272);
+    transactionOperation.set_counter(30738);
+    transactionOperation.set_gas_limit(10100);
+    transactionOperation.set_storage_limit(257);
+    transactionOperation.set_kind(TW::Tezos::Proto::Operation::TRANSACTION);
+    transactionOperation.set_allocated_transaction_operation_data(transactionOperationData);
+
+    const auto expected = "6c0081faa75f741ef614b0e35fcc8c90dfa3b0b95721f80992f001f44e81020100008fb5cea62d147c696afd9a93dbce962f4c8a9c9100";
+    OperationForger forger;
+    Data forged = parse_hex("aa");
+    forger.forge(transactionOperation, forged);
+    // second time from the public key hash cache
+    forger.forge(transactionOperation, forged);
+    EXPECT_EQ(hex(forged), std::string("aa") + expected + expected);
+    EXPECT_EQ(hex(forgeOperation(transactionOperation)), expected);
+
+    // invalid destination: throws, leaves the buffer unchanged
+    transactionOperation.mutable_transaction_operation_data()->set_destination("tz1Yju7jmmsaUiG9qQLoYv35v5pHgnWoLWbu");
+    EXPECT_THROW(forger.forge(transactionOperation, forged), std::invalid_argument);
+    EXPECT_EQ(hex(forged), std::string("aa") + expected + expected);
+}
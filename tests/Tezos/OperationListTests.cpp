@@ -179,3 +179,54 @@ TEST(TezosOperationList, ForgeOperationList_RevealWithoutPublicKey) {
 
     ASSERT_EQ(hex(forged.begin(), forged.end()), expected);
 }
+
+TEST(TezosOperationList, ForgeGroups) {
+    auto op_list = TW::Tezos::OperationList("BL8euoCWqNCny9AR3AKjnpi38haYMxjei1ZqNHuXMn19JSQnoWp");
+    auto key = parsePrivateKey("edsk4bMQMM6HYtMazF3m7mYhQ6KQ1WCEcBuRwh6DTtdnoqAvC3nPCc");
+    const std::vector<std::string> destinations = {
+        "tz1Yju7jmmsaUiG9qQLoYv35v5pHgnWoLWbt", "tz1gSM6yiwr85jEASZ1q3UekgHEoxYt7wg2M", "tz1RKLoYm4vtLzo7TAgGifMDAkiWhjfyXwP4"};
+    for (int i = 0; i < 100; ++i) {
+        auto transactionOperation = TW::Tezos::Proto::Operation();
+        transactionOperation.set_source("tz1XVJ8bZUXs7r5NV8dHvuiBhzECvLRLR3jW");
+        transactionOperation.set_fee(1272);
+        transactionOperation.set_counter(30738 + i);
+        transactionOperation.set_gas_limit(10100);
+        transactionOperation.set_storage_limit(257);
+        transactionOperation.set_kind(TW::Tezos::Proto::Operation::TRANSACTION);
+        transactionOperation.mutable_transaction_operation_data()->set_amount(1000 + i);
+        transactionOperation.mutable_transaction_operation_data()->set_destination(destinations[i % destinations.size()]);
+        op_list.addOperation(transactionOperation);
+    }
+    const auto branch = op_list.forgeBranch();
+    const auto all = op_list.forge(key);
+
+    // within default limits: a single group, same as forge
+    const auto single = op_list.forgeGroups(key);
+    ASSERT_EQ(single.size(), 1);
+    EXPECT_EQ(hex(single[0]), hex(all));
+
+    // gas limited: 30 operations per group
+    const auto byGas = op_list.forgeGroups(key, 30 * 10100);
+    ASSERT_EQ(byGas.size(), 4);
+    TW::Data joined = branch;
+    for (const auto& group : byGas) {
+        EXPECT_EQ(hex(TW::Data(group.begin(), group.begin() + branch.size())), hex(branch));
+        joined.insert(joined.end(), group.begin() + branch.size(), group.end());
+    }
+    EXPECT_EQ(hex(joined), hex(all));
+
+    // size limited
+    const size_t maxSize = 1000;
+    const auto bySize = op_list.forgeGroups(key, TW::Tezos::OperationList::hardGasLimitPerBlock, maxSize);
+    ASSERT_GT(bySize.size(), 1);
+    size_t total = 0;
+    for (const auto& group : bySize) {
+        EXPECT_LE(group.size() + 64, maxSize);
+        total += group.size() - branch.size();
+    }
+    EXPECT_EQ(total, all.size() - branch.size());
+
+    // a single operation over the limits
+    EXPECT_THROW(op_list.forgeGroups(key, 10000), std::invalid_argument);
+    EXPECT_THROW(op_list.forgeGroups(key, TW::Tezos::OperationList::hardGasLimitPerBlock, 100), std::invalid_argument);
+}
@@ -7,6 +7,7 @@
 #include "TWTestUtilities.h"
 
 #include "HexCoding.h"
+#include "proto/Common.pb.h"
 #include <TrustWalletCore/TWAnyAddress.h>
 #include <TrustWalletCore/TWCoinType.h>
 
@@ -24,6 +25,30 @@ TEST(AnyAddress, InvalidString) {
     ASSERT_EQ(TWAnyAddressCoin(ethAaddress.get()), TWCoinTypeEthereum);
 }
 
+TEST(AnyAddress, ValidateBatch) {
+    auto input = Common::Proto::AddressValidationInput();
+    const std::vector<std::pair<TWCoinType, const char*>> items = {
+        {TWCoinTypeEthereum, "0x4E5B2e1dc63F6b91cb6Cd759936495434C7e972F"},
+        {TWCoinTypeBitcoin, "0x4E5B2e1dc63F6b91cb6Cd759936495434C7e972F"},
+        {TWCoinTypeBinance, "bnb1hlly02l6ahjsgxw9wlcswnlwdhg4xhx38yxpd5"},
+        {TWCoinTypeCosmos, "bnb1hlly02l6ahjsgxw9wlcswnlwdhg4xhx38yxpd5"},
+        {TWCoinTypeBitcoin, "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4"},
+        {TWCoinTypeBitcoinCash, "bitcoincash:qzxf0wl63ahx6jsxu8uuldcw7n5aatwppvnteraqaw"},
+        {TWCoinTypeDogecoin, "DQkiL71KkuGEgS9QFCKJkBeHmzM5YFYGkG"},
+        {TWCoinTypeNEO, "AKmrAHRD9ZDUnu4m3vWWonpsojo4vgSuqp"},
+        {TWCoinTypeNEO, "AKmrAHRD9ZDUnu4m3vWWonpsojo4vgSuqq"},
+    };
+    for (const auto& item : items) {
+        auto proto = input.add_items();
+        proto->set_coin(item.first);
+        proto->set_address(item.second);
+    }
+    const auto inputData = input.SerializeAsString();
+    auto inputTWData = WRAPD(TWDataCreateWithBytes((const uint8_t*)inputData.data(), inputData.size()));
+    auto bitmap = WRAPD(TWAnyAddressValidateBatch(inputTWData.get()));
+    assertHexEqual(bitmap, "f500");
+}
+
 TEST(AnyAddress, Data) {
     // ethereum
     {
@@ -14,6 +14,7 @@
 #include <TrustWalletCore/TWPrivateKey.h>
 #include <TrustWalletCore/TWPublicKey.h>
 #include <TrustWalletCore/TWBase58.h>
+#include <proto/Common.pb.h>
 #include <proto/Stellar.pb.h>
 
 #include "HexCoding.h"
@@ -139,6 +140,44 @@ TEST(HDWallet, DeriveAddressEthereum) {
     assertStringsEqual(address, "0x27Ef5cDBe01777D62438AfFeb695e33fC2335979");
 }
 
+TEST(HDWallet, DeriveAddressesForCoins) {
+    auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(words.get(), passphrase.get()));
+    auto input = TW::Common::Proto::AddressDerivationInput();
+    input.add_coins(TWCoinTypeEthereum);
+    input.add_coins(TWCoinTypeBitcoin);
+    input.add_coins(TWCoinTypeSolana);
+    input.add_coins(TWCoinTypeCardano);
+    input.set_threads(2);
+    const auto inputData = input.SerializeAsString();
+    auto inputTWData = WRAPD(TWDataCreateWithBytes((const uint8_t*)inputData.data(), inputData.size()));
+    auto outputData = WRAPD(TWHDWalletGetAddressesForCoins(wallet.get(), inputTWData.get()));
+
+    auto output = TW::Common::Proto::AddressDerivationOutput();
+    output.ParseFromArray(TWDataBytes(outputData.get()), static_cast<int>(TWDataSize(outputData.get())));
+    ASSERT_EQ(output.addresses_size(), 4);
+    EXPECT_EQ(output.addresses(0), "0x27Ef5cDBe01777D62438AfFeb695e33fC2335979");
+    for (int i = 0; i < input.coins_size(); ++i) {
+        auto address = WRAPS(TWHDWalletGetAddressForCoin(wallet.get(), static_cast<TWCoinType>(input.coins(i))));
+        EXPECT_EQ(output.addresses(i), TWStringUTF8Bytes(address.get()));
+    }
+}
+
+TEST(HDWallet, DeriveAddressesForUnknownCoin) {
+    auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(words.get(), passphrase.get()));
+    auto input = TW::Common::Proto::AddressDerivationInput();
+    input.add_coins(123456789);
+    input.add_coins(TWCoinTypeEthereum);
+    const auto inputData = input.SerializeAsString();
+    auto inputTWData = WRAPD(TWDataCreateWithBytes((const uint8_t*)inputData.data(), inputData.size()));
+    auto outputData = WRAPD(TWHDWalletGetAddressesForCoins(wallet.get(), inputTWData.get()));
+
+    auto output = TW::Common::Proto::AddressDerivationOutput();
+    output.ParseFromArray(TWDataBytes(outputData.get()), static_cast<int>(TWDataSize(outputData.get())));
+    ASSERT_EQ(output.addresses_size(), 2);
+    EXPECT_EQ(output.addresses(0), "");
+    EXPECT_EQ(output.addresses(1), "0x27Ef5cDBe01777D62438AfFeb695e33fC2335979");
+}
+
 TEST(HDWallet, DeriveCosmos) {
     // use `gaiacli keys add key_name` to generate mnemonic words and private key
     auto words = STRING("attract term foster morning tail foam excite copper disease measure cheese camera rug enroll cause flip sword waste try local purchase between idea thank");
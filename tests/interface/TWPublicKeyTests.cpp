@@ -9,6 +9,8 @@
 #include "PublicKey.h"
 #include "PrivateKey.h"
 #include "HexCoding.h"
+#include "Hash.h"
+#include "proto/Common.pb.h"
 
 #include <TrustWalletCore/TWHash.h>
 #include <TrustWalletCore/TWPrivateKey.h>
@@ -115,3 +117,25 @@ TEST(TWPublicKeyTests, RecoverInvalid) {
     const auto publicKey = WRAP(TWPublicKey, TWPublicKeyRecover(deadbeef.get(), deadbeef.get()));
     EXPECT_EQ(publicKey.get(), nullptr);
 }
+
+TEST(TWPublicKeyTests, RecoverAddresses) {
+    auto input = Common::Proto::RecoveryInput();
+    auto* item = input.add_items();
+    const auto signature = parse_hex("00000000000000000000000000000000000000000000000000000000000000020123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef80");
+    const auto message = parse_hex("de4e9524586d6fce45667f9ff12f661e79870c4105fa0fb58af976619bb11432");
+    item->set_signature(signature.data(), signature.size());
+    item->set_digest(message.data(), message.size());
+    input.add_items()->set_signature("deadbeef");
+    input.set_threads(0xffffffff);
+    const auto serialized = input.SerializeAsString();
+    const auto inputData = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size()));
+
+    const auto outputData = WRAPD(TWPublicKeyRecoverAddresses(inputData.get()));
+    auto output = Common::Proto::RecoveryOutput();
+    ASSERT_TRUE(output.ParseFromArray(TWDataBytes(outputData.get()), static_cast<int>(TWDataSize(outputData.get()))));
+    ASSERT_EQ(output.addresses_size(), 2);
+    const auto publicKey = parse_hex("56d8089137b1fd0d890f8c7d4a04d0fd4520a30b19518ee87bd168ea12ed8090329274c4c6c0d9df04515776f2741eeffc30235d596065d718c3973e19711ad0");
+    const auto hash = Hash::keccak256(publicKey);
+    EXPECT_EQ(hex(output.addresses(0)), hex(Data(hash.end() - 20, hash.end())));
+    EXPECT_TRUE(output.addresses(1).empty());
+}
@@ -29,6 +29,11 @@
 #include "bignum.h"
 #include "hmac_drbg.h"
 
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
 // rfc6979 pseudo random number generator state
 typedef HMAC_DRBG_CTX rfc6979_state;
 
@@ -37,4 +42,8 @@ void init_rfc6979(const uint8_t *priv_key, const uint8_t *hash,
 void generate_rfc6979(uint8_t rnd[32], rfc6979_state *rng);
 void generate_k_rfc6979(bignum256 *k, rfc6979_state *rng);
 
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
 #endif
@@ -25,7 +25,7 @@ using namespace std;
 Keys::Keys(ostream& out, const Coins& coins) : _out(out), _coins(coins) {
     // init a random mnemonic
     HDWallet newwall(128, "");
-    _currentMnemonic = newwall.mnemonic;
+    _currentMnemonic.assign(newwall.mnemonic.begin(), newwall.mnemonic.end());
 }
 
 void privateKeyToResult(const PrivateKey& priKey, string& res_out) {
@@ -109,7 +109,7 @@ bool Keys::newMnemonic(const string& param1, string& res) {
         return false;
     }
     // store
-    _currentMnemonic = newwall.mnemonic;
+    _currentMnemonic.assign(newwall.mnemonic.begin(), newwall.mnemonic.end());
     res = _currentMnemonic;
     _out << "New mnemonic set." << endl;
     return false;